@@ -21,7 +21,7 @@ exit 0
 
 # All './configure' options except '-p' (pedantic).
 
-all="--default --extreme -m32 --ultimate -c -g -l -s --coverage --profile --compact --no-options --quiet --metrics --stats --no-proofs -fPIC --no-metrics --no-stats"
+all="--default --extreme -m32 --ultimate -c -g -l -s --coverage --profile --compact --no-options --quiet --metrics --stats --no-proofs --no-simd --split-assigned --huge --short-header --huge-pages --packed-clauses --threads --no-decompression --lrat -fPIC --no-metrics --no-stats"
 
 tmp=/tmp/m32-support-$$
 cat <<EOF > $tmp.c
@@ -223,11 +223,15 @@ redundant () {
     -g-l) return 0;;
     -g--metrics) return 0;;
     -g--stats) return 0;;
+    -m32--lrat) return 0;;
     -g-s) return 0;;
     --metrics--no-metrics) return 0;;
     --metrics--no-stats) return 0;;
     --metrics--stats) return 0;;
     --no-metrics--no-stats) return 0;;
+    --no-proofs--lrat) return 0;;
+    --packed-clauses--lrat) return 0;;
+    --short-header--lrat) return 0;;
     --stats--no-stats) return 0;;
     --ultimate--compact) return 0;;
     --ultimate-l) return 0;;
@@ -236,6 +240,7 @@ redundant () {
     --ultimate--no-metrics) return 0;;
     --ultimate--no-stats) return 0;;
     --ultimate--no-proofs) return 0;;
+    --ultimate--lrat) return 0;;
     -l--metrics) return 0;;
     -l--stats) return 0;;
     -l--quiet) return 0;;
@@ -1,3 +1,7 @@
+#ifdef HUGE_PAGES
+#define _GNU_SOURCE
+#endif
+
 #include "allocate.h"
 #include "error.h"
 #include "internal.h"
@@ -5,17 +9,26 @@
 
 #include <string.h>
 
+#ifdef HUGE_PAGES
+#include <sys/mman.h>
+#endif
+
 #ifdef LOGGING
 #include <inttypes.h>
 #endif
 
 static void
-inc_bytes (kissat * solver, size_t bytes)
+inc_bytes (kissat * solver, struct memory *memory, size_t bytes)
 {
-#ifndef NMETRICS
-
   if (!solver)
     return;
+  solver->allocated += bytes;
+#ifndef NMETRICS
+  if (!memory)
+    memory = &solver->memories.other;
+  memory->current += bytes;
+  if (memory->current > memory->peak)
+    memory->peak = memory->current;
   ADD (allocated_current, bytes);
   LOG5 ("allocated_current = %s",
 	FORMAT_BYTES (solver->statistics.allocated_current));
@@ -27,28 +40,32 @@ inc_bytes (kissat * solver, size_t bytes)
 	    FORMAT_BYTES (solver->statistics.allocated_max));
     }
 #else
-  (void) solver;
-  (void) bytes;
+  (void) memory;
 #endif
 }
 
 static void
-dec_bytes (kissat * solver, size_t bytes)
+dec_bytes (kissat * solver, struct memory *memory, size_t bytes)
 {
-#ifndef NMETRICS
   if (!solver)
     return;
+  assert (solver->allocated >= bytes);
+  solver->allocated -= bytes;
+#ifndef NMETRICS
+  if (!memory)
+    memory = &solver->memories.other;
+  assert (memory->current >= bytes);
+  memory->current -= bytes;
   SUB (allocated_current, bytes);
   LOG5 ("allocated_current = %s",
 	FORMAT_BYTES (solver->statistics.allocated_current));
 #else
-  (void) solver;
-  (void) bytes;
+  (void) memory;
 #endif
 }
 
 void *
-kissat_malloc (kissat * solver, size_t bytes)
+kissat_malloc_tagged (kissat * solver, struct memory *memory, size_t bytes)
 {
   void *res;
   if (!bytes)
@@ -57,10 +74,16 @@ kissat_malloc (kissat * solver, size_t bytes)
   LOG4 ("malloc (%zu) = %p", bytes, res);
   if (!res)
     kissat_fatal ("out-of-memory allocating %zu bytes", bytes);
-  inc_bytes (solver, bytes);
+  inc_bytes (solver, memory, bytes);
   return res;
 }
 
+void *
+kissat_malloc (kissat * solver, size_t bytes)
+{
+  return kissat_malloc_tagged (solver, 0, bytes);
+}
+
 char *
 kissat_strdup (kissat * solver, const char *str)
 {
@@ -69,7 +92,8 @@ kissat_strdup (kissat * solver, const char *str)
 }
 
 void *
-kissat_calloc (kissat * solver, size_t n, size_t size)
+kissat_calloc_tagged (kissat * solver, struct memory *memory,
+		      size_t n, size_t size)
 {
   void *res;
   if (!n || !size)
@@ -82,45 +106,66 @@ kissat_calloc (kissat * solver, size_t n, size_t size)
   if (!res)
     kissat_fatal ("out-of-memory allocating "
 		  "%zu = %zu x %zu bytes", bytes, n, size);
-  inc_bytes (solver, bytes);
+  inc_bytes (solver, memory, bytes);
   return res;
 }
 
+void *
+kissat_calloc (kissat * solver, size_t n, size_t size)
+{
+  return kissat_calloc_tagged (solver, 0, n, size);
+}
+
 void
-kissat_free (kissat * solver, void *ptr, size_t bytes)
+kissat_free_tagged (kissat * solver, struct memory *memory,
+		    void *ptr, size_t bytes)
 {
   if (ptr)
     {
       LOG4 ("free (%p[%zu])", ptr, bytes);
-      dec_bytes (solver, bytes);
+      dec_bytes (solver, memory, bytes);
       free (ptr);
     }
   else
     assert (!bytes);
 }
 
+void
+kissat_free (kissat * solver, void *ptr, size_t bytes)
+{
+  kissat_free_tagged (solver, 0, ptr, bytes);
+}
+
 void *
-kissat_realloc (kissat * solver, void *p, size_t old_bytes, size_t new_bytes)
+kissat_realloc_tagged (kissat * solver, struct memory *memory,
+		       void *p, size_t old_bytes, size_t new_bytes)
 {
   if (old_bytes == new_bytes)
     return p;
   if (!new_bytes)
     {
-      kissat_free (solver, p, old_bytes);
+      kissat_free_tagged (solver, memory, p, old_bytes);
       return 0;
     }
-  dec_bytes (solver, old_bytes);
+  dec_bytes (solver, memory, old_bytes);
   void *res = realloc (p, new_bytes);
   LOG4 ("realloc (%p[%zu], %zu) = %p", p, old_bytes, new_bytes, res);
   if (new_bytes && !res)
     kissat_fatal ("out-of-memory reallocating from %zu to %zu bytes",
 		  old_bytes, new_bytes);
-  inc_bytes (solver, new_bytes);
+  inc_bytes (solver, memory, new_bytes);
   return res;
 }
 
 void *
-kissat_nrealloc (kissat * solver, void *p, size_t o, size_t n, size_t size)
+kissat_realloc (kissat * solver, void *p, size_t old_bytes, size_t new_bytes)
+{
+  return kissat_realloc_tagged (solver, 0, p, old_bytes, new_bytes);
+}
+
+void *
+kissat_nrealloc_tagged (kissat * solver, struct memory *memory,
+			void *p, size_t o, size_t n, size_t size)
 {
   if (!size)
     {
@@ -132,18 +177,31 @@ kissat_nrealloc (kissat * solver, void *p, size_t o, size_t n, size_t size)
   if (max < o || max < n)
     kissat_fatal ("invalid 'kissat_nrealloc (..., %zu, %zu, %zu)' call",
 		  o, n, size);
-  return kissat_realloc (solver, p, o * size, n * size);
+  return kissat_realloc_tagged (solver, memory, p, o * size, n * size);
+}
+
+void *
+kissat_nrealloc (kissat * solver, void *p, size_t o, size_t n, size_t size)
+{
+  return kissat_nrealloc_tagged (solver, 0, p, o, n, size);
 }
 
 void
-kissat_dealloc (kissat * solver, void *ptr, size_t n, size_t size)
+kissat_dealloc_tagged (kissat * solver, struct memory *memory,
+		       void *ptr, size_t n, size_t size)
 {
   if (!n || !size)
     return;
   if (MAX_SIZE_T / size < n)
     kissat_fatal ("invalid 'kissat_dealloc (..., %zu, %zu)' call", n, size);
   const size_t bytes = n * size;
-  kissat_free (solver, ptr, bytes);
+  kissat_free_tagged (solver, memory, ptr, bytes);
+}
+
+void
+kissat_dealloc (kissat * solver, void *ptr, size_t n, size_t size)
+{
+  kissat_dealloc_tagged (solver, 0, ptr, n, size);
 }
 
 void
@@ -152,3 +210,149 @@ kissat_delstr (kissat * solver, char *str)
   assert (str);
   kissat_free (solver, str, strlen (str) + 1);
 }
+
+#ifdef HUGE_PAGES
+
+// Blocks of at least 'HUGE_PAGE_SIZE' bytes are mapped directly, aligned
+// to huge pages and advised to be backed by transparent huge pages.
+// They are resized with 'mremap', which avoids copying.  Smaller blocks
+// use 'malloc' as before.  Whether a block is mapped only depends on its
+// size, and the accounting of allocated bytes covers both kinds.
+
+#define HUGE_PAGE_SIZE ((size_t) 1 << 21)
+
+static size_t
+huge_pages_length (size_t bytes)
+{
+  return (bytes + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+}
+
+static void *
+map_huge_pages (size_t bytes)
+{
+  const size_t length = huge_pages_length (bytes);
+  const size_t mapped = length + HUGE_PAGE_SIZE;
+  char *start = mmap (0, mapped, PROT_READ | PROT_WRITE,
+		      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (start == MAP_FAILED)
+    return 0;
+  char *res = (char *) huge_pages_length ((uintptr_t) start);
+  const size_t head = res - start;
+  if (head)
+    munmap (start, head);
+  const size_t tail = mapped - head - length;
+  if (tail)
+    munmap (res + length, tail);
+  madvise (res, length, MADV_HUGEPAGE);
+  return res;
+}
+
+static void *
+remap_huge_pages (void *p, size_t old_bytes, size_t new_bytes)
+{
+  const size_t old_length = huge_pages_length (old_bytes);
+  const size_t new_length = huge_pages_length (new_bytes);
+  if (old_length == new_length)
+    return p;
+  void *res = mremap (p, old_length, new_length, MREMAP_MAYMOVE);
+  if (res == MAP_FAILED)
+    return 0;
+  if (new_length > old_length)
+    madvise (res, new_length, MADV_HUGEPAGE);
+  return res;
+}
+
+static void
+unmap_huge_pages (void *p, size_t bytes)
+{
+  munmap (p, huge_pages_length (bytes));
+}
+
+#endif
+
+void *
+kissat_large_realloc (kissat * solver, struct memory *memory, void *p,
+		      size_t old_bytes, size_t new_bytes)
+{
+#ifdef HUGE_PAGES
+  const bool old_mapped = (old_bytes >= HUGE_PAGE_SIZE);
+  const bool new_mapped = (new_bytes >= HUGE_PAGE_SIZE);
+  if (!old_mapped && !new_mapped)
+    return kissat_realloc_tagged (solver, memory, p, old_bytes, new_bytes);
+  if (old_bytes == new_bytes)
+    return p;
+  if (!new_bytes)
+    {
+      kissat_large_free (solver, memory, p, old_bytes);
+      return 0;
+    }
+  dec_bytes (solver, memory, old_bytes);
+  void *res;
+  if (old_mapped && new_mapped)
+    res = remap_huge_pages (p, old_bytes, new_bytes);
+  else if (new_mapped)
+    {
+      res = map_huge_pages (new_bytes);
+      if (res && p)
+	{
+	  memcpy (res, p, old_bytes);
+	  free (p);
+	}
+    }
+  else
+    {
+      res = malloc (new_bytes);
+      if (res)
+	{
+	  memcpy (res, p, new_bytes);
+	  unmap_huge_pages (p, old_bytes);
+	}
+    }
+  LOG4 ("mapped realloc (%p[%zu], %zu) = %p",
+	p, old_bytes, new_bytes, res);
+  if (!res)
+    kissat_fatal ("out-of-memory reallocating from %zu to %zu bytes",
+		  old_bytes, new_bytes);
+  inc_bytes (solver, memory, new_bytes);
+  return res;
+#else
+  return kissat_realloc_tagged (solver, memory, p, old_bytes, new_bytes);
+#endif
+}
+
+void
+kissat_large_free (kissat * solver, struct memory *memory,
+		   void *p, size_t bytes)
+{
+#ifdef HUGE_PAGES
+  if (p && bytes >= HUGE_PAGE_SIZE)
+    {
+      LOG4 ("mapped free (%p[%zu])", p, bytes);
+      dec_bytes (solver, memory, bytes);
+      unmap_huge_pages (p, bytes);
+      return;
+    }
+#endif
+  kissat_free_tagged (solver, memory, p, bytes);
+}
+
+#if !defined(QUIET) && !defined(NMETRICS)
+
+#include "print.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+
+void
+kissat_print_memories (kissat * solver)
+{
+  memories *memories = &solver->memories;
+#define TAG(NAME) \
+  PRINT_STAT (#NAME, memories->NAME.current, \
+	      memories->NAME.peak, "", "peak bytes");
+  MEMORY_TAGS
+#undef TAG
+  fflush (stdout);
+}
+
+#endif
@@ -5,6 +5,54 @@
 
 struct kissat;
 
+#ifndef NMETRICS
+
+#include <stdint.h>
+
+// Allocated bytes are attributed to the memory given explicitly to the
+// '..._tagged' allocation functions, e.g., 'MEMORY (arena)', while all
+// other allocations are attributed to 'other'.  Allocation and
+// deallocation of the same memory has to use the same tag.
+
+#define MEMORY_TAGS \
+  TAG (arena) \
+  TAG (checker) \
+  TAG (extend) \
+  TAG (heaps) \
+  TAG (proof) \
+  TAG (watches) \
+  TAG (other)
+
+typedef struct memory memory;
+typedef struct memories memories;
+
+struct memory
+{
+  uint64_t current;
+  uint64_t peak;
+};
+
+struct memories
+{
+#define TAG(NAME) memory NAME;
+  MEMORY_TAGS
+#undef TAG
+};
+
+#define MEMORY(NAME) (&solver->memories.NAME)
+
+#ifndef QUIET
+void kissat_print_memories (struct kissat *);
+#endif
+
+#else
+
+struct memory;
+
+#define MEMORY(NAME) ((struct memory *) 0)
+
+#endif
+
 void *kissat_malloc (struct kissat *, size_t bytes);
 void kissat_free (struct kissat *, void *, size_t bytes);
 
@@ -14,6 +62,23 @@ void kissat_dealloc (struct kissat *, void *ptr, size_t n, size_t size);
 void *kissat_realloc (struct kissat *, void *, size_t old, size_t bytes);
 void *kissat_nrealloc (struct kissat *, void *, size_t o, size_t n, size_t);
 
+void *kissat_malloc_tagged (struct kissat *, struct memory *, size_t);
+void kissat_free_tagged (struct kissat *, struct memory *, void *, size_t);
+
+void *kissat_calloc_tagged (struct kissat *, struct memory *,
+			    size_t n, size_t size);
+void kissat_dealloc_tagged (struct kissat *, struct memory *,
+			    void *ptr, size_t n, size_t size);
+
+void *kissat_realloc_tagged (struct kissat *, struct memory *,
+			     void *, size_t old, size_t bytes);
+void *kissat_nrealloc_tagged (struct kissat *, struct memory *,
+			      void *, size_t o, size_t n, size_t);
+
+void *kissat_large_realloc (struct kissat *, struct memory *,
+			    void *, size_t o, size_t n);
+void kissat_large_free (struct kissat *, struct memory *, void *, size_t);
+
 char *kissat_strdup (struct kissat *, const char *);
 void kissat_delstr (struct kissat *, char *str);
 
@@ -22,4 +87,9 @@ do { \
   kissat_dealloc (solver, (P), (N), sizeof *(P)); \
 } while (0)
 
+#define DEALLOC_TAGGED(M,P,N) \
+do { \
+  kissat_dealloc_tagged (solver, (M), (P), (N), sizeof *(P)); \
+} while (0)
+
 #endif
@@ -5,6 +5,7 @@
 #include "inline.h"
 #include "learn.h"
 #include "minimize.h"
+#include "pack.h"
 
 #include <inttypes.h>
 
@@ -16,7 +17,7 @@ one_literal_on_conflict_level (kissat * solver,
                                unsigned *conflict_level_ptr)
 {
   assert (conflict);
-  assert (conflict->size > 1);
+  assert (CLAUSE_SIZE (conflict) > 1);
 
   unsigned conflict_level = INVALID_LEVEL;
   unsigned literals_on_conflict_level = 0;
@@ -24,8 +25,13 @@ one_literal_on_conflict_level (kissat * solver,
 
   assigned *all_assigned = solver->assigned;
 
-  unsigned *lits = conflict->lits;
-  const unsigned conflict_size = conflict->size;
+#ifdef PACKED_CLAUSES
+  unsigned *lits = conflict->packed ?
+    kissat_unpack_literals (solver, conflict) : BEGIN_LITS (conflict);
+#else
+  unsigned *lits = BEGIN_LITS (conflict);
+#endif
+  const unsigned conflict_size = CLAUSE_SIZE (conflict);
   const unsigned *end_of_lits = lits + conflict_size;
 
   for (const unsigned *p = lits; p != end_of_lits; p++)
@@ -58,6 +64,7 @@ one_literal_on_conflict_level (kissat * solver,
       solver->inconsistent = true;
       LOG ("learned empty clause from conflict at conflict level zero");
       CHECK_AND_ADD_EMPTY ();
+      CHAIN_CONFLICT_IN_PROOF (conflict);
       ADD_EMPTY_TO_PROOF ();
       return false;
     }
@@ -93,17 +100,23 @@ one_literal_on_conflict_level (kissat * solver,
             }
           if (highest_position == i)
             continue;
+          const bool rewatch = highest_position > 1 && conflict_size > 3;
           reference ref = INVALID_REF;
-          if (highest_position > 1)
+          if (rewatch)
             {
               ref = kissat_reference_clause (solver, conflict);
               kissat_unwatch_blocking (solver, lit, ref);
             }
           lits[highest_position] = lit;
           lits[i] = highest_literal;
-          if (highest_position > 1)
+          if (rewatch)
             kissat_watch_blocking (solver, lits[i], lits[!i], ref);
         }
+#ifdef PACKED_CLAUSES
+      if (conflict->packed)
+        kissat_pack_literals (conflict, PACKED_WIDTH (conflict),
+                              conflict_size, lits);
+#endif
     }
 
   if (literals_on_conflict_level > 1)
@@ -158,16 +171,16 @@ analyze_reason_side_literals (kissat * solver)
       const unsigned idx = IDX (lit);
       assigned *a = all_assigned + idx;
       assert (a->level > 0);
-      assert (a->reason != UNIT);
-      if (a->reason == DECISION)
+      assert (ASSIGNED_REASON (a) != UNIT);
+      if (ASSIGNED_REASON (a) == DECISION)
         continue;
       if (a->binary)
-        mark_literal_as_analyzed (solver, all_assigned, a->reason,
+        mark_literal_as_analyzed (solver, all_assigned, ASSIGNED_REASON (a),
                                   "reason side");
       else
         {
-          assert (a->reason < SIZE_STACK (solver->arena));
-          clause *c = (clause *) (arena + a->reason);
+          assert (ASSIGNED_REASON (a) < SIZE_STACK (solver->arena));
+          clause *c = (clause *) (arena + ASSIGNED_REASON (a));
           for (all_literals_in_clause (lit, c))
             if (IDX (lit) != idx)
               mark_literal_as_analyzed (solver, all_assigned, lit,
@@ -238,12 +251,14 @@ kissat_analyze (kissat * solver, clause * conflict)
     {
       LOGCLS (conflict, "analyzing conflict %" PRIu64, CONFLICTS);
       unsigned conflict_level;
+      clause *otfs;
       if (one_literal_on_conflict_level (solver, conflict, &conflict_level))
         res = 1;
       else if (!conflict_level)
         res = -1;
-      else if ((conflict = kissat_deduce_first_uip_clause (solver, conflict)))
+      else if ((otfs = kissat_deduce_first_uip_clause (solver, conflict)))
         {
+          conflict = otfs;
           reset_markings (solver);
           reset_analyze (solver);
           reset_levels (solver);
@@ -252,6 +267,7 @@ kissat_analyze (kissat * solver, clause * conflict)
       else
         {
           kissat_minimize_clause (solver);
+          CHAIN_LEARNED_IN_PROOF (conflict);
           if (!solver->probing)
             analyze_reason_side_literals (solver);
           reset_markings (solver);
@@ -25,14 +25,16 @@ kissat_find_and_gate (kissat * solver, unsigned lit, unsigned negative)
   const value *values = solver->values;
 
   clause *base = 0;
+  const watch *base_watch = 0;
   for (all_binary_large_watches (watch, *not_watches))
     {
       if (watch.type.binary)
 	continue;
-      const reference ref = watch.large.ref;
+      const reference ref = LARGE_WATCH_REF (watch);
       assert (ref < SIZE_STACK (solver->arena));
       clause *c = (clause *) (arena + ref);
       assert (!c->garbage);
+      base_watch = watch_PTR;
       base = c;
       for (all_literals_in_clause (other, c))
 	{
@@ -89,8 +91,7 @@ kissat_find_and_gate (kissat * solver, unsigned lit, unsigned negative)
       tmp.binary.lit = other;
       PUSH_STACK (solver->gates[negative], tmp);
     }
-  tmp = kissat_large_watch (kissat_reference_clause (solver, base));
-  PUSH_STACK (solver->gates[!negative], tmp);
+  PUSH_DENSE_WATCH (solver->gates[!negative], base_watch);
   solver->gate_eliminated = GATE_ELIMINATED (ands);
   return true;
 }
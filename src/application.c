@@ -1,8 +1,10 @@
 #include "application.h"
 #include "check.h"
+#include "checkpoint.h"
 #include "colors.h"
 #include "config.h"
 #include "error.h"
+#include "handle.h"
 #include "internal.h"
 #include "parse.h"
 #include "print.h"
@@ -20,21 +22,44 @@ struct application
 {
   kissat *solver;
   const char *input_path;
+  const char *convert_path;
+  const char *checkpoint_path;
+  const char *restore_path;
 #ifndef NPROOFS
   const char *proof_path;
   file proof_file;
   bool force;
   int binary;
+#ifdef LRAT
+  bool lrat;
+#endif
 #endif
   int time;
   int conflicts;
   int decisions;
+  int memory;
   strictness strict;
   bool partial;
   bool witness;
   int max_var;
 };
 
+#ifndef NOPTIONS
+
+// The library keeps all clauses of eliminated variables by default, since
+// these variables might be reused in later incremental calls.  The stand
+// alone solver only solves once and thus optimizes elimination instead.
+
+static int
+application_default (const opt * o)
+{
+  if (!strcmp (o->name, "incremental"))
+    return 0;
+  return o->value;
+}
+
+#endif
+
 static void
 init_app (application * application, kissat * solver)
 {
@@ -44,7 +69,16 @@ init_app (application * application, kissat * solver)
   application->time = 0;
   application->conflicts = -1;
   application->decisions = -1;
+  application->memory = 0;
   application->strict = NORMAL_PARSING;
+#ifndef NOPTIONS
+  for (all_options (o))
+    {
+      const int def = application_default (o);
+      if (def != o->value)
+        kissat_set_option (solver, o->name, def);
+    }
+#endif
 }
 
 static void
@@ -62,6 +96,8 @@ print_complete_dimacs_and_proof_usage (void)
 {
   printf ("\n");
   printf ("Furthermore '<dimacs>' is the input file in DIMACS format.\n");
+  printf ("It can also be in the binary CNF format written by\n");
+  printf ("'--convert', which is detected automatically.\n");
 #ifdef _POSIX_C_SOURCE
   printf ("The solver reads from '<stdin>' if '<dimacs>' is unspecified.\n");
   printf ("If the path has a '.bz2', '.gz', '.lzma', '7z' or '.xz' suffix\n");
@@ -177,8 +213,12 @@ print_complete_usage (void)
           "following less frequent options:\n");
   printf ("\n");
   printf ("  --banner             print solver information\n");
+  printf ("  --checkpoint=<file>  "
+          "save solver state to '<file>' if unknown\n");
   printf ("  --color              "
           "use colors (default if connected to terminal)\n");
+  printf ("  --convert=<file>     "
+          "write input as binary CNF to '<file>' and exit\n");
   printf ("  --no-color           "
           "no colors (default if not connected to terminal)\n");
 #ifndef NOPTIONS
@@ -188,11 +228,16 @@ print_complete_usage (void)
   printf ("  --force              same as '-f' (force writing proof)\n");
 #endif
   printf ("  --id                 print GIT identifier\n");
+#ifdef LRAT
+  printf ("  --lrat               write LRAT proof (no probing, elimination, autarky)\n");
+#endif
 #ifndef NOPTIONS
   printf ("  --range              print option range list\n");
 #endif
   printf ("  --relaxed            relaxed parsing"
           " (ignore DIMACS header)\n");
+  printf ("  --restore=<file>     "
+          "continue from checkpoint (instead of input)\n");
   printf ("  --strict             stricter parsing"
           " (no empty header lines)\n");
   printf ("  --version            print version and exit\n");
@@ -201,6 +246,13 @@ print_complete_usage (void)
   printf ("\n");
   printf ("  --conflicts=<limit>\n");
   printf ("  --decisions=<limit>\n");
+  printf ("  --memory-limit=<megabytes>\n");
+  printf ("\n");
+  printf ("With '--checkpoint' the state of the solver is saved if it\n");
+  printf ("stops without result, either due to a limit or because it\n");
+  printf ("received 'SIGTERM', and can be continued with '--restore'.\n");
+  printf ("Limits given while restoring are relative to the restored\n");
+  printf ("state.  Options given are used instead of the saved ones.\n");
   printf ("\n");
   printf
     ("Satisfying assignments have by default values for all variables\n");
@@ -510,12 +562,61 @@ parse_options (application * application, int argc, char **argv)
           else
             ERROR ("invalid argument in '%s' (try '-h')", arg);
         }
+      else if ((valstr = kissat_parse_option_name (arg, "memory-limit")))
+        {
+          int val;
+          if (kissat_parse_option_value (valstr, &val) && val > 0)
+            {
+              if (application->memory > 0)
+                ERROR ("multiple '--memory-limit=%d' and '%s'",
+                       application->memory, arg);
+              kissat_set_memory_limit (solver, val);
+              application->memory = val;
+            }
+          else
+            ERROR ("invalid argument in '%s' (try '-h')", arg);
+        }
+      else if ((valstr = kissat_parse_option_name (arg, "convert")))
+        {
+          if (application->convert_path)
+            ERROR ("multiple '--convert=%s' and '%s'",
+                   application->convert_path, arg);
+          if (!*valstr)
+            ERROR ("invalid argument in '%s' (try '-h')", arg);
+          if (!kissat_file_writable (valstr))
+            ERROR ("can not write binary CNF to '%s'", valstr);
+          application->convert_path = valstr;
+        }
+      else if ((valstr = kissat_parse_option_name (arg, "checkpoint")))
+        {
+          if (application->checkpoint_path)
+            ERROR ("multiple '--checkpoint=%s' and '%s'",
+                   application->checkpoint_path, arg);
+          if (!*valstr)
+            ERROR ("invalid argument in '%s' (try '-h')", arg);
+          if (!kissat_file_writable (valstr))
+            ERROR ("can not write checkpoint to '%s'", valstr);
+          application->checkpoint_path = valstr;
+        }
+      else if ((valstr = kissat_parse_option_name (arg, "restore")))
+        {
+          if (application->restore_path)
+            ERROR ("multiple '--restore=%s' and '%s'",
+                   application->restore_path, arg);
+          if (!kissat_file_readable (valstr))
+            ERROR ("can not read checkpoint '%s'", valstr);
+          application->restore_path = valstr;
+        }
       else if (!strcmp (arg, "--partial"))
         application->partial = true;
 #ifndef NPROOFS
       else if (LONG_FALSE_OPTION (arg, "binary"))
         application->binary = -1;
 #endif
+#ifdef LRAT
+      else if (!strcmp (arg, "--lrat"))
+        application->lrat = true;
+#endif
 #ifndef NOPTIONS
       else if (arg[0] == '-' && arg[1] == '-' &&
                kissat_has_configuration (arg + 2))
@@ -592,6 +693,23 @@ parse_options (application * application, int argc, char **argv)
           application->input_path = arg;
         }
     }
+  if (application->restore_path && application->input_path)
+    ERROR ("can not read '%s' while restoring '%s'",
+           application->input_path, application->restore_path);
+  if (application->restore_path && application->convert_path)
+    ERROR ("can not convert while restoring '%s'",
+           application->restore_path);
+#ifndef NPROOFS
+  if (application->convert_path && application->proof_path)
+    ERROR ("can not write proof '%s' while converting to '%s'",
+           application->proof_path, application->convert_path);
+#endif
+#ifdef LRAT
+  if (application->lrat && !application->proof_path)
+    ERROR ("option '--lrat' without proof file (try '-h')");
+  if (application->lrat && application->strict == RELAXED_PARSING)
+    ERROR ("can not combine '--lrat' and '%s'", strict_option);
+#endif
 #if !defined(QUIET) && !defined(NOPTIONS)
   if (kissat_get_option (solver, "quiet"))
     {
@@ -618,15 +736,29 @@ parse_input (application * application)
     kissat_read_already_open_file (&file, stdin, "<stdin>");
   else if (!kissat_open_to_read_file (&file, path))
     ERROR ("failed to open '%s' for reading", path);
+#ifdef THREADS
+  if (GET_OPTION (threads) > 1)
+    kissat_read_ahead (&file);
+#endif
+  const bool binary = kissat_binary_cnf_file (&file);
   kissat_section (solver, "parsing");
-  kissat_message (solver, "opened and reading %sDIMACS file:",
-                  file.compressed ? "compressed " : "");
+  kissat_message (solver, "opened and reading %s%s file:",
+                  file.compressed ? "compressed " : "",
+                  binary ? "binary CNF" : "DIMACS");
   kissat_message (solver, "");
   kissat_message (solver, "  %s", file.path);
   kissat_message (solver, "");
-  const char *error = kissat_parse_dimacs (solver, application->strict, &file,
-                                           &lineno, &application->max_var);
+  const char *error;
+  if (binary)
+    error = kissat_parse_binary (solver, application->strict, &file,
+                                 &lineno, &application->max_var);
+  else
+    error = kissat_parse_dimacs (solver, application->strict, &file,
+                                 &lineno, &application->max_var);
   kissat_close_file (&file);
+  if (error && binary)
+    ERROR ("%s: parse error at byte %" PRIu64 ": %s",
+           file.path, lineno, error);
   if (error)
     ERROR ("%s:%" PRIu64 ": parse error: %s", file.path, lineno, error);
 #ifndef QUIET
@@ -648,6 +780,123 @@ parse_input (application * application)
   return true;
 }
 
+static bool
+convert_input (application * application)
+{
+#ifndef QUIET
+  double entered = kissat_process_time ();
+#endif
+  kissat *solver = application->solver;
+  uint64_t lineno;
+  file input, output;
+  const char *path = application->input_path;
+  if (!path)
+    kissat_read_already_open_file (&input, stdin, "<stdin>");
+  else if (!kissat_open_to_read_file (&input, path))
+    ERROR ("failed to open '%s' for reading", path);
+#ifdef THREADS
+  if (GET_OPTION (threads) > 1)
+    kissat_read_ahead (&input);
+#endif
+  if (kissat_binary_cnf_file (&input))
+    {
+      kissat_close_file (&input);
+      ERROR ("input '%s' already in binary CNF format", input.path);
+    }
+  if (!kissat_open_to_write_file (&output, application->convert_path))
+    {
+      kissat_close_file (&input);
+      ERROR ("failed to open '%s' for writing", application->convert_path);
+    }
+  kissat_section (solver, "converting");
+  kissat_message (solver, "converting %sDIMACS file:",
+                  input.compressed ? "compressed " : "");
+  kissat_message (solver, "");
+  kissat_message (solver, "  %s", input.path);
+  kissat_message (solver, "");
+  kissat_message (solver, "to %sbinary CNF file:",
+                  output.compressed ? "compressed " : "");
+  kissat_message (solver, "");
+  kissat_message (solver, "  %s", output.path);
+  kissat_message (solver, "");
+  const char *error =
+    kissat_convert_dimacs (solver, application->strict, &input, &output,
+                           &lineno, &application->max_var);
+  kissat_close_file (&input);
+  kissat_close_file (&output);
+  if (error)
+    ERROR ("%s:%" PRIu64 ": parse error: %s", input.path, lineno, error);
+#ifndef QUIET
+  kissat_message (solver, "wrote %s after reading %s",
+                  FORMAT_BYTES (output.bytes), FORMAT_BYTES (input.bytes));
+  kissat_message (solver,
+                  "finished converting after %.2f seconds",
+                  kissat_process_time () - entered);
+#endif
+  return true;
+}
+
+static bool
+restore_input (application * application)
+{
+  kissat *solver = application->solver;
+  file file;
+  const char *path = application->restore_path;
+  if (!kissat_open_to_read_file (&file, path))
+    ERROR ("failed to open '%s' for reading", path);
+  kissat_section (solver, "restoring");
+  kissat_message (solver, "restoring %scheckpoint:",
+                  file.compressed ? "compressed " : "");
+  kissat_message (solver, "");
+  kissat_message (solver, "  %s", file.path);
+  kissat_message (solver, "");
+  const char *error = kissat_load_checkpoint (solver, &file, false);
+  kissat_close_file (&file);
+  if (error)
+    ERROR ("%s: %s", path, error);
+  if (application->conflicts >= 0)
+    kissat_set_conflict_limit (solver, application->conflicts);
+  if (application->decisions >= 0)
+    kissat_set_decision_limit (solver, application->decisions);
+  if (application->memory > 0)
+    kissat_set_memory_limit (solver, application->memory);
+  const size_t imported = SIZE_STACK (solver->import);
+  application->max_var = imported ? imported - 1 : 0;
+  kissat_message (solver, "restored %u variables after %" PRIu64
+                  " conflicts", solver->vars, CONFLICTS);
+  return true;
+}
+
+static kissat *checkpoint_solver;
+
+static void
+terminate_for_checkpoint (void)
+{
+  assert (checkpoint_solver);
+  kissat_terminate (checkpoint_solver);
+}
+
+static bool
+write_checkpoint (application * application)
+{
+  kissat *solver = application->solver;
+  file file;
+  const char *path = application->checkpoint_path;
+  if (!kissat_open_to_write_file (&file, path))
+    ERROR ("failed to open '%s' for writing", path);
+  const bool saved = kissat_save_checkpoint (solver, &file);
+  kissat_close_file (&file);
+  if (!saved)
+    ERROR ("failed to write checkpoint to '%s'", path);
+  kissat_section (solver, "checkpoint");
+  kissat_message (solver, "saved %scheckpoint of %s to:",
+                  file.compressed ? "compressed " : "",
+                  FORMAT_BYTES (file.bytes));
+  kissat_message (solver, "");
+  kissat_message (solver, "  %s", file.path);
+  return true;
+}
+
 #ifndef NPROOFS
 
 static bool
@@ -667,13 +916,19 @@ write_proof (application * application)
     ERROR ("failed to open and write proof to '%s'", path);
   else if (application->binary < 0)
     binary = false;
-  kissat_init_proof (application->solver, file, binary);
+#ifdef LRAT
+  const bool lrat = application->lrat;
+#else
+  const bool lrat = false;
+#endif
+  kissat_init_proof (application->solver, file, binary, lrat);
 #ifndef QUIET
   kissat *solver = application->solver;
   kissat_section (solver, "proving");
-  kissat_message (solver, "%swriting proof to %sDRAT file:",
+  kissat_message (solver, "%swriting proof to %s%s file:",
                   file->close ? "opened and " : "",
-                  file->compressed ? "compressed " : "");
+                  file->compressed ? "compressed " : "",
+                  lrat ? "LRAT" : "DRAT");
   kissat_message (solver, "");
   kissat_message (solver, "  %s", file->path);
 #endif
@@ -696,15 +951,15 @@ close_proof (application * application)
 
 #ifndef NOPTIONS
 static void
-print_option (kissat * solver, int value, const opt * o)
+print_option (kissat * solver, int value, int def, const opt * o)
 {
   char buffer[96];
   const bool b = (o->low == 0 && o->high == 1);
   const char *val_str = FORMAT_VALUE (b, value);
-  const char *def_str = FORMAT_VALUE (b, o->value);
+  const char *def_str = FORMAT_VALUE (b, def);
   sprintf (buffer, "%s=%s", o->name, val_str);
   kissat_message (solver, "--%-30s (%s default '%s')",
-                  buffer, (value == o->value ? "same as" : "different from"),
+                  buffer, (value == def ? "same as" : "different from"),
                   def_str);
 }
 #endif
@@ -720,12 +975,13 @@ print_options (kissat * solver)
   for (all_options (o))
     {
       const int value = *kissat_options_ref (&solver->options, o);
-      if (o->value != value || verbosity > 0)
+      const int def = application_default (o);
+      if (def != value || verbosity > 0)
         {
           if (!printed++)
             kissat_section (solver, "options");
 
-          print_option (solver, value, o);
+          print_option (solver, value, def, o);
         }
     }
 }
@@ -736,14 +992,15 @@ print_limits (application * application)
 {
   kissat *solver = application->solver;
   const int verbosity = kissat_verbosity (solver);
-  if (verbosity < 1 &&
-      application->conflicts < 0 && application->decisions < 0)
+  if (verbosity < 1 && application->conflicts < 0 &&
+      application->decisions < 0 && !application->memory)
     return;
 
   kissat_section (solver, "limits");
-  if (!application->time &&
-      application->conflicts < 0 && application->conflicts < 0)
-    kissat_message (solver, "no time, conflict nor decision limit set");
+  if (!application->time && application->conflicts < 0 &&
+      application->conflicts < 0 && !application->memory)
+    kissat_message (solver,
+                    "no time, conflict, decision nor memory limit set");
   else
     {
       if (application->time)
@@ -765,6 +1022,12 @@ print_limits (application * application)
                         application->decisions);
       else if (verbosity > 0)
         kissat_message (solver, "no decision limit");
+
+      if (application->memory)
+        kissat_message (solver,
+                        "memory limit set to %d MB", application->memory);
+      else if (verbosity > 0)
+        kissat_message (solver, "no memory limit");
     }
 }
 
@@ -785,11 +1048,14 @@ kissat_application (kissat * solver, int argc, char **argv)
   if (!GET_OPTION (quiet))
     kissat_banner ("c ", "KISSAT SAT Solver");
 #endif
+  if (application.convert_path)
+    return convert_input (&application) ? 0 : 1;
 #ifndef NPROOFS
   if (!write_proof (&application))
     return 1;
 #endif
-  if (!parse_input (&application))
+  if (application.restore_path ? !restore_input (&application) :
+      !parse_input (&application))
     {
 #ifndef NPROOFS
       close_proof (&application);
@@ -803,7 +1069,19 @@ kissat_application (kissat * solver, int argc, char **argv)
   print_limits (&application);
   kissat_section (solver, "solving");
 #endif
+  if (application.checkpoint_path)
+    {
+      checkpoint_solver = solver;
+      kissat_init_checkpoint_handler (terminate_for_checkpoint);
+    }
   int res = kissat_solve (solver);
+  if (application.checkpoint_path)
+    {
+      kissat_reset_checkpoint_handler ();
+      checkpoint_solver = 0;
+      if (!res && !write_checkpoint (&application))
+        res = 1;
+    }
   if (res)
     {
       kissat_section (solver, "result");
@@ -2,6 +2,7 @@
 #include "internal.h"
 #include "logging.h"
 #include "print.h"
+#include "reduce.h"
 
 static void
 report_resized (kissat * solver, const char *mode, arena before)
@@ -47,8 +48,9 @@ kissat_allocate_clause (kissat * solver, size_t size)
 			  "of 2^%d words %s exhausted",
 			  LD_MAX_ARENA,
 			  FORMAT_BYTES (MAX_ARENA * sizeof (word)));
-	  kissat_stack_enlarge (solver, (chars *) & solver->arena,
-				sizeof (word));
+	  kissat_large_stack_enlarge (solver, MEMORY (arena),
+				      (chars *) & solver->arena,
+				      sizeof (word));
 	  capacity = CAPACITY_STACK (solver->arena);
 	  available = capacity - res;
 	}
@@ -81,7 +83,7 @@ kissat_shrink_arena (kissat * solver)
 		kissat_percent (size, capacity),
 		FORMAT_COUNT (size), FORMAT_BYTES (size_bytes));
 #endif
-  if (size > capacity / 4)
+  if (size > capacity / 4 && !kissat_memory_pressure (solver))
     {
       kissat_phase (solver, "arena", GET (arena_resized),
 		    "not shrinking since more than 25%% filled");
@@ -89,10 +91,16 @@ kissat_shrink_arena (kissat * solver)
     }
   INC (arena_resized);
   INC (arena_shrunken);
-  SHRINK_STACK (solver->arena);
+  SHRINK_LARGE_STACK (MEMORY (arena), solver->arena);
   report_resized (solver, "shrunken", before);
 }
 
+void
+kissat_release_arena (kissat * solver)
+{
+  RELEASE_LARGE_STACK (MEMORY (arena), solver->arena);
+}
+
 #if !defined(NDEBUG) || defined(LOGGING)
 
 bool
@@ -105,7 +113,13 @@ kissat_clause_in_arena (const kissat * solver, const clause * c)
   const char *end = (char *) END_STACK (solver->arena);
   if (p < begin)
     return false;
-  const size_t bytes = kissat_bytes_of_clause (c->size);
+  size_t bytes;
+#ifdef PACKED_CLAUSES
+  if (c->packed)
+    bytes = kissat_bytes_of_packed_clause (c->size, PACKED_WIDTH (c));
+  else
+#endif
+    bytes = kissat_bytes_of_clause (CLAUSE_SIZE (c));
   if (end < p + bytes)
     return false;
   return true;
@@ -14,11 +14,28 @@ typedef STACK (word) arena;
 
 // *INDENT-ON*
 
+#ifndef QUIET
+
+// Search ticks per second between sparse garbage collections, used to
+// report the effect of reordering clauses in the arena.
+
+typedef struct reordered reordered;
+
+struct reordered
+{
+  double time;
+  double rate;
+  uint64_t ticks;
+};
+
+#endif
+
 struct clause;
 struct kissat;
 
 reference kissat_allocate_clause (struct kissat *, size_t size);
 void kissat_shrink_arena (struct kissat *);
+void kissat_release_arena (struct kissat *);
 
 #if !defined(NDEBUG) || defined(LOGGING)
 
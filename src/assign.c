@@ -10,7 +10,7 @@ kissat_assign (kissat * solver,
 	       value * values, assigned * assigned,
 #endif
 	       unsigned lit,
-	       bool binary, bool redundant, unsigned level, unsigned reason)
+	       bool binary, bool redundant, unsigned level, reference reason)
 {
   assert (binary || !redundant);
   const unsigned not_lit = NOT (lit);
@@ -35,14 +35,14 @@ kissat_assign (kissat * solver,
       a->level = level;
       a->binary = binary;
       a->redundant = redundant;
-      a->reason = reason;
+      ASSIGNED_REASON (a) = reason;
     }
   else
     {
       a->level = 0;
       a->binary = false;
       a->redundant = false;
-      a->reason = UNIT;
+      ASSIGNED_REASON (a) = UNIT;
     }
 
   if (!solver->probing)
@@ -59,10 +59,14 @@ kissat_assign (kissat * solver,
       kissat_mark_fixed_literal (solver, lit);
       assert (solver->unflushed < UINT_MAX);
       solver->unflushed++;
+#ifdef LRAT
+      if (solver->lrat && reason != UNIT)
+	kissat_add_propagated_unit_to_proof (solver, lit, binary, reason);
+#endif
     }
 
   watches *watches = &WATCHES (not_lit);
-  if (!watches->size)
+  if (watches->size)
     {
       watch *w = BEGIN_WATCHES (*watches);
       __builtin_prefetch (w, 0, 1);
@@ -1,9 +1,11 @@
 #ifndef _assign_h_INCLUDED
 #define _assign_h_INCLUDED
 
+#include "reference.h"
+
 #include <stdbool.h>
 
-#define DECISION UINT_MAX
+#define DECISION INVALID_REF
 #define UNIT (DECISION - 1)
 
 #define ANALYZED 1
@@ -18,15 +20,29 @@
 typedef struct assigned assigned;
 struct clause;
 
+// With 'SPLIT_ASSIGNED' reasons are kept in the separate 'reasons' array.
+// Then the assignment record accessed during conflict analysis only holds
+// the level and the analysis flags and shrinks from 8 to 4 bytes.
+
 struct assigned
 {
   unsigned level:LD_MAX_LEVEL;
   unsigned analyzed:2;
   bool redundant:1;
   bool binary:1;
-  unsigned reason;
+#ifndef SPLIT_ASSIGNED
+  reference reason;
+#endif
 };
 
+#ifdef SPLIT_ASSIGNED
+#define ASSIGNED_REASON(A) \
+  (solver->reasons[(A) - solver->assigned])
+#else
+#define ASSIGNED_REASON(A) \
+  ((A)->reason)
+#endif
+
 #define ASSIGNED(LIT) \
   (assert (VALID_INTERNAL_LITERAL (LIT)), \
    solver->assigned + IDX (LIT))
@@ -35,7 +51,7 @@ struct assigned
   (ASSIGNED(LIT)->level)
 
 #define REASON(LIT) \
-  (ASSIGNED(LIT)->reason)
+  ASSIGNED_REASON (ASSIGNED(LIT))
 
 #ifndef INLINE_ASSIGN
 
@@ -0,0 +1,161 @@
+#include "assume.h"
+#include "decide.h"
+#include "inline.h"
+
+// Assumptions are decided before any other decision, in the order they
+// were given, on the first decision levels.  The stack 'assuming' maps
+// each of those levels to the index of the assumption decided on it.
+// Thus after backtracking below an assumption level we know exactly from
+// which assumption to continue.  Variables of assumptions are frozen
+// during the search, i.e., not eliminated, substituted nor taken into an
+// autarky, such that their external and internal literals stay in sync.
+
+static unsigned
+internal_assumption (kissat * solver, int elit)
+{
+  const unsigned eidx = ABS (elit);
+  assert (eidx < SIZE_STACK (solver->import));
+  const import *import = &PEEK_STACK (solver->import, eidx);
+  assert (import->imported);
+  assert (!import->eliminated);
+  unsigned ilit = import->lit;
+  if (elit < 0)
+    ilit = NOT (ilit);
+  return ilit;
+}
+
+void
+kissat_freeze_assumptions (kissat * solver)
+{
+  CLEAR_STACK (solver->assuming);
+  CLEAR_STACK (solver->failed);
+  solver->assumed = 0;
+  if (solver->inconsistent)
+    return;
+  assert (!solver->level);
+  for (all_stack (int, elit, solver->assumptions))
+    {
+      const unsigned ilit = internal_assumption (solver, elit);
+      flags *flags = FLAGS (IDX (ilit));
+      if (!flags->active && !flags->fixed)
+	kissat_activate_literal (solver, ilit);
+      LOG ("freezing assumption %s", LOGLIT (ilit));
+      flags->assumed = true;
+    }
+}
+
+void
+kissat_reset_assumptions (kissat * solver)
+{
+  for (all_stack (int, elit, solver->assumptions))
+    {
+      const unsigned ilit = internal_assumption (solver, elit);
+      FLAGS (IDX (ilit))->assumed = false;
+    }
+  CLEAR_STACK (solver->assumptions);
+  CLEAR_STACK (solver->assuming);
+  solver->assumed = 0;
+}
+
+bool
+kissat_assuming (kissat * solver)
+{
+  unsigneds *assuming = &solver->assuming;
+  const unsigned level = solver->level;
+  if (SIZE_STACK (*assuming) > level)
+    {
+      solver->assumed = PEEK_STACK (*assuming, level);
+      RESIZE_STACK (*assuming, level);
+      LOG ("continuing with assumption %u", solver->assumed);
+    }
+  return solver->assumed < SIZE_STACK (solver->assumptions);
+}
+
+static void
+analyze_literal (kissat * solver, assigned * all_assigned, unsigned lit)
+{
+  assert (VALUE (lit) < 0);
+  const unsigned idx = IDX (lit);
+  assigned *a = all_assigned + idx;
+  if (!a->level || a->analyzed)
+    return;
+  a->analyzed = ANALYZED;
+  PUSH_STACK (solver->analyzed, idx);
+}
+
+// The failed assumptions are those decisions which imply the negation of
+// the falsified assumption, found by going backward over the trail and
+// marking the reasons of all analyzed literals.
+
+static void
+analyze_failed_assumption (kissat * solver, int elit, unsigned ilit)
+{
+  LOG ("failed assumption %s", LOGLIT (ilit));
+  assert (EMPTY_STACK (solver->analyzed));
+  PUSH_STACK (solver->failed, elit);
+  assigned *all_assigned = solver->assigned;
+  analyze_literal (solver, all_assigned, ilit);
+  const unsigned *t = END_STACK (solver->trail);
+  size_t unresolved = SIZE_STACK (solver->analyzed);
+  while (unresolved)
+    {
+      assert (BEGIN_STACK (solver->trail) < t);
+      const unsigned lit = *--t;
+      assigned *a = all_assigned + IDX (lit);
+      if (!a->analyzed)
+	continue;
+      unresolved--;
+      const size_t before = SIZE_STACK (solver->analyzed);
+      if (a->binary)
+	analyze_literal (solver, all_assigned, ASSIGNED_REASON (a));
+      else if (ASSIGNED_REASON (a) != DECISION)
+	{
+	  const reference ref = ASSIGNED_REASON (a);
+	  clause *reason = kissat_dereference_clause (solver, ref);
+	  for (all_literals_in_clause (other, reason))
+	    if (other != lit)
+	      analyze_literal (solver, all_assigned, other);
+	}
+      else
+	{
+	  const int failed = kissat_export_literal (solver, lit);
+	  assert (failed);
+	  LOG ("failed assumption %s decision", LOGLIT (lit));
+	  if (failed != elit)
+	    PUSH_STACK (solver->failed, failed);
+	}
+      unresolved += SIZE_STACK (solver->analyzed) - before;
+    }
+  for (all_stack (unsigned, idx, solver->analyzed))
+    all_assigned[idx].analyzed = 0;
+  CLEAR_STACK (solver->analyzed);
+  LOG ("found %zu failed assumptions", SIZE_STACK (solver->failed));
+}
+
+int
+kissat_decide_assumption (kissat * solver)
+{
+  while (kissat_assuming (solver))
+    {
+      const int elit = PEEK_STACK (solver->assumptions, solver->assumed);
+      const unsigned ilit = internal_assumption (solver, elit);
+      const value value = VALUE (ilit);
+      if (value < 0)
+	{
+	  analyze_failed_assumption (solver, elit, ilit);
+	  return 20;
+	}
+      solver->assumed++;
+      if (value > 0)
+	{
+	  LOG ("assumption %s already satisfied", LOGLIT (ilit));
+	  continue;
+	}
+      assert (SIZE_STACK (solver->assuming) == solver->level);
+      PUSH_STACK (solver->assuming, solver->assumed - 1);
+      kissat_internal_assume (solver, ilit);
+      INC (decisions);
+      break;
+    }
+  return 0;
+}
@@ -0,0 +1,14 @@
+#ifndef _assume_h_INCLUDED
+#define _assume_h_INCLUDED
+
+#include <stdbool.h>
+
+struct kissat;
+
+void kissat_freeze_assumptions (struct kissat *);
+void kissat_reset_assumptions (struct kissat *);
+
+bool kissat_assuming (struct kissat *);
+int kissat_decide_assumption (struct kissat *);
+
+#endif
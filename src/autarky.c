@@ -102,7 +102,8 @@ propagate_unassigned (kissat * solver, word * arena,
 	}
       else
 	{
-	  const reference ref = watch.large.ref;
+	  const reference ref = kissat_large_watch_reference (p - 1);
+	  p += LARGE_WATCH_SIZE - 1;
 	  clause *c = (clause *) (arena + ref);
 	  assert (kissat_clause_in_arena (solver, c));
 	  unassigned += propagate_clause (solver, values, autarky, work, c);
@@ -137,6 +138,8 @@ determine_autarky (kissat * solver, value * autarky, unsigneds * work)
     {
       if (!ACTIVE (idx))
 	continue;
+      if (FLAGS (idx)->assumed)
+	continue;
       value value = phases[idx].saved;
       if (!value)
 	value = INITIAL_PHASE;
@@ -160,7 +163,7 @@ determine_autarky (kissat * solver, value * autarky, unsigneds * work)
 	continue;
       if (c->redundant)
 	continue;
-      if (TERMINATED (0))
+      if (INTERRUPTED (0))
 	return UINT_MAX;
       unsigned unassigned = propagate_clause (solver, values, autarky, 0, c);
       if (!unassigned)
@@ -190,7 +193,7 @@ determine_autarky (kissat * solver, value * autarky, unsigneds * work)
       value lit_value = autarky[lit];
       if (lit_value > 0)
 	continue;
-      if (TERMINATED (1))
+      if (INTERRUPTED (1))
 	return UINT_MAX;
       watches *watches = &WATCHES (lit);
       for (all_binary_large_watches (watch, *watches))
@@ -245,7 +248,7 @@ determine_autarky (kissat * solver, value * autarky, unsigneds * work)
 	continue;
       if (c->redundant)
 	continue;
-      if (TERMINATED (2))
+      if (INTERRUPTED (2))
 	return UINT_MAX;
       unsigned unassigned =
 	propagate_clause (solver, values, autarky, work, c);
@@ -306,6 +309,7 @@ flush_large_connected_and_autarky_binaries (kissat * solver)
 	  const watch watch = *p++;
 	  if (!watch.type.binary)
 	    {
+	      p += LARGE_WATCH_SIZE - 1;
 	      flushed_large++;
 	      continue;
 	    }
@@ -362,7 +366,8 @@ autarky_literal (kissat * solver, unsigned lit)
 	    }
 	  else
 	    {
-	      const reference ref = watch.large.ref;
+	      const reference ref = kissat_large_watch_reference (p - 1);
+	      p += LARGE_WATCH_SIZE - 1;
 	      clause *c = (clause *) (arena + ref);
 	      assert (kissat_clause_in_arena (solver, c));
 	      assert (!c->redundant);
@@ -406,7 +411,7 @@ kissat_autarky (kissat * solver)
 {
   if (solver->inconsistent)
     return;
-  if (TERMINATED (3))
+  if (INTERRUPTED (3))
     return;
   if (!solver->enabled.autarky)
     return;
@@ -60,7 +60,7 @@ backward_subsume_lits (kissat * solver, reference ignore,
 
   while (p != end_watches)
     {
-      terminated = TERMINATED (4);
+      terminated = INTERRUPTED (4);
       if (terminated)
 	break;
       const watch watch = *q++ = *p++;
@@ -97,7 +97,10 @@ backward_subsume_lits (kissat * solver, reference ignore,
 	}
       else
 	{
-	  const reference ref = watch.large.ref;
+	  const reference ref = kissat_large_watch_reference (p - 1);
+#ifdef HUGE
+	  *q++ = *p++;
+#endif
 	  if (ref == ignore)
 	    {
 	      assert (size > 2);
@@ -108,9 +111,9 @@ backward_subsume_lits (kissat * solver, reference ignore,
 	  struct clause *c = (struct clause *) (arena + ref);
 	  if (c->garbage)
 	    continue;
-	  if (c->size < size)
+	  if (CLAUSE_SIZE (c) < size)
 	    continue;
-	  if (c->size > clslim)
+	  if (CLAUSE_SIZE (c) > clslim)
 	    continue;
 	  INC (subsumption_checks);
 	  if (!marked)
@@ -123,7 +126,7 @@ backward_subsume_lits (kissat * solver, reference ignore,
 		}
 	      marked = true;
 	    }
-	  unsigned limit = c->size - size;
+	  unsigned limit = CLAUSE_SIZE (c) - size;
 	  unsigned needed = size;
 	  unsigned remove = INVALID_LIT;
 	  for (all_literals_in_clause (lit, c))
@@ -167,7 +170,7 @@ backward_subsume_lits (kissat * solver, reference ignore,
 	    }
 	  if (c->garbage)
 	    {
-	      q--;
+	      q -= LARGE_WATCH_SIZE;
 	      continue;
 	    }
 	  if (needed)
@@ -179,7 +182,7 @@ backward_subsume_lits (kissat * solver, reference ignore,
 	      INC (backward_subsumed);
 	      kissat_mark_clause_as_garbage (solver, c);
 	      kissat_update_after_removing_clause (solver, c, INVALID_LIT);
-	      q--;
+	      q -= LARGE_WATCH_SIZE;
 	      continue;
 	    }
 	  bool satisfied = false;
@@ -205,10 +208,10 @@ backward_subsume_lits (kissat * solver, reference ignore,
 	    {
 	      kissat_mark_clause_as_garbage (solver, c);
 	      kissat_update_after_removing_clause (solver, c, INVALID_LIT);
-	      q--;
+	      q -= LARGE_WATCH_SIZE;
 	      continue;
 	    }
-	  assert (old_size <= c->size);
+	  assert (old_size <= CLAUSE_SIZE (c));
 
 	  INC (strengthened);
 	  INC (backward_strengthened);
@@ -228,9 +231,9 @@ backward_subsume_lits (kissat * solver, reference ignore,
 	  CHECK_SHRINK_CLAUSE (c, remove, INVALID_LIT);
 	  if (old_size > 3)
 	    {
-	      unsigned *lits = c->lits;
+	      unsigned *lits = BEGIN_LITS (c);
 	      unsigned new_size = 0;
-	      for (unsigned i = 0; i < c->size; i++)
+	      for (unsigned i = 0; i < CLAUSE_SIZE (c); i++)
 		{
 		  unsigned lit = lits[i];
 		  if (remove == lit)
@@ -247,10 +250,9 @@ backward_subsume_lits (kissat * solver, reference ignore,
 	      if (!c->shrunken)
 		{
 		  c->shrunken = true;
-		  lits[c->size - 1] = INVALID_LIT;
+		  lits[CLAUSE_SIZE (c) - 1] = INVALID_LIT;
 		}
-	      c->size = new_size;
-	      c->searched = 2;
+	      kissat_shrink_clause_size (c, new_size);
 	      LOGCLS (c, "backward strengthened");
 	      kissat_disconnect_reference (solver, remove, ref);
 	    }
@@ -267,7 +269,7 @@ backward_subsume_lits (kissat * solver, reference ignore,
 	      const size_t bytes = kissat_actual_bytes_of_clause (c);
 	      ADD (arena_garbage, bytes);
 	      c->garbage = true;
-	      q--;
+	      q -= LARGE_WATCH_SIZE;
 	    }
 	  kissat_mark_removed_literal (solver, remove);
 	  kissat_update_after_removing_variable (solver, IDX (remove));
@@ -10,6 +10,11 @@
 #include <stdio.h>
 #include <limits.h>
 
+// All memory allocated here is attributed to the 'checker' memory tag.
+
+#define PUSH_CHECKER_STACK(S,E) PUSH_TAGGED_STACK (MEMORY (checker), S, E)
+#define RELEASE_CHECKER_STACK(S) RELEASE_TAGGED_STACK (MEMORY (checker), S)
+
 void
 kissat_check_satisfying_assignment (kissat * solver)
 {
@@ -155,7 +160,8 @@ void
 kissat_init_checker (kissat * solver)
 {
   LOG ("initializing internal proof checker");
-  checker *checker = kissat_calloc (solver, 1, sizeof (struct checker));
+  checker *checker =
+    kissat_calloc_tagged (solver, MEMORY (checker), 1, sizeof *checker);
   solver->checker = checker;
   init_nonces (solver, checker);
 }
@@ -168,10 +174,12 @@ release_hash (kissat * solver, checker * checker)
       for (line * line = checker->table[h], *next; line; line = next)
 	{
 	  next = line->next;
-	  kissat_free (solver, line, bytes_line (line->size));
+	  kissat_free_tagged (solver, MEMORY (checker),
+			      line, bytes_line (line->size));
 	}
     }
-  kissat_dealloc (solver, checker->table, checker->hashed, sizeof (line *));
+  kissat_dealloc_tagged (solver, MEMORY (checker),
+			 checker->table, checker->hashed, sizeof (line *));
 }
 
 static void
@@ -179,9 +187,9 @@ release_watches (kissat * solver, checker * checker)
 {
   const unsigned lits = 2 * checker->vars;
   for (unsigned i = 0; i < lits; i++)
-    RELEASE_STACK (checker->watches[i]);
-  kissat_dealloc (solver, checker->watches, 2 * checker->size,
-		  sizeof (lines));
+    RELEASE_CHECKER_STACK (checker->watches[i]);
+  kissat_dealloc_tagged (solver, MEMORY (checker),
+			 checker->watches, 2 * checker->size, sizeof (lines));
 }
 
 void
@@ -190,12 +198,15 @@ kissat_release_checker (kissat * solver)
   LOG ("releasing internal proof checker");
   checker *checker = solver->checker;
   release_hash (solver, checker);
-  RELEASE_STACK (checker->imported);
-  RELEASE_STACK (checker->trail);
-  kissat_free (solver, checker->marks, 2 * checker->size * sizeof (bool));
-  kissat_free (solver, checker->values, 2 * checker->size);
+  RELEASE_CHECKER_STACK (checker->imported);
+  RELEASE_CHECKER_STACK (checker->trail);
+  kissat_free_tagged (solver, MEMORY (checker),
+		      checker->marks, 2 * checker->size * sizeof (bool));
+  kissat_free_tagged (solver, MEMORY (checker),
+		      checker->values, 2 * checker->size);
   release_watches (solver, checker);
-  kissat_free (solver, checker, sizeof (struct checker));
+  kissat_free_tagged (solver, MEMORY (checker),
+		      checker, sizeof (struct checker));
 }
 
 #ifndef QUIET
@@ -253,7 +264,8 @@ resize_hash (kissat * solver, checker * checker)
   const unsigned old_hashed = checker->hashed;
   assert (old_hashed < MAX_SIZE);
   const unsigned new_hashed = old_hashed ? 2 * old_hashed : 1;
-  line **table = kissat_calloc (solver, new_hashed, sizeof (line *));
+  line **table = kissat_calloc_tagged (solver, MEMORY (checker),
+				       new_hashed, sizeof (line *));
   line **old_table = checker->table;
   for (unsigned i = 0; i < old_hashed; i++)
     {
@@ -265,7 +277,8 @@ resize_hash (kissat * solver, checker * checker)
 	  table[reduced] = line;
 	}
     }
-  kissat_dealloc (solver, checker->table, old_hashed, sizeof (line *));
+  kissat_dealloc_tagged (solver, MEMORY (checker),
+			 checker->table, old_hashed, sizeof (line *));
   checker->hashed = new_hashed;
   checker->table = table;
 }
@@ -273,7 +286,8 @@ resize_hash (kissat * solver, checker * checker)
 static line *
 new_line (kissat * solver, checker * checker, unsigned size, unsigned hash)
 {
-  line *res = kissat_malloc (solver, bytes_line (size));
+  line *res =
+    kissat_malloc_tagged (solver, MEMORY (checker), bytes_line (size));
   res->next = 0;
   res->size = size;
   res->hash = hash;
@@ -308,7 +322,7 @@ checker_assign (kissat * solver, checker * checker, unsigned lit, line * line)
   assert (!values[not_lit]);
   values[lit] = 1;
   values[not_lit] = -1;
-  PUSH_STACK (checker->trail, lit);
+  PUSH_CHECKER_STACK (checker->trail, lit);
 }
 
 static lines *
@@ -324,7 +338,7 @@ watch_checker_literal (kissat * solver, checker * checker, line * line,
 {
   LOGLINE3 ("checker watches %u in", lit);
   lines *lines = checker_watches (checker, lit);
-  PUSH_STACK (*lines, line);
+  PUSH_CHECKER_STACK (*lines, line);
 }
 
 static void
@@ -549,14 +563,15 @@ resize_checker (kissat * solver, checker * checker, unsigned new_vars)
       const unsigned size2 = 2 * size;
       const unsigned new_size2 = 2 * new_size;
       checker->marks =
-	kissat_realloc (solver, checker->marks, size2,
-			new_size2 * sizeof (bool));
+	kissat_realloc_tagged (solver, MEMORY (checker), checker->marks,
+			       size2, new_size2 * sizeof (bool));
       checker->values =
-	kissat_realloc (solver, checker->values, size2, new_size2);
+	kissat_realloc_tagged (solver, MEMORY (checker), checker->values,
+			       size2, new_size2);
       checker->watches =
-	kissat_realloc (solver, checker->watches,
-			size2 * sizeof *checker->watches,
-			new_size2 * sizeof *checker->watches);
+	kissat_realloc_tagged (solver, MEMORY (checker), checker->watches,
+			       size2 * sizeof *checker->watches,
+			       new_size2 * sizeof *checker->watches);
       checker->size = new_size;
     }
   const unsigned delta = new_vars - vars;
@@ -637,7 +652,7 @@ remove_line (kissat * solver, checker * checker, size_t size)
     }
   unwatch_line (solver, checker, line);
   LOGLINE3 ("removed checker");
-  kissat_free (solver, line, bytes_line (size));
+  kissat_free_tagged (solver, MEMORY (checker), line, bytes_line (size));
   assert (checker->lines > 0);
   checker->lines--;
   checker->removed++;
@@ -654,7 +669,7 @@ import_external_literals (kissat * solver, checker * checker,
     {
       const unsigned lit =
 	import_external_checker (solver, checker, elits[i]);
-      PUSH_STACK (checker->imported, lit);
+      PUSH_CHECKER_STACK (checker->imported, lit);
     }
   LOGIMPORTED3 ("checker imported external");
 }
@@ -669,7 +684,7 @@ import_internal_literals (kissat * solver, checker * checker,
     {
       const unsigned ilit = ilits[i];
       const unsigned lit = import_internal_checker (solver, checker, ilit);
-      PUSH_STACK (checker->imported, lit);
+      PUSH_CHECKER_STACK (checker->imported, lit);
     }
   LOGIMPORTED3 ("checker imported internal");
 }
@@ -678,7 +693,12 @@ import_internal_literals (kissat * solver, checker * checker,
 static void
 import_clause (kissat * solver, checker * checker, clause * c)
 {
-  import_internal_literals (solver, checker, c->size, c->lits);
+  CLEAR_STACK (checker->imported);
+  for (all_literals_in_clause (ilit, c))
+    {
+      const unsigned lit = import_internal_checker (solver, checker, ilit);
+      PUSH_CHECKER_STACK (checker->imported, lit);
+    }
   LOGIMPORTED3 ("checker imported clause");
 }
 
@@ -688,8 +708,8 @@ import_binary (kissat * solver, checker * checker, unsigned a, unsigned b)
   CLEAR_STACK (checker->imported);
   const unsigned c = import_internal_checker (solver, checker, a);
   const unsigned d = import_internal_checker (solver, checker, b);
-  PUSH_STACK (checker->imported, c);
-  PUSH_STACK (checker->imported, d);
+  PUSH_CHECKER_STACK (checker->imported, c);
+  PUSH_CHECKER_STACK (checker->imported, d);
   LOGIMPORTED3 ("checker imported binary");
 }
 
@@ -698,7 +718,7 @@ import_internal_unit (kissat * solver, checker * checker, unsigned a)
 {
   CLEAR_STACK (checker->imported);
   const unsigned b = import_internal_checker (solver, checker, a);
-  PUSH_STACK (checker->imported, b);
+  PUSH_CHECKER_STACK (checker->imported, b);
   LOGIMPORTED3 ("checker imported unit");
 }
 
@@ -969,7 +989,7 @@ kissat_check_shrink_clause (kissat * solver, clause * c,
       if (ilit != keep && values[ilit] < 0 && !LEVEL (ilit))
 	continue;
       const unsigned lit = import_internal_checker (solver, checker, ilit);
-      PUSH_STACK (checker->imported, lit);
+      PUSH_CHECKER_STACK (checker->imported, lit);
     }
   LOGIMPORTED3 ("checker imported internal");
   check_line (solver, checker);
@@ -1004,9 +1024,9 @@ kissat_checker_contains_clause (kissat * solver, clause * clause)
   checker *checker = solver->checker;
   import_clause (solver, checker, clause);
   size_t size = SIZE_STACK (checker->imported);
-  if (line_redundant (solver, checker, size))
-    return true;
-  return find_line (solver, checker, size, false);
+  bool res = line_redundant (solver, checker, size) ||
+    find_line (solver, checker, size, false);
+  return res;
 }
 
 void
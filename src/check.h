@@ -22,6 +22,7 @@ void kissat_print_checker_statistics (struct kissat *, bool verbose);
 #endif
 
 void kissat_add_unchecked_external (struct kissat *, size_t, int *);
+void kissat_add_unchecked_internal (struct kissat *, size_t, unsigned *);
 
 void kissat_check_and_add_binary (struct kissat *, unsigned, unsigned);
 void kissat_check_and_add_clause (struct kissat *, struct clause *c);
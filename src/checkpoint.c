@@ -0,0 +1,497 @@
+#include "allocate.h"
+#include "backtrack.h"
+#include "checkpoint.h"
+#include "error.h"
+#include "file.h"
+#include "internal.h"
+#include "logging.h"
+#include "print.h"
+#include "require.h"
+#include "resize.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+// A checkpoint is a dump of the solver state at decision level zero.  The
+// same 'transfer' functions are used for saving and loading, which keeps
+// the order in which fields are written and read in sync.  Pointers are
+// never written.  Stacks and arrays are written as size followed by their
+// content and are reallocated while loading.  As the layout of the
+// dumped structures depends on compiler and configuration, checkpoints
+// can only be loaded by the same build which wrote them, which is checked
+// through the header.  Temporary stacks (empty at level zero), memory
+// accounting, profiling times, the proof and the checker are not saved.
+
+#define MAGIC "kissat checkpoint"
+
+typedef struct checkpoint checkpoint;
+
+struct checkpoint
+{
+  kissat *solver;
+  file *file;
+  bool loading;
+  const char *error;
+};
+
+static void
+transfer_bytes (checkpoint * checkpoint, void *ptr, size_t bytes)
+{
+  if (checkpoint->error)
+    return;
+  size_t transferred;
+  if (checkpoint->loading)
+    transferred = kissat_read (checkpoint->file, ptr, bytes);
+  else
+    transferred = kissat_write (checkpoint->file, ptr, bytes);
+  if (transferred == bytes)
+    return;
+  if (checkpoint->loading)
+    checkpoint->error = "truncated checkpoint";
+  else
+    checkpoint->error = "write error";
+}
+
+#define TRANSFER(V) \
+  transfer_bytes (checkpoint, &(V), sizeof (V))
+
+#define TRANSFER_ARRAY(P,N) \
+  transfer_bytes (checkpoint, (P), (N) * sizeof *(P))
+
+static void
+transfer_string (checkpoint * checkpoint, const char *str)
+{
+  uint64_t len = strlen (str);
+  if (!checkpoint->loading)
+    {
+      TRANSFER (len);
+      transfer_bytes (checkpoint, (char *) str, len);
+      return;
+    }
+  uint64_t saved;
+  TRANSFER (saved);
+  if (checkpoint->error)
+    return;
+  char buffer[256];
+  if (saved == len && len < sizeof buffer)
+    {
+      transfer_bytes (checkpoint, buffer, len);
+      if (!checkpoint->error && !memcmp (buffer, str, len))
+	return;
+    }
+  if (!checkpoint->error)
+    checkpoint->error = "checkpoint written by different solver build";
+}
+
+static void
+transfer_size (checkpoint * checkpoint, size_t *size_ptr)
+{
+  uint64_t size = *size_ptr;
+  TRANSFER (size);
+  if (checkpoint->error)
+    return;
+  if (size > MAX_SIZE_T / 2)
+    checkpoint->error = "invalid size in checkpoint";
+  else
+    *size_ptr = size;
+}
+
+static void
+transfer_stack (checkpoint * checkpoint, struct memory *memory,
+		chars * stack, size_t bytes, bool large)
+{
+  size_t size = SIZE_STACK (*stack) / bytes;
+  transfer_size (checkpoint, &size);
+  if (checkpoint->error)
+    return;
+  if (checkpoint->loading)
+    {
+      kissat *solver = checkpoint->solver;
+      assert (EMPTY_STACK (*stack));
+      if (size > MAX_SIZE_T / 2 / bytes)
+	{
+	  checkpoint->error = "invalid stack size in checkpoint";
+	  return;
+	}
+      while (CAPACITY_STACK (*stack) < size * bytes)
+	if (large)
+	  kissat_large_stack_enlarge (solver, memory, stack, bytes);
+	else
+	  kissat_tagged_stack_enlarge (solver, memory, stack, bytes);
+      stack->end = stack->begin + size * bytes;
+    }
+  transfer_bytes (checkpoint, stack->begin, size * bytes);
+}
+
+#define TRANSFER_STACK(S) \
+  transfer_stack (checkpoint, 0, (chars *) &(S), sizeof *(S).begin, false)
+
+#define TRANSFER_TAGGED_STACK(M,S) \
+  transfer_stack (checkpoint, (M), \
+		  (chars *) &(S), sizeof *(S).begin, false)
+
+#define TRANSFER_LARGE_STACK(M,S) \
+  transfer_stack (checkpoint, (M), \
+		  (chars *) &(S), sizeof *(S).begin, true)
+
+static void
+transfer_header (checkpoint * checkpoint)
+{
+  transfer_string (checkpoint, MAGIC);
+  transfer_string (checkpoint, kissat_id ());
+  transfer_string (checkpoint, kissat_compiler ());
+  uint64_t bytes = sizeof (struct kissat);
+  TRANSFER (bytes);
+  if (!checkpoint->error && bytes != sizeof (struct kissat))
+    checkpoint->error = "checkpoint written by different solver build";
+}
+
+static void
+transfer_averages (checkpoint * checkpoint, averages * averages)
+{
+  TRANSFER (averages->initialized);
+  if (checkpoint->error)
+    return;
+  if (checkpoint->loading && averages->initialized)
+    {
+      averages->initialized = false;
+      kissat_init_averages (checkpoint->solver, averages);
+    }
+#define TRANSFER_SMOOTH(NAME) \
+do { \
+  smooth *smooth = &averages->NAME; \
+  TRANSFER (smooth->value); \
+  TRANSFER (smooth->alpha); \
+  TRANSFER (smooth->beta); \
+  TRANSFER (smooth->wait); \
+  TRANSFER (smooth->period); \
+} while (0)
+  TRANSFER_SMOOTH (level);
+  TRANSFER_SMOOTH (size);
+  TRANSFER_SMOOTH (fast_glue);
+  TRANSFER_SMOOTH (slow_glue);
+  TRANSFER_SMOOTH (trail);
+#undef TRANSFER_SMOOTH
+}
+
+static void
+transfer_heap (checkpoint * checkpoint, heap * heap)
+{
+  kissat *solver = checkpoint->solver;
+  TRANSFER (heap->tainted);
+  unsigned size = heap->size;
+  TRANSFER (size);
+  unsigned vars = heap->vars;
+  TRANSFER (vars);
+  if (checkpoint->error)
+    return;
+  if (checkpoint->loading)
+    {
+      if (vars > size || size > solver->size)
+	{
+	  checkpoint->error = "invalid heap in checkpoint";
+	  return;
+	}
+      kissat_resize_heap (solver, heap, size);
+      heap->vars = vars;
+    }
+  TRANSFER_ARRAY (heap->score, vars);
+  TRANSFER_ARRAY (heap->pos, vars);
+  TRANSFER_TAGGED_STACK (MEMORY (heaps), heap->stack);
+}
+
+static void
+transfer_clueue (checkpoint * checkpoint, clueue * clueue)
+{
+  unsigned size = clueue->size;
+  TRANSFER (size);
+  if (checkpoint->error)
+    return;
+  if (checkpoint->loading && size)
+    kissat_init_clueue (checkpoint->solver, clueue, size);
+  TRANSFER (clueue->next);
+  TRANSFER_ARRAY (clueue->elements, size);
+}
+
+static void
+transfer_variables (checkpoint * checkpoint)
+{
+  kissat *solver = checkpoint->solver;
+  unsigned vars = solver->vars;
+  TRANSFER (vars);
+  if (checkpoint->error)
+    return;
+  if (checkpoint->loading)
+    {
+      if (vars > INTERNAL_MAX_VAR + 1)
+	{
+	  checkpoint->error = "invalid number of variables in checkpoint";
+	  return;
+	}
+      kissat_increase_size (solver, vars);
+      solver->vars = vars;
+    }
+  TRANSFER (solver->active);
+  TRANSFER (solver->unassigned);
+
+  TRANSFER_ARRAY (solver->assigned, vars);
+#ifdef SPLIT_ASSIGNED
+  TRANSFER_ARRAY (solver->reasons, vars);
+#endif
+  TRANSFER_ARRAY (solver->flags, vars);
+  TRANSFER_ARRAY (solver->links, vars);
+  TRANSFER_ARRAY (solver->phases, vars);
+  TRANSFER_ARRAY (solver->values, 2 * (size_t) vars);
+  TRANSFER_ARRAY (solver->watches, 2 * (size_t) vars);
+
+  TRANSFER (solver->queue);
+  transfer_heap (checkpoint, &solver->scores);
+  TRANSFER (solver->scinc);
+  transfer_heap (checkpoint, &solver->schedule);
+}
+
+static void
+transfer_clauses (checkpoint * checkpoint)
+{
+  kissat *solver = checkpoint->solver;
+  TRANSFER_STACK (solver->export);
+  TRANSFER_STACK (solver->units);
+  TRANSFER_STACK (solver->import);
+  TRANSFER_TAGGED_STACK (MEMORY (extend), solver->extend);
+  TRANSFER_STACK (solver->witness);
+  TRANSFER_STACK (solver->revived);
+  TRANSFER_STACK (solver->eliminated);
+  TRANSFER_STACK (solver->etrail);
+
+  TRANSFER_STACK (solver->trail);
+  TRANSFER (solver->propagated);
+
+  TRANSFER_LARGE_STACK (MEMORY (arena), solver->arena);
+  transfer_clueue (checkpoint, &solver->clueue);
+  TRANSFER (solver->first_reducible);
+  TRANSFER (solver->last_irredundant);
+
+  vectors *vectors = &solver->vectors;
+  TRANSFER_LARGE_STACK (MEMORY (watches), vectors->stack);
+  TRANSFER_STACK (vectors->defrag);
+  TRANSFER (vectors->usable);
+  TRANSFER (vectors->defragged);
+  TRANSFER (vectors->limit);
+
+#if !defined(NDEBUG) || !defined(NPROOFS) || defined(LOGGING)
+  TRANSFER_STACK (solver->original);
+  TRANSFER (solver->offset_of_last_original_clause);
+#endif
+}
+
+static void
+transfer_search (checkpoint * checkpoint)
+{
+  kissat *solver = checkpoint->solver;
+
+  TRANSFER (solver->extended);
+  TRANSFER (solver->inconsistent);
+  TRANSFER (solver->irreversible);
+  TRANSFER (solver->iterating);
+  TRANSFER (solver->stable);
+
+  TRANSFER (solver->best_assigned);
+  TRANSFER (solver->consistently_assigned);
+  TRANSFER (solver->target_assigned);
+  TRANSFER (solver->unflushed);
+  TRANSFER (solver->transitive);
+
+  TRANSFER (solver->rephased);
+  TRANSFER (solver->random);
+  transfer_averages (checkpoint, &solver->averages[0]);
+  transfer_averages (checkpoint, &solver->averages[1]);
+  TRANSFER (solver->reluctant);
+
+  TRANSFER (solver->bounds);
+  TRANSFER (solver->delays);
+  TRANSFER (solver->enabled);
+  TRANSFER (solver->limited);
+  TRANSFER (solver->limits);
+  TRANSFER (solver->waiting);
+
+  TRANSFER (solver->mode);
+#ifndef QUIET
+  TRANSFER (solver->reordered);
+#endif
+  TRANSFER (solver->ticks);
+}
+
+static void
+transfer_statistics (checkpoint * checkpoint)
+{
+  kissat *solver = checkpoint->solver;
+#ifndef NMETRICS
+  const uint64_t allocated_current = solver->statistics.allocated_current;
+  const uint64_t allocated_max = solver->statistics.allocated_max;
+#endif
+  TRANSFER (solver->statistics);
+#ifndef NMETRICS
+  if (checkpoint->loading)
+    {
+      solver->statistics.allocated_current = allocated_current;
+      solver->statistics.allocated_max = allocated_max;
+    }
+#endif
+}
+
+static void
+transfer_options (checkpoint * checkpoint, bool options)
+{
+#ifndef NOPTIONS
+  kissat *solver = checkpoint->solver;
+  if (options)
+    TRANSFER (solver->options);
+  else
+    {
+      struct options ignored = solver->options;
+      TRANSFER (ignored);
+    }
+#else
+  (void) checkpoint;
+  (void) options;
+#endif
+}
+
+static void
+transfer_checkpoint (checkpoint * checkpoint, bool options)
+{
+  transfer_header (checkpoint);
+  transfer_options (checkpoint, options);
+  transfer_statistics (checkpoint);
+  transfer_variables (checkpoint);
+  transfer_clauses (checkpoint);
+  transfer_search (checkpoint);
+}
+
+bool
+kissat_save_checkpoint (kissat * solver, file * file)
+{
+  assert (solver->watching);
+  assert (EMPTY_STACK (solver->clause.lits));
+  if (!solver->inconsistent && solver->level)
+    kissat_backtrack_propagate_and_flush_trail (solver);
+  assert (!solver->level);
+  checkpoint checkpoint;
+  checkpoint.solver = solver;
+  checkpoint.file = file;
+  checkpoint.loading = false;
+  checkpoint.error = 0;
+  transfer_checkpoint (&checkpoint, true);
+  if (!checkpoint.error && fflush (file->file))
+    checkpoint.error = "write error";
+  if (checkpoint.error)
+    return false;
+  kissat_verbose (solver, "saved checkpoint of %s to '%s'",
+		  FORMAT_BYTES (file->bytes), file->path);
+  return true;
+}
+
+#ifndef NDEBUG
+
+// The checker only knows about clauses added through this solver instance
+// and thus the clauses of the checkpoint are added as unchecked clauses.
+
+static void
+add_clauses_to_checker (kissat * solver)
+{
+  assert (!solver->level);
+  for (all_variables (idx))
+    {
+      unsigned lit = LIT (idx);
+      const value value = solver->values[lit];
+      if (!value)
+	continue;
+      if (value < 0)
+	lit = NOT (lit);
+      kissat_add_unchecked_internal (solver, 1, &lit);
+    }
+  for (all_literals (lit))
+    {
+      watches *watches = &WATCHES (lit);
+      for (all_binary_blocking_watches (watch, *watches))
+	{
+	  if (!watch.type.binary)
+	    continue;
+	  const unsigned other = watch.binary.lit;
+	  if (lit > other)
+	    continue;
+	  unsigned lits[2] = { lit, other };
+	  kissat_add_unchecked_internal (solver, 2, lits);
+	}
+    }
+  unsigneds lits;
+  INIT_STACK (lits);
+  for (all_clauses (c))
+    {
+      if (c->garbage)
+	continue;
+      for (all_literals_in_clause (lit, c))
+	PUSH_STACK (lits, lit);
+      kissat_add_unchecked_internal (solver,
+				     SIZE_STACK (lits), BEGIN_STACK (lits));
+      CLEAR_STACK (lits);
+    }
+  RELEASE_STACK (lits);
+}
+
+#endif
+
+const char *
+kissat_load_checkpoint (kissat * solver, file * file, bool options)
+{
+  assert (!solver->vars);
+  assert (!solver->statistics.searches);
+  checkpoint checkpoint;
+  checkpoint.solver = solver;
+  checkpoint.file = file;
+  checkpoint.loading = true;
+  checkpoint.error = 0;
+  transfer_checkpoint (&checkpoint, options);
+  if (checkpoint.error)
+    return checkpoint.error;
+  if (GET (searches))
+    solver->resuming = true;
+#ifndef NDEBUG
+  if (GET_OPTION (check) > 1)
+    add_clauses_to_checker (solver);
+#endif
+  kissat_verbose (solver, "loaded checkpoint of %s from '%s'",
+		  FORMAT_BYTES (file->bytes), file->path);
+  kissat_verbose (solver, "restored %u variables after %" PRIu64
+		  " conflicts", solver->vars, CONFLICTS);
+  return 0;
+}
+
+int
+kissat_checkpoint (kissat * solver, const char *path)
+{
+  kissat_require_initialized (solver);
+  kissat_require (EMPTY_STACK (solver->clause.lits),
+		  "incomplete clause (terminating zero not added)");
+  file file;
+  if (!kissat_open_to_write_file (&file, path))
+    return 0;
+  const bool res = kissat_save_checkpoint (solver, &file);
+  kissat_close_file (&file);
+  return res;
+}
+
+kissat *
+kissat_restore (const char *path)
+{
+  file file;
+  if (!kissat_open_to_read_file (&file, path))
+    return 0;
+  kissat *solver = kissat_init ();
+  const char *error = kissat_load_checkpoint (solver, &file, true);
+  kissat_close_file (&file);
+  if (!error)
+    return solver;
+  kissat_release (solver);
+  return 0;
+}
@@ -0,0 +1,13 @@
+#ifndef _checkpoint_h_INCLUDED
+#define _checkpoint_h_INCLUDED
+
+#include <stdbool.h>
+
+struct file;
+struct kissat;
+
+bool kissat_save_checkpoint (struct kissat *, struct file *);
+const char *kissat_load_checkpoint (struct kissat *, struct file *,
+				    bool options);
+
+#endif
@@ -42,6 +42,9 @@ init_clause (kissat * solver, clause * res,
   res->garbage = false;
   res->hyper = false;
   res->keep = keep;
+#ifdef PACKED_CLAUSES
+  res->packed = false;
+#endif
   res->reason = false;
   res->redundant = redundant;
   res->shrunken = false;
@@ -49,9 +52,18 @@ init_clause (kissat * solver, clause * res,
   res->vivify = false;
 
   res->used = 0;
+#ifdef LRAT
+  res->id = 0;
+#endif
 
-  res->searched = 2;
-  res->size = size;
+#ifdef SHORT_HEADER
+  res->short_size = (size <= MAX_SHORT_SIZE) ? size : 0;
+#endif
+  if (!SHORT_CLAUSE (res))
+    {
+      res->searched = 2;
+      res->size = size;
+    }
 #ifdef NOPTIONS
   (void) solver;
 #endif
@@ -97,10 +109,10 @@ new_large_clause (kissat * solver,
   reference res = kissat_allocate_clause (solver, size);
   clause *c = kissat_unchecked_dereference_clause (solver, res);
   init_clause (solver, c, redundant, glue, size);
-  memcpy (c->lits, lits, size * sizeof (unsigned));
+  memcpy (BEGIN_LITS (c), lits, size * sizeof (unsigned));
   LOGREF (res, "new");
   if (solver->watching)
-    kissat_watch_reference (solver, lits[0], lits[1], res);
+    kissat_watch_clause (solver, c);
   else
     kissat_connect_clause (solver, c);
   if (redundant)
@@ -119,6 +131,10 @@ new_large_clause (kissat * solver,
       CHECK_AND_ADD_CLAUSE (c);
       ADD_CLAUSE_TO_PROOF (c);
     }
+#ifdef LRAT
+  else if (solver->lrat)
+    c->id = kissat_last_id_in_proof (solver);
+#endif
   return res;
 }
 
@@ -175,12 +191,12 @@ mark_clause_as_garbage (kissat * solver, clause * c)
   assert (!c->garbage);
   LOGCLS (c, "garbage");
   if (!c->redundant)
-    kissat_mark_removed_literals (solver, c->size, c->lits);
+    kissat_mark_removed_literals (solver, CLAUSE_SIZE (c), BEGIN_LITS (c));
   REMOVE_CHECKER_CLAUSE (c);
   DELETE_CLAUSE_FROM_PROOF (c);
   if (c->hyper)
     {
-      assert (c->size == 3);
+      assert (CLAUSE_SIZE (c) == 3);
       assert (c->redundant);
       DEC (hyper_ternaries);
     }
@@ -201,7 +217,7 @@ clause *
 kissat_delete_clause (kissat * solver, clause * c)
 {
   LOGCLS (c, "delete");
-  assert (c->size > 2);
+  assert (CLAUSE_SIZE (c) > 2);
   assert (c->garbage);
   size_t bytes = kissat_actual_bytes_of_clause (c);
   SUB (arena_garbage, bytes);
@@ -5,13 +5,37 @@
 #include "reference.h"
 #include "utilities.h"
 
+#include <assert.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 typedef struct clause clause;
 
-#define LD_MAX_GLUE 22
+#ifdef SHORT_HEADER
+#define LD_MAX_HEADER_GLUE 19
+#define LD_MAX_SHORT_SIZE 3
+#define MAX_SHORT_SIZE ((1u<<LD_MAX_SHORT_SIZE)-1)
+#else
+#define LD_MAX_HEADER_GLUE 22
+#endif
+
+#ifdef PACKED_CLAUSES
+#define LD_MAX_GLUE (LD_MAX_HEADER_GLUE - 1)
+#else
+#define LD_MAX_GLUE LD_MAX_HEADER_GLUE
+#endif
+
 #define MAX_GLUE ((1u<<LD_MAX_GLUE)-1)
 
+// With 'SHORT_HEADER' clauses with at most 'MAX_SHORT_SIZE' literals only
+// keep the first header word.  Their size is stored in 'short_size' and
+// their literals follow immediately without 'searched' and 'size'.  For
+// all other clauses 'short_size' is zero.
+
+// With 'LRAT' every clause carries the identifier under which it was
+// added to the proof (zero if no LRAT proof is traced).
+
 struct clause
 {
   unsigned glue:LD_MAX_GLUE;
@@ -19,6 +43,9 @@ struct clause
   bool garbage:1;
   bool hyper:1;
   bool keep:1;
+#ifdef PACKED_CLAUSES
+  bool packed:1;
+#endif
   bool reason:1;
   bool redundant:1;
   bool shrunken:1;
@@ -26,17 +53,118 @@ struct clause
   bool vivify:1;
 
   unsigned used:2;
+#ifdef SHORT_HEADER
+  unsigned short_size:LD_MAX_SHORT_SIZE;
+#endif
 
   unsigned searched;
   unsigned size;
+#ifdef LRAT
+  uint64_t id;
+#endif
 
   unsigned lits[3];
 };
 
 #define SIZE_OF_CLAUSE_HEADER ((size_t) &((clause*)0)->searched)
 
+#ifdef SHORT_HEADER
+
+#define SHORT_CLAUSE(C) ((C)->short_size)
+#define CLAUSE_SIZE(C) \
+  (SHORT_CLAUSE (C) ? (C)->short_size : (C)->size)
+#define BEGIN_LITS(C) \
+  (SHORT_CLAUSE (C) ? (unsigned *) (C) + 1 : (C)->lits)
+
+#else
+
+#define SHORT_CLAUSE(C) false
+#define CLAUSE_SIZE(C) ((C)->size)
 #define BEGIN_LITS(C) ((C)->lits)
-#define END_LITS(C) (BEGIN_LITS (C) + (C)->size)
+
+#endif
+
+#define END_LITS(C) (BEGIN_LITS (C) + CLAUSE_SIZE (C))
+
+#ifdef PACKED_CLAUSES
+
+// With 'PACKED_CLAUSES' cold redundant clauses might be 'packed'.  Only
+// the two watched literals 'lits[0]' and 'lits[1]' are kept as is, while
+// 'lits[2]' holds the bit-width of the remaining literals.  These follow
+// as fixed-width bit-fields in the words starting at 'lits[3]'.  A final
+// padding word allows to read each field from two consecutive words.
+// Packed clauses are neither short nor shrunken.  Only 'END_LITS' is
+// meaningless for them and literals have to be accessed through
+// 'kissat_clause_literal' or 'all_literals_in_clause'.
+
+#define PACKED_WIDTH(C) ((C)->lits[2])
+#define PACKED_DATA(C) ((C)->lits + 3)
+
+static inline size_t
+kissat_packed_words (unsigned size, unsigned width)
+{
+  assert (2 < size);
+  const uint64_t bits = (uint64_t) (size - 2) * width;
+  return (bits + 31) / 32 + 1;
+}
+
+static inline size_t
+kissat_bytes_of_packed_clause (unsigned size, unsigned width)
+{
+  const size_t words = kissat_packed_words (size, width);
+  const size_t res = sizeof (clause) + words * sizeof (unsigned);
+  return kissat_align_word (res);
+}
+
+static inline unsigned
+kissat_packed_literal (const clause * c, unsigned i)
+{
+  assert (c->packed);
+  assert (2 <= i);
+  assert (i < c->size);
+  const unsigned width = PACKED_WIDTH (c);
+  assert (0 < width && width < 32);
+  const uint64_t bit = (uint64_t) (i - 2) * width;
+  const unsigned *data = PACKED_DATA (c) + (bit >> 5);
+  const uint64_t word = data[0] | (uint64_t) data[1] << 32;
+  return (unsigned) (word >> (bit & 31)) & ((1u << width) - 1);
+}
+
+static inline void
+kissat_set_packed_literal (clause * c, unsigned i, unsigned lit)
+{
+  assert (c->packed);
+  assert (2 <= i);
+  assert (i < c->size);
+  const unsigned width = PACKED_WIDTH (c);
+  assert (0 < width && width < 32);
+  assert (!(lit >> width));
+  const uint64_t bit = (uint64_t) (i - 2) * width;
+  unsigned *data = PACKED_DATA (c) + (bit >> 5);
+  const unsigned shift = bit & 31;
+  const uint64_t mask = (uint64_t) ((1u << width) - 1) << shift;
+  uint64_t word = data[0] | (uint64_t) data[1] << 32;
+  word = (word & ~mask) | (uint64_t) lit << shift;
+  data[0] = (unsigned) word;
+  data[1] = (unsigned) (word >> 32);
+}
+
+static inline unsigned
+kissat_clause_literal (const clause * c, unsigned i)
+{
+  assert (i < CLAUSE_SIZE (c));
+  if (i > 1 && c->packed)
+    return kissat_packed_literal (c, i);
+  return BEGIN_LITS (c)[i];
+}
+
+#define all_literals_in_clause(LIT,C) \
+  unsigned LIT, LIT ## _IDX = 0, LIT ## _END = CLAUSE_SIZE (C); \
+  LIT ## _IDX != LIT ## _END && \
+    ((LIT = kissat_clause_literal ((C), LIT ## _IDX)), true); \
+  ++LIT ## _IDX
+
+#else
 
 #define all_literals_in_clause(LIT,C) \
   unsigned LIT, * LIT ## _PTR = BEGIN_LITS (C), \
@@ -44,16 +172,26 @@ struct clause
   LIT ## _PTR != LIT ## _END && ((LIT = *LIT ## _PTR), true); \
   ++LIT ## _PTR
 
+#endif
+
 static inline size_t
 kissat_bytes_of_clause (unsigned size)
 {
-  const size_t res = sizeof (clause) + (size - 3) * sizeof (unsigned);
+#ifdef SHORT_HEADER
+  if (size <= MAX_SHORT_SIZE)
+    return kissat_align_word ((1 + size) * sizeof (unsigned));
+#endif
+  const size_t res = offsetof (clause, lits) + size * sizeof (unsigned);
   return kissat_align_word (res);
 }
 
 static inline size_t
 kissat_actual_bytes_of_clause (clause * c)
 {
+#ifdef PACKED_CLAUSES
+  if (c->packed)
+    return kissat_bytes_of_packed_clause (c->size, PACKED_WIDTH (c));
+#endif
   const unsigned *p = END_LITS (c);
   if (c->shrunken)
     while (*p++ != INVALID_LIT)
@@ -61,6 +199,32 @@ kissat_actual_bytes_of_clause (clause * c)
   return kissat_align_word ((char *) p - (char *) c);
 }
 
+static inline void
+kissat_reset_searched (clause * c)
+{
+  if (!SHORT_CLAUSE (c))
+    c->searched = 2;
+}
+
+static inline void
+kissat_shrink_clause_size (clause * c, unsigned new_size)
+{
+  assert (new_size);
+  assert (new_size <= CLAUSE_SIZE (c));
+#ifdef PACKED_CLAUSES
+  assert (!c->packed);
+#endif
+#ifdef SHORT_HEADER
+  if (SHORT_CLAUSE (c))
+    {
+      c->short_size = new_size;
+      return;
+    }
+#endif
+  c->size = new_size;
+  c->searched = 2;
+}
+
 static inline clause *
 kissat_next_clause (clause * c)
 {
@@ -79,6 +243,7 @@ reference kissat_new_redundant_clause (struct kissat *, unsigned glue);
 
 #ifndef INLINE_SORT
 void kissat_sort_literals (struct kissat *, unsigned size, unsigned *lits);
+void kissat_sort_clause (struct kissat *, clause *);
 #endif
 
 void kissat_connect_clause (struct kissat *, clause *);
@@ -73,7 +73,7 @@ kissat_eager_subsume (kissat * solver)
 	goto REMOVE;
       if (!c->redundant)
 	goto REMOVE;
-      if (c->size + 1 < bound)
+      if (CLAUSE_SIZE (c) + 1 < bound)
 	continue;
       unsigned needed = size;
       for (all_literals_in_clause (lit, c))
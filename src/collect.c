@@ -5,8 +5,11 @@
 #include "collect.h"
 #include "compact.h"
 #include "inline.h"
+#include "pack.h"
 #include "print.h"
+#include "rank.h"
 #include "report.h"
+#include "resources.h"
 #include "trail.h"
 #include "sort.c"
 
@@ -83,14 +86,20 @@ flush_watched_clauses_by_literal (kissat * solver, litpairs * hyper,
       else
         {
           assert (solver->watching);
-          const watch tail = *p++;
+          const bool ternary = head.type.ternary;
+          const watch middle = ternary ? *p++ : head;
+          const watch *tail = p;
+          p += LARGE_WATCH_SIZE;
           if (!lit_fixed)
             {
-              const reference ref = tail.large.ref;
+              const reference ref = kissat_large_watch_reference (tail);
               if (ref < start)
                 {
                   *q++ = head;
-                  *q++ = tail;
+                  if (ternary)
+                    *q++ = middle;
+                  for (unsigned i = 0; i < LARGE_WATCH_SIZE; i++)
+                    *q++ = tail[i];
                 }
             }
         }
@@ -196,11 +205,11 @@ update_large_reason (kissat * solver, assigned * assigned, unsigned forced,
   const unsigned forced_idx = IDX (forced);
   struct assigned *a = assigned + forced_idx;
   assert (!a->binary);
-  if (a->reason != dst_ref)
+  if (ASSIGNED_REASON (a) != dst_ref)
     {
       LOG ("reason reference %u of %s updated to %u",
-           a->reason, LOGLIT (forced), dst_ref);
-      a->reason = dst_ref;
+           ASSIGNED_REASON (a), LOGLIT (forced), dst_ref);
+      ASSIGNED_REASON (a) = dst_ref;
     }
   dst->reason = false;
 }
@@ -302,7 +311,7 @@ move_redundant_clauses_to_the_end (kissat * solver, reference ref)
   while (p != end)
     {
       assert (!p->shrunken);
-      size_t bytes = kissat_bytes_of_clause (p->size);
+      size_t bytes = kissat_actual_bytes_of_clause (p);
       if (p->redundant)
         {
           memcpy (r, p, bytes);
@@ -324,7 +333,7 @@ move_redundant_clauses_to_the_end (kissat * solver, reference ref)
   clause *first_reducible = 0;
   while (q != end)
     {
-      size_t bytes = kissat_bytes_of_clause (r->size);
+      size_t bytes = kissat_actual_bytes_of_clause (r);
       memcpy (q, r, bytes);
       LOGCLS (q, "new DST");
       if (q->reason)
@@ -344,6 +353,58 @@ move_redundant_clauses_to_the_end (kissat * solver, reference ref)
   update_last_irredundant (solver, q, last_irredundant);
 }
 
+#ifdef PACKED_CLAUSES
+
+// Cold tier-3 clauses are packed while being moved down in the arena,
+// since then their literals are rewritten anyhow.  Packed clauses which
+// became hot (used or promoted) are unpacked, but only if the unpacked
+// clause fits into the gap before the next source clause, otherwise they
+// simply stay packed until a later collection.  The literals of packed
+// source clauses have been unpacked to 'lits' before and since compaction
+// only maps variables to smaller indices they fit into the same width.
+// Returns 'true' if the destination clause is packed.
+
+static bool
+sweep_packed_literals (kissat * solver, clause * dst, const clause * next,
+                       bool packed, unsigned width,
+                       unsigned size, unsigned *lits)
+{
+  const bool packable = kissat_packable_clause (solver, dst, size);
+  if (packed)
+    {
+      if (!packable)
+        {
+          const size_t bytes = sizeof (clause) +
+            (size - 3) * sizeof (unsigned);
+          if ((char *) dst + bytes <= (const char *) next)
+            {
+              dst->packed = false;
+              memcpy (dst->lits, lits, size * sizeof (unsigned));
+              INC (clauses_unpacked);
+              return false;
+            }
+        }
+      kissat_pack_literals (dst, width, size, lits);
+      return true;
+    }
+  if (!packable)
+    return false;
+  assert (!SHORT_CLAUSE (dst));
+  assert (lits == dst->lits);
+  width = kissat_packing_width (solver);
+  if (kissat_bytes_of_packed_clause (size, width) >=
+      kissat_bytes_of_clause (size))
+    return false;
+  CLEAR_STACK (solver->packed);
+  for (unsigned i = 0; i < size; i++)
+    PUSH_STACK (solver->packed, lits[i]);
+  kissat_pack_literals (dst, width, size, BEGIN_STACK (solver->packed));
+  INC (clauses_packed);
+  return true;
+}
+
+#endif
+
 static reference
 sparse_sweep_garbage_clauses (kissat * solver, bool compact, reference start)
 {
@@ -361,6 +422,10 @@ sparse_sweep_garbage_clauses (kissat * solver, bool compact, reference start)
   size_t flushed_garbage_clauses = 0;
   size_t flushed_satisfied_clauses = 0;
   size_t flushed_literals = 0;
+#if defined(PACKED_CLAUSES) && !defined(QUIET)
+  size_t packed_clauses = 0;
+  size_t packed_saved = 0;
+#endif
 
   clause *begin = (clause *) BEGIN_STACK (solver->arena);
   const clause *end = (clause *) END_STACK (solver->arena);
@@ -399,16 +464,34 @@ sparse_sweep_garbage_clauses (kissat * solver, bool compact, reference start)
           continue;
         }
 
-      assert (src->size > 1);
+      assert (CLAUSE_SIZE (src) > 1);
       LOGCLS (src, "SRC");
       next = kissat_next_clause (src);
-#if !defined(NDEBUG) || defined(CHECKING_OR_PROVING)
-      const unsigned old_size = src->size;
+      const unsigned old_size = CLAUSE_SIZE (src);
+#ifdef PACKED_CLAUSES
+      const bool packed = src->packed;
+      const unsigned width = packed ? PACKED_WIDTH (src) : 0;
+      unsigned *lits;
+      if (packed)
+        lits = kissat_unpack_literals (solver, src);
+      else
+        lits = BEGIN_LITS (src);
+#else
+      const unsigned *lits = BEGIN_LITS (src);
+#endif
+      const unsigned *end_lits = lits + old_size;
+#ifdef LRAT
+      uint64_t id = src->id;
 #endif
       assert (SIZE_OF_CLAUSE_HEADER == sizeof (unsigned));
       *(unsigned *) dst = *(unsigned *) src;
 
-      unsigned *q = dst->lits;
+#ifdef PACKED_CLAUSES
+      unsigned *q = packed ? lits : BEGIN_LITS (dst);
+#else
+      unsigned *q = BEGIN_LITS (dst);
+#endif
+      unsigned *const begin_q = q;
 
       unsigned mfirst = INVALID_LIT;
       unsigned msecond = INVALID_LIT;
@@ -418,8 +501,9 @@ sparse_sweep_garbage_clauses (kissat * solver, bool compact, reference start)
 
       bool satisfied = false;
 
-      for (all_literals_in_clause (lit, src))
+      for (const unsigned *p = lits; p != end_lits; p++)
         {
+          const unsigned lit = *p;
 #ifdef CHECKING_OR_PROVING
           if (checking_or_proving)
             PUSH_STACK (solver->removed, lit);
@@ -481,7 +565,12 @@ sparse_sweep_garbage_clauses (kissat * solver, bool compact, reference start)
           if (checking_or_proving)
             {
               REMOVE_CHECKER_STACK (solver->removed);
-              DELETE_STACK_FROM_PROOF (solver->removed);
+#ifdef LRAT
+              if (solver->lrat)
+                kissat_delete_id_from_proof (solver, id);
+              else
+#endif
+                DELETE_STACK_FROM_PROOF (solver->removed);
               CLEAR_STACK (solver->added);
               CLEAR_STACK (solver->removed);
             }
@@ -496,10 +585,19 @@ sparse_sweep_garbage_clauses (kissat * solver, bool compact, reference start)
           continue;
         }
 
-      const unsigned new_size = q - dst->lits;
+      const unsigned new_size = q - begin_q;
       assert (new_size <= old_size);
       assert (1 < new_size);
 
+#ifdef LRAT
+      if (solver->lrat && new_size != old_size)
+        id = kissat_flush_literals_in_proof (solver, id,
+                                             SIZE_STACK (solver->added),
+                                             BEGIN_STACK (solver->added),
+                                             SIZE_STACK (solver->removed),
+                                             BEGIN_STACK (solver->removed));
+#endif
+
       if (new_size == 2)
         {
           assert (mfirst != INVALID_LIT);
@@ -524,10 +622,10 @@ sparse_sweep_garbage_clauses (kissat * solver, bool compact, reference start)
 
               LOGBINARY (mfirst, msecond,
                          "reason clause[%u] of %s updated to binary reason",
-                         a->reason, LOGLIT (forced));
+                         ASSIGNED_REASON (a), LOGLIT (forced));
 
               a->binary = true;
-              a->reason = other;
+              ASSIGNED_REASON (a) = other;
             }
 
           if (!redundant && last_irredundant == src)
@@ -542,9 +640,39 @@ sparse_sweep_garbage_clauses (kissat * solver, bool compact, reference start)
         {
           assert (2 < new_size);
 
-          dst->size = new_size;
-          dst->shrunken = false;
-          dst->searched = 2;
+#ifdef PACKED_CLAUSES
+          if (!sweep_packed_literals (solver, dst, next,
+                                      packed, width, new_size, begin_q))
+#endif
+            {
+#ifdef SHORT_HEADER
+              if (SHORT_CLAUSE (dst))
+                dst->short_size = new_size;
+              else if (new_size <= MAX_SHORT_SIZE)
+                {
+                  memmove ((unsigned *) dst + 1, dst->lits,
+                           new_size * sizeof (unsigned));
+                  dst->short_size = new_size;
+                }
+              else
+#endif
+                {
+                  dst->size = new_size;
+                  dst->searched = 2;
+                }
+              dst->shrunken = false;
+            }
+#ifdef LRAT
+          dst->id = id;
+#endif
+#if defined(PACKED_CLAUSES) && !defined(QUIET)
+          else
+            {
+              packed_clauses++;
+              packed_saved += kissat_bytes_of_clause (new_size);
+              packed_saved -= kissat_actual_bytes_of_clause (dst);
+            }
+#endif
 
           LOGCLS (dst, "DST");
           if (dst->reason)
@@ -577,10 +705,12 @@ sparse_sweep_garbage_clauses (kissat * solver, bool compact, reference start)
           assert (new_size < old_size);
 
           CHECK_AND_ADD_STACK (solver->added);
-          ADD_STACK_TO_PROOF (solver->added);
+          if (!LRAT_PROOF)
+            ADD_STACK_TO_PROOF (solver->added);
 
           REMOVE_CHECKER_STACK (solver->removed);
-          DELETE_STACK_FROM_PROOF (solver->removed);
+          if (!LRAT_PROOF)
+            DELETE_STACK_FROM_PROOF (solver->removed);
         }
       CLEAR_STACK (solver->added);
       CLEAR_STACK (solver->removed);
@@ -620,6 +750,14 @@ sparse_sweep_garbage_clauses (kissat * solver, bool compact, reference start)
   kissat_phase (solver, "collect",
                 GET (garbage_collections),
                 "collected %s in total", FORMAT_BYTES (bytes));
+#ifdef PACKED_CLAUSES
+  if (packed_clauses)
+    kissat_phase (solver, "collect",
+                  GET (garbage_collections),
+                  "%zu packed clauses save %s in arena of %s",
+                  packed_clauses, FORMAT_BYTES (packed_saved),
+                  FORMAT_BYTES ((char *) dst - (char *) begin));
+#endif
 #endif
   ADD (literals_flushed, flushed_literals);
 #ifndef NMETRICS
@@ -678,17 +816,132 @@ rewatch_clauses (kissat * solver, reference start)
     {
       next = kissat_next_clause (c);
 
-      unsigned *lits = c->lits;
-      kissat_sort_literals (solver, values, assigned, c->size, lits);
-      c->searched = 2;
+      kissat_sort_clause (solver, values, assigned, c);
+      kissat_reset_searched (c);
 
       const reference ref = (word *) c - arena;
-      const unsigned l0 = lits[0];
-      const unsigned l1 = lits[1];
+      kissat_inlined_watch_clause (solver, watches, c, ref);
+    }
+}
+
+typedef struct reorderable reorderable;
+
+struct reorderable
+{
+  uint64_t rank;
+  reference ref;
+};
+
+// *INDENT-OFF*
+
+typedef STACK (reorderable) reorderables;
+
+// *INDENT-ON*
+
+#define RANK_REORDERABLE(R) ((R).rank)
+
+#define RADIX_SORT_REORDER_LENGTH 16
 
-      kissat_push_blocking_watch (solver, watches + l0, l1, ref);
-      kissat_push_blocking_watch (solver, watches + l1, l0, ref);
+#ifndef QUIET
+
+static void
+report_search_ticks_rate (kissat * solver)
+{
+  reordered *reordered = &solver->reordered;
+  const double time = kissat_process_time ();
+  const uint64_t ticks = solver->statistics.search_ticks;
+  assert (reordered->ticks <= ticks);
+  const double rate =
+    kissat_average (ticks - reordered->ticks, time - reordered->time);
+  const double previous = reordered->rate;
+  kissat_phase (solver, "reorder", GET (reordered),
+                "%.0f search ticks per second (%+.0f%% to previous)",
+                rate, previous ? kissat_percent (rate - previous,
+                                                 previous) : 0);
+  reordered->time = time;
+  reordered->rate = rate;
+  reordered->ticks = ticks;
+}
+
+#endif
+
+// Reorder the clauses after 'start' by their first watched literal.  The
+// clauses in the watch list of a literal are then adjacent in the arena.
+// Irredundant clauses stay before redundant ones and kept redundant
+// clauses are placed before reducible ones.
+
+static void
+reorder_clauses (kissat * solver, reference start)
+{
+  assert (solver->watching);
+  word *arena = BEGIN_STACK (solver->arena);
+  clause *begin = (clause *) (arena + start);
+  clause *end = (clause *) END_STACK (solver->arena);
+  if (begin == end)
+    return;
+  INC (reordered);
+#ifndef QUIET
+  report_search_ticks_rate (solver);
+#endif
+  const value *values = solver->values;
+  assigned *assigned = solver->assigned;
+
+  reorderables reorder;
+  INIT_STACK (reorder);
+
+  for (clause * c = begin, *next; c != end; c = next)
+    {
+      next = kissat_next_clause (c);
+      assert (!c->garbage);
+      kissat_sort_clause (solver, values, assigned, c);
+      const unsigned *lits = BEGIN_LITS (c);
+      const uint64_t class = !c->redundant ? 0 : c->keep ? 1 : 2;
+      reorderable reorderable;
+      reorderable.rank = (class << 32) | lits[0];
+      reorderable.ref = (word *) c - arena;
+      PUSH_STACK (reorder, reorderable);
     }
+
+  RADIX_STACK (RADIX_SORT_REORDER_LENGTH, reorderable,
+               uint64_t, reorder, RANK_REORDERABLE);
+
+  kissat_mark_reason_clauses (solver, start);
+
+  const size_t bytes = (char *) end - (char *) begin;
+  char *copy = kissat_malloc (solver, bytes);
+  memcpy (copy, begin, bytes);
+
+  clause *first_reducible = 0;
+  clause *last_irredundant = 0;
+
+  clause *dst = begin;
+  for (all_stack (reorderable, reorderable, reorder))
+    {
+      const size_t offset = (reorderable.ref - start) * sizeof (word);
+      clause *src = (clause *) (copy + offset);
+      const size_t clause_bytes = kissat_actual_bytes_of_clause (src);
+      memcpy (dst, src, clause_bytes);
+      if (dst->reason)
+        get_forced_and_update_large_reason (solver, assigned, values, dst);
+      if (!dst->redundant)
+        last_irredundant = dst;
+      else if (!first_reducible && !dst->keep)
+        first_reducible = dst;
+      dst = (clause *) (clause_bytes + (char *) dst);
+    }
+  assert (dst == end);
+
+  kissat_free (solver, copy, bytes);
+  kissat_phase (solver, "reorder", GET (reordered),
+                "reordered %zu clauses %s", SIZE_STACK (reorder),
+                FORMAT_BYTES (bytes));
+  RELEASE_STACK (reorder);
+
+  if (last_irredundant)
+    update_last_irredundant (solver, end, last_irredundant);
+  if (solver->first_reducible == INVALID_REF ||
+      start <= solver->first_reducible)
+    update_first_reducible (solver, end, first_reducible);
 }
 
 void
@@ -713,6 +966,8 @@ kissat_sparse_collect (kissat * solver, bool compact, reference start)
     kissat_finalize_compacting (solver, vars, mfixed);
   if (move != INVALID_REF)
     move_redundant_clauses_to_the_end (solver, move);
+  if (GET_OPTION (reorder))
+    reorder_clauses (solver, start);
   rewatch_clauses (solver, start);
   REPORT (1, 'C');
   kissat_check_statistics (solver);
@@ -746,15 +1001,37 @@ dense_sweep_garbage_clauses (kissat * solver)
           flushed_garbage_clauses++;
           continue;
         }
-      assert (src->size > 1);
+      assert (CLAUSE_SIZE (src) > 1);
       LOGCLS (src, "SRC");
       next = kissat_next_clause (src);
       assert (SIZE_OF_CLAUSE_HEADER == sizeof (unsigned));
-      *(unsigned *) dst = *(unsigned *) src;
-      dst->searched = src->searched;
-      dst->size = src->size;
-      dst->shrunken = false;
-      memmove (dst->lits, src->lits, src->size * sizeof (unsigned));
+#ifdef PACKED_CLAUSES
+      if (src->packed)
+        memmove (dst, src, (char *) next - (char *) src);
+      else
+#endif
+        {
+          const unsigned size = CLAUSE_SIZE (src);
+          const unsigned *lits = BEGIN_LITS (src);
+#ifdef LRAT
+          const uint64_t id = src->id;
+#endif
+          *(unsigned *) dst = *(unsigned *) src;
+#ifdef SHORT_HEADER
+          if (size <= MAX_SHORT_SIZE)
+            dst->short_size = size;
+          else
+#endif
+            {
+              dst->searched = src->searched;
+              dst->size = size;
+            }
+          dst->shrunken = false;
+#ifdef LRAT
+          dst->id = id;
+#endif
+          memmove (BEGIN_LITS (dst), lits, size * sizeof (unsigned));
+        }
       LOGCLS (dst, "DST");
       if (!dst->redundant)
         last_irredundant = dst;
@@ -9,6 +9,9 @@ void kissat_sparse_collect (struct kissat *, bool compact, reference start);
 static inline void
 kissat_defrag_watches_if_needed (kissat * solver)
 {
+  if (solver->vectors.defragged)
+    return;
+
   const size_t size = SIZE_STACK (solver->vectors.stack);
   const size_t size_limit = GET_OPTION (defragsize);
   if (size <= size_limit)
@@ -20,7 +23,23 @@ kissat_defrag_watches_if_needed (kissat * solver)
     return;
 
   INC (vectors_defrags_needed);
-  kissat_defrag_vectors (solver, &solver->vectors, LITS, solver->watches);
+  if (GET_OPTION (defragstep))
+    kissat_start_defrag_vectors (solver, &solver->vectors);
+  else
+    kissat_defrag_vectors (solver, &solver->vectors, LITS, solver->watches);
+}
+
+static inline void
+kissat_defrag_watches_step (kissat * solver)
+{
+  if (!solver->vectors.defragged)
+    return;
+  const unsigned steps = GET_OPTION (defragstep);
+  if (steps)
+    kissat_defrag_vectors_step (solver, &solver->vectors,
+				LITS, solver->watches, steps);
+  else
+    kissat_defrag_vectors (solver, &solver->vectors, LITS, solver->watches);
 }
 
 #endif
@@ -1,5 +1,6 @@
 #include "compact.h"
 #include "inline.h"
+#include "pack.h"
 #include "print.h"
 #include "resize.h"
 
@@ -18,6 +19,7 @@ unsigned
 kissat_compact_literals (kissat * solver, unsigned *mfixed_ptr)
 {
   INC (compacted);
+  kissat_stop_defrag_vectors (solver, &solver->vectors);
 #if !defined(QUIET) || !defined(NDEBUG)
   const unsigned active = solver->active;
 #ifndef QUIET
@@ -117,6 +119,9 @@ compact_literal (kissat * solver, unsigned dst_lit, unsigned src_lit)
   assert (dst_idx != src_idx);
   LOG ("mapping old internal literal %u to %u", src_lit, dst_lit);
   solver->assigned[dst_idx] = solver->assigned[src_idx];
+#ifdef SPLIT_ASSIGNED
+  solver->reasons[dst_idx] = solver->reasons[src_idx];
+#endif
   solver->flags[dst_idx] = solver->flags[src_idx];
   solver->phases[dst_idx] = solver->phases[src_idx];
   const unsigned not_src_lit = NOT (src_lit);
@@ -230,11 +235,11 @@ compact_trail (kissat * solver)
       assigned *a = solver->assigned + idx;
       if (!a->binary)
 	continue;
-      const unsigned other = a->reason;
+      const unsigned other = ASSIGNED_REASON (a);
       assert (VALID_INTERNAL_LITERAL (other));
       const unsigned mother = kissat_map_literal (solver, other, true);
       assert (mother != INVALID_LIT);
-      a->reason = mother;
+      ASSIGNED_REASON (a) = mother;
     }
 }
 
@@ -376,6 +381,325 @@ compact_best_and_target_values (kissat * solver, unsigned vars)
   kissat_reset_consistently_assigned (solver);
 }
 
+// Renumbering orders variables by a breadth-first search over the
+// incidence graph of irredundant clauses, such that variables occurring
+// together in clauses get close indices.  Then their entries in the
+// variable and literal indexed arrays tend to share cache lines.  It is
+// a pure permutation applied at the end of compacting, where all large
+// clause watches are flushed and thus only binary watches remain.
+
+static inline void
+visit_variable (unsigned *map, unsigned *order,
+		unsigned *renumbered, unsigned idx)
+{
+  if (map[idx] != INVALID_IDX)
+    return;
+  const unsigned midx = (*renumbered)++;
+  map[idx] = midx;
+  order[midx] = idx;
+}
+
+static unsigned
+breadth_first_search (kissat * solver, unsigned *map, unsigned *order)
+{
+  const unsigned vars = VARS;
+  unsigned *offsets = kissat_calloc (solver, vars + 1, sizeof (unsigned));
+  references clauses;
+  INIT_STACK (clauses);
+  for (all_clauses (c))
+    {
+      if (c->garbage || c->redundant)
+	continue;
+      const reference ref = kissat_reference_clause (solver, c);
+      PUSH_STACK (clauses, ref);
+      for (all_literals_in_clause (lit, c))
+	offsets[IDX (lit)]++;
+    }
+  unsigned occurrences = 0;
+  for (all_variables (idx))
+    occurrences = (offsets[idx] += occurrences);
+  offsets[vars] = occurrences;
+  unsigned *occurs = kissat_malloc (solver, occurrences * sizeof (unsigned));
+  const unsigned size_clauses = SIZE_STACK (clauses);
+  for (unsigned pos = 0; pos < size_clauses; pos++)
+    {
+      const reference ref = PEEK_STACK (clauses, pos);
+      clause *c = kissat_dereference_clause (solver, ref);
+      for (all_literals_in_clause (lit, c))
+	occurs[--offsets[IDX (lit)]] = pos;
+    }
+  for (all_variables (idx))
+    map[idx] = INVALID_IDX;
+  unsigned renumbered = 0, components = 0;
+  for (all_variables (root))
+    {
+      if (map[root] != INVALID_IDX)
+	continue;
+      components++;
+      unsigned search = renumbered;
+      visit_variable (map, order, &renumbered, root);
+      while (search < renumbered)
+	{
+	  const unsigned idx = order[search++];
+	  const unsigned lit = LIT (idx);
+	  for (unsigned sign = 0; sign < 2; sign++)
+	    {
+	      watches *watches = &WATCHES (lit + sign);
+	      for (all_binary_blocking_watches (watch, *watches))
+		{
+		  assert (watch.type.binary);
+		  if (watch.binary.redundant)
+		    continue;
+		  const unsigned other = IDX (watch.binary.lit);
+		  visit_variable (map, order, &renumbered, other);
+		}
+	    }
+	  const unsigned end = offsets[idx + 1];
+	  for (unsigned i = offsets[idx]; i < end; i++)
+	    {
+	      const unsigned pos = occurs[i];
+	      const reference ref = PEEK_STACK (clauses, pos);
+	      if (ref == INVALID_REF)
+		continue;
+	      POKE_STACK (clauses, pos, INVALID_REF);
+	      clause *c = kissat_dereference_clause (solver, ref);
+	      for (all_literals_in_clause (other, c))
+		visit_variable (map, order, &renumbered, IDX (other));
+	    }
+	}
+    }
+  assert (renumbered == vars);
+  kissat_free (solver, occurs, occurrences * sizeof (unsigned));
+  kissat_dealloc (solver, offsets, vars + 1, sizeof (unsigned));
+  RELEASE_STACK (clauses);
+  return components;
+}
+
+static inline unsigned
+renumber_literal (kissat * solver, const unsigned *map, unsigned lit)
+{
+  const unsigned mlit = LIT (map[IDX (lit)]);
+#ifdef NDEBUG
+  (void) solver;
+#endif
+  return NEGATED (lit) ? NOT (mlit) : mlit;
+}
+
+#define RENUMBER_VARIABLE_INDEXED(TYPE, NAME) \
+do { \
+  const size_t bytes = vars * sizeof (TYPE); \
+  TYPE *old = kissat_malloc (solver, bytes); \
+  memcpy (old, solver->NAME, bytes); \
+  for (unsigned idx = 0; idx < vars; idx++) \
+    solver->NAME[map[idx]] = old[idx]; \
+  kissat_free (solver, old, bytes); \
+} while (0)
+
+#define RENUMBER_LITERAL_INDEXED(TYPE, NAME) \
+do { \
+  const size_t bytes = 2 * vars * sizeof (TYPE); \
+  TYPE *old = kissat_malloc (solver, bytes); \
+  memcpy (old, solver->NAME, bytes); \
+  for (unsigned lit = 0; lit < 2 * vars; lit++) \
+    solver->NAME[renumber_literal (solver, map, lit)] = old[lit]; \
+  kissat_free (solver, old, bytes); \
+} while (0)
+
+static inline unsigned
+renumber_link (const unsigned *map, unsigned idx)
+{
+  return DISCONNECTED (idx) ? idx : map[idx];
+}
+
+static void
+renumber_queue (kissat * solver, const unsigned *map)
+{
+  const unsigned vars = VARS;
+  RENUMBER_VARIABLE_INDEXED (links, links);
+  links *links = solver->links;
+  for (unsigned idx = 0; idx < vars; idx++)
+    {
+      struct links *l = links + idx;
+      l->prev = renumber_link (map, l->prev);
+      l->next = renumber_link (map, l->next);
+    }
+  queue *queue = &solver->queue;
+  queue->first = renumber_link (map, queue->first);
+  queue->last = renumber_link (map, queue->last);
+  queue->search.idx = renumber_link (map, queue->search.idx);
+}
+
+static void
+renumber_scores (kissat * solver, const unsigned *map)
+{
+  heap new_scores;
+  memset (&new_scores, 0, sizeof new_scores);
+  kissat_resize_heap (solver, &new_scores, VARS);
+  heap *old_scores = &solver->scores;
+  if (old_scores->tainted)
+    for (unsigned idx = 0; idx < old_scores->vars; idx++)
+      {
+	const double score = kissat_get_heap_score (old_scores, idx);
+	kissat_update_heap (solver, &new_scores, map[idx], score);
+      }
+  for (all_stack (unsigned, idx, old_scores->stack))
+    kissat_push_heap (solver, &new_scores, map[idx]);
+  kissat_release_heap (solver, old_scores);
+  solver->scores = new_scores;
+}
+
+static void
+renumber_watches (kissat * solver, const unsigned *map)
+{
+  const unsigned vars = VARS;
+  RENUMBER_LITERAL_INDEXED (watches, watches);
+  for (all_literals (lit))
+    {
+      watches *watches = &WATCHES (lit);
+      watch *begin = BEGIN_WATCHES (*watches);
+      watch *end = END_WATCHES (*watches);
+      for (watch * p = begin; p != end; p++)
+	{
+	  assert (p->type.binary);
+	  p->binary.lit = renumber_literal (solver, map, p->binary.lit);
+	}
+    }
+}
+
+static void
+renumber_clauses (kissat * solver, const unsigned *map)
+{
+  for (all_clauses (c))
+    {
+#ifdef PACKED_CLAUSES
+      if (c->packed)
+	{
+	  const unsigned size = c->size;
+	  for (unsigned i = 0; i < 2; i++)
+	    c->lits[i] = renumber_literal (solver, map, c->lits[i]);
+	  for (unsigned i = 2; i < size; i++)
+	    {
+	      const unsigned lit = kissat_packed_literal (c, i);
+	      const unsigned mlit = renumber_literal (solver, map, lit);
+	      kissat_set_packed_literal (c, i, mlit);
+	    }
+	  continue;
+	}
+#endif
+      unsigned *lits = BEGIN_LITS (c);
+      const unsigned size = CLAUSE_SIZE (c);
+      for (unsigned i = 0; i < size; i++)
+	lits[i] = renumber_literal (solver, map, lits[i]);
+    }
+}
+
+static void
+renumber_trail (kissat * solver, const unsigned *map)
+{
+  const size_t size = SIZE_STACK (solver->trail);
+  for (size_t i = 0; i < size; i++)
+    {
+      const unsigned lit = PEEK_STACK (solver->trail, i);
+      const unsigned mlit = renumber_literal (solver, map, lit);
+      POKE_STACK (solver->trail, i, mlit);
+      assigned *a = solver->assigned + IDX (mlit);
+      if (a->binary)
+	{
+	  const unsigned other = ASSIGNED_REASON (a);
+	  ASSIGNED_REASON (a) = renumber_literal (solver, map, other);
+	}
+    }
+  const size_t levels = SIZE_STACK (solver->frames);
+  for (size_t level = 1; level < levels; level++)
+    {
+      frame *frame = &FRAME (level);
+      frame->decision = renumber_literal (solver, map, frame->decision);
+    }
+}
+
+static void
+renumber_import_and_export (kissat * solver, const unsigned *map)
+{
+  const unsigned vars = VARS;
+  assert (SIZE_STACK (solver->export) == vars);
+  RENUMBER_VARIABLE_INDEXED (int, export.begin);
+  const import *end = END_STACK (solver->import);
+  for (import * p = BEGIN_STACK (solver->import); p != end; p++)
+    if (p->imported && !p->eliminated)
+      p->lit = renumber_literal (solver, map, p->lit);
+#ifndef NDEBUG
+  for (unsigned idx = 0; idx < vars; idx++)
+    {
+      const int elit = PEEK_STACK (solver->export, idx);
+      const unsigned eidx = ABS (elit);
+      const import *import = &PEEK_STACK (solver->import, eidx);
+      assert (import->imported);
+      assert (!import->eliminated);
+      const unsigned ilit = elit < 0 ? NOT (import->lit) : import->lit;
+      assert (ilit == LIT (idx));
+    }
+#endif
+}
+
+#ifdef PACKED_CLAUSES
+
+// Renumbered literals of a packed clause have to fit into its width,
+// which might not be the case if variables were added after packing.
+
+static bool
+narrow_packed_clauses (kissat * solver)
+{
+  const unsigned width = kissat_packing_width (solver);
+  for (all_clauses (c))
+    if (c->packed && PACKED_WIDTH (c) < width)
+      return true;
+  return false;
+}
+
+#endif
+
+static void
+renumber_variables (kissat * solver)
+{
+  const unsigned vars = VARS;
+  if (vars < 2)
+    return;
+#ifdef PACKED_CLAUSES
+  if (narrow_packed_clauses (solver))
+    {
+      kissat_very_verbose (solver, "not renumbering narrow packed clauses");
+      return;
+    }
+#endif
+  INC (renumbered);
+  unsigned *map = kissat_malloc (solver, vars * sizeof (unsigned));
+  unsigned *order = kissat_malloc (solver, vars * sizeof (unsigned));
+  const unsigned components = breadth_first_search (solver, map, order);
+  kissat_phase (solver, "renumber", GET (renumbered),
+		"renumbered %u variables in %u connected components",
+		vars, components);
+  (void) components;
+  kissat_free (solver, order, vars * sizeof (unsigned));
+
+  RENUMBER_VARIABLE_INDEXED (assigned, assigned);
+#ifdef SPLIT_ASSIGNED
+  RENUMBER_VARIABLE_INDEXED (reference, reasons);
+#endif
+  RENUMBER_VARIABLE_INDEXED (flags, flags);
+  RENUMBER_VARIABLE_INDEXED (phase, phases);
+  RENUMBER_LITERAL_INDEXED (value, values);
+
+  renumber_queue (solver, map);
+  renumber_scores (solver, map);
+  renumber_watches (solver, map);
+  renumber_clauses (solver, map);
+  renumber_trail (solver, map);
+  renumber_import_and_export (solver, map);
+  solver->transitive = renumber_literal (solver, map, solver->transitive);
+
+  kissat_free (solver, map, vars * sizeof (unsigned));
+}
+
 void
 kissat_finalize_compacting (kissat * solver, unsigned vars, unsigned mfixed)
 {
@@ -422,7 +746,11 @@ kissat_finalize_compacting (kissat * solver, unsigned vars, unsigned mfixed)
     compact_units (solver, mfixed);
 
   memset (solver->assigned + vars, 0, reduced * sizeof (assigned));
+#ifdef SPLIT_ASSIGNED
+  memset (solver->reasons + vars, 0, reduced * sizeof (reference));
+#endif
   memset (solver->flags + vars, 0, reduced * sizeof (flags));
+  memset (solver->phases + vars, 0, reduced * sizeof (phase));
   memset (solver->values + 2 * vars, 0, 2 * reduced * sizeof (value));
   memset (solver->watches + 2 * vars, 0, 2 * reduced * sizeof (watches));
 
@@ -436,5 +764,7 @@ kissat_finalize_compacting (kissat * solver, unsigned vars, unsigned mfixed)
 #ifdef LOGGING
   solver->compacting = false;
 #endif
+  if (GET_OPTION (renumber))
+    renumber_variables (solver);
   kissat_decrease_size (solver);
 }
@@ -0,0 +1,403 @@
+#include "allocate.h"
+#include "decompress.h"
+#include "error.h"
+
+#include <assert.h>
+#include <stdint.h>
+
+#ifdef BZIP2
+#include <bzlib.h>
+#endif
+#ifdef ZLIB
+#include <zlib.h>
+#endif
+#ifdef LZMA
+#include <lzma.h>
+#endif
+#ifdef ZSTD
+#include <zstd.h>
+#endif
+
+#define INPUT_BUFFER_SIZE (1u<<18)
+
+#if defined(BZIP2) || defined(ZLIB) || defined(LZMA) || defined(ZSTD)
+#define DECOMPRESS
+#endif
+
+struct decompressor
+{
+  compression compression;
+  bool eof;
+  bool done;
+  FILE *file;
+  const char *path;
+  unsigned char *input;
+  union
+  {
+#ifdef BZIP2
+    bz_stream bzip2;
+#endif
+#ifdef ZLIB
+    z_stream gzip;
+#endif
+#ifdef LZMA
+    lzma_stream lzma;
+#endif
+#ifdef ZSTD
+    struct
+    {
+      ZSTD_DStream *stream;
+      ZSTD_inBuffer in;
+      size_t hint;
+    } zstd;
+#endif
+    int dummy;
+  } u;
+};
+
+bool
+kissat_decompressing (compression compression)
+{
+  switch (compression)
+    {
+#ifdef BZIP2
+    case BZIP2_COMPRESSION:
+      return true;
+#endif
+#ifdef ZLIB
+    case GZIP_COMPRESSION:
+      return true;
+#endif
+#ifdef LZMA
+    case LZMA_COMPRESSION:
+    case XZ_COMPRESSION:
+      return true;
+#endif
+#ifdef ZSTD
+    case ZSTD_COMPRESSION:
+      return true;
+#endif
+    default:
+      return false;
+    }
+}
+
+#ifdef DECOMPRESS
+
+static size_t
+read_input (decompressor * decompressor)
+{
+  if (decompressor->eof)
+    return 0;
+  size_t bytes = fread (decompressor->input, 1,
+			INPUT_BUFFER_SIZE, decompressor->file);
+  if (!bytes)
+    decompressor->eof = true;
+  return bytes;
+}
+
+static void
+failed (decompressor * decompressor)
+{
+  kissat_error ("failed to decompress '%s'", decompressor->path);
+  decompressor->done = true;
+}
+
+#endif
+
+#ifdef BZIP2
+
+static bool
+init_bzip2 (decompressor * decompressor)
+{
+  bz_stream *bzip2 = &decompressor->u.bzip2;
+  bzip2->bzalloc = 0;
+  bzip2->bzfree = 0;
+  bzip2->opaque = 0;
+  return BZ2_bzDecompressInit (bzip2, 0, 0) == BZ_OK;
+}
+
+static size_t
+decompress_bzip2 (decompressor * decompressor,
+		  unsigned char *buffer, size_t size)
+{
+  bz_stream *bzip2 = &decompressor->u.bzip2;
+  bzip2->next_out = (char *) buffer;
+  bzip2->avail_out = size;
+  while (!decompressor->done && bzip2->avail_out == size)
+    {
+      if (!bzip2->avail_in)
+	{
+	  bzip2->next_in = (char *) decompressor->input;
+	  bzip2->avail_in = read_input (decompressor);
+	}
+      const int res = BZ2_bzDecompress (bzip2);
+      if (res == BZ_STREAM_END)
+	{
+	  if (!bzip2->avail_in)
+	    {
+	      bzip2->next_in = (char *) decompressor->input;
+	      bzip2->avail_in = read_input (decompressor);
+	    }
+	  if (!bzip2->avail_in)
+	    decompressor->done = true;
+	  else
+	    {
+	      char *next_in = bzip2->next_in;
+	      const unsigned avail_in = bzip2->avail_in;
+	      char *next_out = bzip2->next_out;
+	      const unsigned avail_out = bzip2->avail_out;
+	      BZ2_bzDecompressEnd (bzip2);
+	      if (!init_bzip2 (decompressor))
+		failed (decompressor);
+	      bzip2->next_in = next_in;
+	      bzip2->avail_in = avail_in;
+	      bzip2->next_out = next_out;
+	      bzip2->avail_out = avail_out;
+	    }
+	}
+      else if (res != BZ_OK)
+	failed (decompressor);
+      else if (decompressor->eof && !bzip2->avail_in &&
+	       bzip2->avail_out == size)
+	failed (decompressor);
+    }
+  return size - bzip2->avail_out;
+}
+
+#endif
+
+#ifdef ZLIB
+
+static size_t
+decompress_gzip (decompressor * decompressor,
+		 unsigned char *buffer, size_t size)
+{
+  z_stream *gzip = &decompressor->u.gzip;
+  gzip->next_out = buffer;
+  gzip->avail_out = size;
+  while (!decompressor->done && gzip->avail_out == size)
+    {
+      if (!gzip->avail_in)
+	{
+	  gzip->next_in = decompressor->input;
+	  gzip->avail_in = read_input (decompressor);
+	}
+      const int res = inflate (gzip, Z_NO_FLUSH);
+      if (res == Z_STREAM_END)
+	{
+	  if (!gzip->avail_in)
+	    {
+	      gzip->next_in = decompressor->input;
+	      gzip->avail_in = read_input (decompressor);
+	    }
+	  if (!gzip->avail_in)
+	    decompressor->done = true;
+	  else if (inflateReset (gzip) != Z_OK)
+	    failed (decompressor);
+	}
+      else if (res == Z_BUF_ERROR)
+	{
+	  if (decompressor->eof && gzip->avail_out == size)
+	    failed (decompressor);
+	}
+      else if (res != Z_OK)
+	failed (decompressor);
+    }
+  return size - gzip->avail_out;
+}
+
+#endif
+
+#ifdef LZMA
+
+static size_t
+decompress_lzma (decompressor * decompressor,
+		 unsigned char *buffer, size_t size)
+{
+  lzma_stream *lzma = &decompressor->u.lzma;
+  lzma->next_out = buffer;
+  lzma->avail_out = size;
+  while (!decompressor->done && lzma->avail_out == size)
+    {
+      if (!lzma->avail_in)
+	{
+	  lzma->next_in = decompressor->input;
+	  lzma->avail_in = read_input (decompressor);
+	}
+      lzma_action action = decompressor->eof ? LZMA_FINISH : LZMA_RUN;
+      const lzma_ret res = lzma_code (lzma, action);
+      if (res == LZMA_STREAM_END)
+	decompressor->done = true;
+      else if (res != LZMA_OK)
+	failed (decompressor);
+    }
+  return size - lzma->avail_out;
+}
+
+#endif
+
+#ifdef ZSTD
+
+static size_t
+decompress_zstd (decompressor * decompressor,
+		 unsigned char *buffer, size_t size)
+{
+  ZSTD_inBuffer *in = &decompressor->u.zstd.in;
+  ZSTD_outBuffer out = { buffer, size, 0 };
+  while (!decompressor->done && !out.pos)
+    {
+      if (in->pos == in->size && !decompressor->eof)
+	{
+	  in->src = decompressor->input;
+	  in->size = read_input (decompressor);
+	  in->pos = 0;
+	}
+      const bool consumed = decompressor->eof && in->pos == in->size;
+      if (consumed && !decompressor->u.zstd.hint)
+	{
+	  decompressor->done = true;
+	  break;
+	}
+      const size_t res =
+	ZSTD_decompressStream (decompressor->u.zstd.stream, &out, in);
+      if (ZSTD_isError (res) || (consumed && !out.pos))
+	failed (decompressor);
+      else
+	decompressor->u.zstd.hint = res;
+    }
+  return out.pos;
+}
+
+#endif
+
+decompressor *
+kissat_new_decompressor (compression compression,
+			 FILE * file, const char *path)
+{
+  if (!kissat_decompressing (compression))
+    return 0;
+  decompressor *res = kissat_calloc (0, 1, sizeof *res);
+  res->compression = compression;
+  res->file = file;
+  res->path = path;
+  res->input = kissat_malloc (0, INPUT_BUFFER_SIZE);
+  bool initialized = false;
+  switch (compression)
+    {
+#ifdef BZIP2
+    case BZIP2_COMPRESSION:
+      initialized = init_bzip2 (res);
+      break;
+#endif
+#ifdef ZLIB
+    case GZIP_COMPRESSION:
+      initialized = (inflateInit2 (&res->u.gzip, 15 + 16) == Z_OK);
+      break;
+#endif
+#ifdef LZMA
+    case LZMA_COMPRESSION:
+      {
+	const lzma_stream init = LZMA_STREAM_INIT;
+	res->u.lzma = init;
+	initialized =
+	  (lzma_alone_decoder (&res->u.lzma, UINT64_MAX) == LZMA_OK);
+      }
+      break;
+    case XZ_COMPRESSION:
+      {
+	const lzma_stream init = LZMA_STREAM_INIT;
+	res->u.lzma = init;
+	initialized =
+	  (lzma_stream_decoder (&res->u.lzma, UINT64_MAX,
+				LZMA_CONCATENATED) == LZMA_OK);
+      }
+      break;
+#endif
+#ifdef ZSTD
+    case ZSTD_COMPRESSION:
+      res->u.zstd.stream = ZSTD_createDStream ();
+      if (res->u.zstd.stream)
+	{
+	  res->u.zstd.hint = ZSTD_initDStream (res->u.zstd.stream);
+	  initialized = !ZSTD_isError (res->u.zstd.hint);
+	}
+      break;
+#endif
+    default:
+      break;
+    }
+  if (!initialized)
+    {
+      kissat_free (0, res->input, INPUT_BUFFER_SIZE);
+      kissat_free (0, res, sizeof *res);
+      return 0;
+    }
+  return res;
+}
+
+size_t
+kissat_decompress (decompressor * decompressor,
+		   unsigned char *buffer, size_t size)
+{
+  assert (size);
+  if (decompressor->done)
+    return 0;
+  switch (decompressor->compression)
+    {
+#ifdef BZIP2
+    case BZIP2_COMPRESSION:
+      return decompress_bzip2 (decompressor, buffer, size);
+#endif
+#ifdef ZLIB
+    case GZIP_COMPRESSION:
+      return decompress_gzip (decompressor, buffer, size);
+#endif
+#ifdef LZMA
+    case LZMA_COMPRESSION:
+    case XZ_COMPRESSION:
+      return decompress_lzma (decompressor, buffer, size);
+#endif
+#ifdef ZSTD
+    case ZSTD_COMPRESSION:
+      return decompress_zstd (decompressor, buffer, size);
+#endif
+    default:
+      (void) buffer;
+      (void) size;
+      return 0;
+    }
+}
+
+void
+kissat_delete_decompressor (decompressor * decompressor)
+{
+  switch (decompressor->compression)
+    {
+#ifdef BZIP2
+    case BZIP2_COMPRESSION:
+      BZ2_bzDecompressEnd (&decompressor->u.bzip2);
+      break;
+#endif
+#ifdef ZLIB
+    case GZIP_COMPRESSION:
+      inflateEnd (&decompressor->u.gzip);
+      break;
+#endif
+#ifdef LZMA
+    case LZMA_COMPRESSION:
+    case XZ_COMPRESSION:
+      lzma_end (&decompressor->u.lzma);
+      break;
+#endif
+#ifdef ZSTD
+    case ZSTD_COMPRESSION:
+      ZSTD_freeDStream (decompressor->u.zstd.stream);
+      break;
+#endif
+    default:
+      break;
+    }
+  kissat_free (0, decompressor->input, INPUT_BUFFER_SIZE);
+  kissat_free (0, decompressor, sizeof *decompressor);
+}
@@ -0,0 +1,31 @@
+#ifndef _decompress_h_INCLUDED
+#define _decompress_h_INCLUDED
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+// In-process streaming decompression of compressed input files for the
+// formats for which 'configure' found a library.  Otherwise, and for
+// unsupported formats, 'kissat_new_decompressor' returns zero and files
+// are decompressed through a pipe from an external tool instead.
+
+enum compression
+{
+  BZIP2_COMPRESSION,
+  GZIP_COMPRESSION,
+  LZMA_COMPRESSION,
+  XZ_COMPRESSION,
+  ZSTD_COMPRESSION,
+};
+
+typedef enum compression compression;
+typedef struct decompressor decompressor;
+
+bool kissat_decompressing (compression);
+
+decompressor *kissat_new_decompressor (compression, FILE *, const char *);
+size_t kissat_decompress (decompressor *, unsigned char *, size_t);
+void kissat_delete_decompressor (decompressor *);
+
+#endif
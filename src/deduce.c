@@ -67,7 +67,7 @@ kissat_deduce_first_uip_clause (kissat * solver, clause * conflict)
 #if defined(LOGGING) || !defined(NDEBUG)
   CLEAR_STACK (solver->resolvent_lits);
 #endif
-  if (conflict->size > 2)
+  if (CLAUSE_SIZE (conflict) > 2)
     mark_clause_as_used (solver, conflict);
   PUSH_STACK (solver->clause.lits, INVALID_LIT);
   solver->antecedent_size = 0;
@@ -88,7 +88,7 @@ kissat_deduce_first_uip_clause (kissat * solver, clause * conflict)
        unresolved_on_current_level);
   assert (solver->antecedent_size == solver->resolvent_size);
   LOGRES2 ("initial");
-  const bool otfs = GET_OPTION (otfs);
+  const bool otfs = GET_OPTION (otfs) && !LRAT_PROOF;
   const unsigned *t = END_STACK (solver->trail);
   unsigned uip = INVALID_LIT, resolved = 0;
   assigned *a = 0;
@@ -103,20 +103,20 @@ kissat_deduce_first_uip_clause (kissat * solver, clause * conflict)
       while (!a->analyzed || a->level != solver->level);
       if (unresolved_on_current_level == 1)
         break;
-      assert (a->reason != DECISION);
+      assert (ASSIGNED_REASON (a) != DECISION);
       assert (a->level == solver->level);
       solver->antecedent_size = 1;
       resolved++;
       if (a->binary)
         {
-          const unsigned other = a->reason;
+          const unsigned other = ASSIGNED_REASON (a);
           LOGBINARY (uip, other, "resolving %s reason", LOGLIT (uip));
           if (analyze_literal (solver, all_assigned, frames, other))
             unresolved_on_current_level++;
         }
       else
         {
-          const reference ref = a->reason;
+          const reference ref = ASSIGNED_REASON (a);
           LOGREF (ref, "resolving %s reason", LOGLIT (uip));
           clause *reason = kissat_dereference_clause (solver, ref);
           for (all_literals_in_clause (lit, reason))
@@ -144,8 +144,13 @@ kissat_deduce_first_uip_clause (kissat * solver, clause * conflict)
         {
           assert (!a->binary);
           assert (solver->antecedent_size && solver->resolvent_size + 1);
-          clause *reason = kissat_dereference_clause (solver, a->reason);
+          const reference ref = ASSIGNED_REASON (a);
+          clause *reason = kissat_dereference_clause (solver, ref);
           assert (!reason->garbage);
+#ifdef PACKED_CLAUSES
+          if (reason->packed)
+            continue;
+#endif
           clause *res = kissat_on_the_fly_strengthen (solver, reason, uip);
           if (resolved == 1 && solver->resolvent_size < conflict_size)
             {
@@ -78,10 +78,16 @@ flush_large_watches (kissat * solver,
 	    }
 	  else
 	    {
+	      p += WATCH_SIZE (watch) - 1;
+	      while (p != end_watches)
+		{
+		  assert (!p->type.binary);
+		  p += WATCH_SIZE (*p);
+		  flushed++;
+		}
 	      flushed++;
-	      p++;
+	      break;
 	    }
-
 	}
       SET_END_OF_WATCHES (*watches, q);
     }
@@ -252,18 +258,13 @@ resume_watching_large_clauses_after_elimination (kissat * solver)
 	  continue;
 	}
 
-      assert (c->size > 2);
+      assert (CLAUSE_SIZE (c) > 2);
 
-      unsigned *lits = c->lits;
-      kissat_sort_literals (solver, values, assigned, c->size, lits);
-      c->searched = 2;
+      kissat_sort_clause (solver, values, assigned, c);
+      kissat_reset_searched (c);
 
       const reference ref = (word *) c - arena;
-      const unsigned l0 = lits[0];
-      const unsigned l1 = lits[1];
-
-      kissat_push_blocking_watch (solver, watches + l0, l1, ref);
-      kissat_push_blocking_watch (solver, watches + l1, l0, ref);
+      kissat_inlined_watch_clause (solver, watches, c, ref);
 
 #ifdef LOGGING
       if (c->redundant)
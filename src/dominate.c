@@ -50,17 +50,17 @@ kissat_find_dominator (kissat * solver, unsigned lit, clause * c)
   for (;;)
     {
       assert (a == ASSIGNED (root));
-      if (a->reason == DECISION)
+      if (ASSIGNED_REASON (a) == DECISION)
 	break;
       unsigned prev = INVALID_LIT;
       if (a->binary)
 	{
-	  prev = a->reason;
+	  prev = ASSIGNED_REASON (a);
 	  LOGBINARY (root, prev, "following %s reason", LOGLIT (root));
 	}
       else
 	{
-	  const reference ref = a->reason;
+	  const reference ref = ASSIGNED_REASON (a);
 	  LOGREF (ref, "following %s reason", LOGLIT (root));
 	  clause *reason = (clause *) (arena + ref);
 	  assert (kissat_clause_in_arena (solver, reason));
@@ -113,17 +113,17 @@ kissat_find_dominator (kissat * solver, unsigned lit, clause * c)
       while (!a->analyzed)
 	{
 	  assert (a == ASSIGNED (dom));
-	  if (a->reason == DECISION)
+	  if (ASSIGNED_REASON (a) == DECISION)
 	    break;
 	  unsigned prev = INVALID_LIT;
 	  if (a->binary)
 	    {
-	      prev = a->reason;
+	      prev = ASSIGNED_REASON (a);
 	      LOGBINARY (root, prev, "following %s reason", LOGLIT (root));
 	    }
 	  else
 	    {
-	      const reference ref = a->reason;
+	      const reference ref = ASSIGNED_REASON (a);
 	      LOGREF (ref, "following %s reason", LOGLIT (root));
 	      clause *reason = kissat_dereference_clause (solver, ref);
 	      for (all_literals_in_clause (other, reason))
@@ -37,7 +37,7 @@ dump_clause (kissat * solver, clause * c)
   const reference ref = kissat_reference_clause (solver, c);
   if (c->garbage)
     printf (" garbage");
-  printf (" clause[%u]", ref);
+  printf (" clause[%" REFERENCE_FORMAT "]", ref);
   for (all_literals_in_clause (lit, c))
     {
       fputc (' ', stdout);
@@ -85,22 +85,22 @@ dump_trail (kissat * solver)
 	    {
 	      printf (" UNIT\n");
 	      assert (!a->binary);
-	      assert (a->reason == UNIT);
+	      assert (ASSIGNED_REASON (a) == UNIT);
 	    }
 	  else
 	    {
 	      fputc (' ', stdout);
 	      if (a->binary)
 		{
-		  const unsigned other = a->reason;
+		  const unsigned other = ASSIGNED_REASON (a);
 		  dump_binary (solver, lit, other);
 		}
-	      else if (a->reason == DECISION)
+	      else if (ASSIGNED_REASON (a) == DECISION)
 		printf ("DECISION\n");
 	      else
 		{
-		  assert (a->reason != UNIT);
-		  const reference ref = a->reason;
+		  assert (ASSIGNED_REASON (a) != UNIT);
+		  const reference ref = ASSIGNED_REASON (a);
 		  dump_ref (solver, ref);
 		}
 	    }
@@ -190,7 +190,8 @@ kissat_flush_units_while_connected (kissat * solver)
 	    }
 	  else
 	    {
-	      const reference ref = watch.large.ref;
+	      const reference ref = kissat_large_watch_reference (p - 1);
+	      p += LARGE_WATCH_SIZE - 1;
 	      clause *c = kissat_dereference_clause (solver, ref);
 	      if (!c->garbage)
 		kissat_eliminate_clause (solver, c, unit);
@@ -298,7 +299,7 @@ weaken_clauses (kissat * solver, unsigned lit)
 	}
       else
 	{
-	  const reference ref = watch.large.ref;
+	  const reference ref = LARGE_WATCH_REF (watch);
 	  clause *c = kissat_dereference_clause (solver, ref);
 	  if (c->garbage)
 	    continue;
@@ -335,7 +336,7 @@ weaken_clauses (kissat * solver, unsigned lit)
 	}
       else
 	{
-	  const reference ref = watch.large.ref;
+	  const reference ref = LARGE_WATCH_REF (watch);
 	  clause *d = kissat_dereference_clause (solver, ref);
 	  if (d->garbage)
 	    continue;
@@ -423,6 +424,8 @@ can_eliminate_variable (kissat * solver, unsigned idx)
     return false;
   if (!flags->eliminate)
     return false;
+  if (flags->assumed)
+    return false;
 
   LOG ("next variable elimination candidate %u", idx);
 
@@ -508,7 +511,7 @@ eliminate_variables (kissat * solver)
 	{
 	  if (solver->statistics.resolutions > resolution_limit)
 	    break;
-	  if (TERMINATED (5))
+	  if (INTERRUPTED (5))
 	    break;
 	  unsigned idx = kissat_max_heap (&solver->schedule);
 	  kissat_pop_heap (solver, &solver->schedule, idx);
@@ -530,7 +533,7 @@ eliminate_variables (kissat * solver)
 	break;
       if (solver->statistics.resolutions > resolution_limit)
 	break;
-      if (TERMINATED (6))
+      if (INTERRUPTED (6))
 	break;
     }
   kissat_phase (solver, "eliminate", GET (eliminations),
@@ -1,5 +1,8 @@
+#include "allocate.h"
 #include "colors.h"
+#include "import.h"
 #include "inline.h"
+#include "print.h"
 
 static void
 undo_eliminated_assignment (kissat * solver)
@@ -199,3 +202,88 @@ kissat_extend (kissat * solver)
 
   STOP (extend);
 }
+
+static void
+unexport_revived_variables (kissat * solver)
+{
+  const import *imports = BEGIN_STACK (solver->import);
+  int *exports = BEGIN_STACK (solver->export);
+  for (all_variables (idx))
+    {
+      if (!ELIMINATED (idx))
+	continue;
+      const int elit = exports[idx];
+      if (!elit)
+	continue;
+      const unsigned eidx = ABS (elit);
+      if (imports[eidx].eliminated)
+	continue;
+      LOG ("internal variable %u of revived external variable %u "
+	   "not exported anymore", idx, eidx);
+      exports[idx] = 0;
+    }
+}
+
+void
+kissat_restore_clauses (kissat * solver)
+{
+  if (EMPTY_STACK (solver->revived))
+    return;
+
+  const size_t size = SIZE_STACK (solver->import);
+  bool *revived = kissat_calloc (solver, size, sizeof *revived);
+  size_t marked = 0, restored = 0;
+
+  while (marked < SIZE_STACK (solver->revived))
+    {
+      LOG ("restoring clauses of %zu revived variables",
+	   SIZE_STACK (solver->revived) - marked);
+      while (marked < SIZE_STACK (solver->revived))
+	{
+	  const unsigned eidx = PEEK_STACK (solver->revived, marked);
+	  assert (eidx < size);
+	  revived[eidx] = true;
+	  marked++;
+	}
+
+      extension *begin = BEGIN_STACK (solver->extend);
+      const extension *end = END_STACK (solver->extend);
+      const extension *p = begin;
+      extension *q = begin;
+
+      while (p != end)
+	{
+	  const extension *c = p++;
+	  assert (c->blocking);
+	  while (p != end && !p->blocking)
+	    p++;
+	  if (revived[ABS (c->lit)])
+	    {
+	      LOGEXT (p - c, c, "restoring");
+	      while (c != p)
+		kissat_add (solver, (c++)->lit);
+	      kissat_add (solver, 0);
+	      restored++;
+	    }
+	  else
+	    while (c != p)
+	      *q++ = *c++;
+	}
+      SET_END_OF_STACK (solver->extend, q);
+    }
+
+  kissat_dealloc (solver, revived, size, sizeof *revived);
+  unexport_revived_variables (solver);
+
+  for (all_stack (unsigned, eidx, solver->revived))
+    {
+      const unsigned ilit = kissat_import_literal (solver, eidx);
+      const flags *flags = FLAGS (IDX (ilit));
+      if (!flags->active && !flags->fixed)
+	kissat_activate_literal (solver, ilit);
+    }
+
+  kissat_very_verbose (solver, "restored %zu clauses of %zu "
+		       "revived variables", restored, marked);
+  CLEAR_STACK (solver->revived);
+}
@@ -29,5 +29,6 @@ kissat_extension (bool blocking, int lit)
 struct kissat;
 
 void kissat_extend (struct kissat *solver);
+void kissat_restore_clauses (struct kissat *solver);
 
 #endif
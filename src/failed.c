@@ -292,7 +292,7 @@ probe_round (kissat * solver, unsigned round,
 	}
 
       bool terminate;
-      if (TERMINATED (7))
+      if (INTERRUPTED (7))
 	{
 	  LOG ("terminating");
 	  terminate = true;
@@ -399,7 +399,7 @@ kissat_failed_literal_probing (kissat * solver)
   assert (solver->probing);
   assert (solver->watching);
 
-  if (TERMINATED (8))
+  if (INTERRUPTED (8))
     return;
   if (!GET_OPTION (failed))
     return;
@@ -1,3 +1,5 @@
+#include "allocate.h"
+#include "decompress.h"
 #include "file.h"
 #include "utilities.h"
 
@@ -8,6 +10,12 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#ifdef _POSIX_C_SOURCE
+#include <sys/mman.h>
+#endif
+
+#define FILE_BUFFER_SIZE (1u<<20)
+
 bool
 kissat_file_readable (const char *path)
 {
@@ -134,13 +142,11 @@ kissat_find_executable (const char *name)
   return res;
 }
 
-#ifdef _POSIX_C_SOURCE
-
 static int bz2sig[] = { 0x42, 0x5A, 0x68, EOF };
 static int gzsig[] = { 0x1F, 0x8B, EOF };
 static int lzmasig[] = { 0x5D, 0x00, 0x00, 0x80, 0x00, EOF };
-static int sig7z[] = { 0x37, 0x7A, 0xBC, 0xAF, 0x27, 0x1C, EOF };
 static int xzsig[] = { 0xFD, 0x37, 0x7A, 0x58, 0x5A, 0x00, 0x00, EOF };
+static int zstdsig[] = { 0x28, 0xB5, 0x2F, 0xFD, EOF };
 
 static bool
 match_signature (const char *path, const int *sig)
@@ -156,6 +162,10 @@ match_signature (const char *path, const int *sig)
   return res;
 }
 
+#ifdef _POSIX_C_SOURCE
+
+static int sig7z[] = { 0x37, 0x7A, 0xBC, 0xAF, 0x27, 0x1C, EOF };
+
 static FILE *
 open_pipe (const char *fmt, const char *path, const char *mode)
 {
@@ -198,6 +208,260 @@ write_pipe (const char *fmt, const char *path)
 
 #endif
 
+static void
+no_buffer (file * file)
+{
+  file->mapped = false;
+  file->buffer = 0;
+  file->pos = file->end = 0;
+  file->decompressor = 0;
+#ifdef THREADS
+  file->reader = 0;
+#endif
+}
+
+// Regular files are mapped into memory as a whole.  Everything else,
+// that is pipes, terminals and decompressed input, is read in large
+// chunks into a buffer.  In both cases 'kissat_getc' only needs to
+// check the buffer bounds on the fast path.
+
+static void
+map_file (file * file)
+{
+  no_buffer (file);
+#ifdef _POSIX_C_SOURCE
+  const int fd = fileno (file->file);
+  struct stat buf;
+  if (fd < 0 || fstat (fd, &buf))
+    return;
+  if (!S_ISREG (buf.st_mode) || buf.st_size <= 0)
+    return;
+  if (lseek (fd, 0, SEEK_CUR))
+    return;
+  const size_t size = buf.st_size;
+  void *start = mmap (0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (start == MAP_FAILED)
+    return;
+#if _POSIX_C_SOURCE >= 200112L
+  (void) posix_madvise (start, size, POSIX_MADV_SEQUENTIAL);
+#endif
+  file->mapped = true;
+  file->buffer = start;
+  file->pos = file->buffer;
+  file->end = file->buffer + size;
+  file->bytes = size;
+#endif
+}
+
+static size_t
+read_buffer (file * file, unsigned char *buffer)
+{
+  size_t bytes;
+  if (file->decompressor)
+    bytes = kissat_decompress (file->decompressor,
+			       buffer, FILE_BUFFER_SIZE);
+  else
+    {
+#ifdef _POSIX_C_SOURCE
+      ssize_t res;
+      do
+	res = read (fileno (file->file), buffer, FILE_BUFFER_SIZE);
+      while (res < 0 && errno == EINTR);
+      bytes = res < 0 ? 0 : res;
+#else
+      bytes = fread (buffer, 1, FILE_BUFFER_SIZE, file->file);
+#endif
+    }
+  return bytes;
+}
+
+#ifdef THREADS
+
+#include <pthread.h>
+
+// Compressed input is read and decompressed ahead by a background thread
+// into a small ring of buffers, while the parser consumes the previously
+// filled ones.  Thus decompression and parsing overlap and the parser only
+// waits if decompressing is the slower of the two.
+
+#define READ_AHEAD_BUFFERS 4
+
+typedef struct reader reader;
+
+struct reader
+{
+  unsigned head;
+  unsigned tail;
+  unsigned filled;
+  bool holding;
+  bool eof;
+  bool stop;
+  unsigned char *buffers[READ_AHEAD_BUFFERS];
+  size_t sizes[READ_AHEAD_BUFFERS];
+  pthread_t thread;
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+};
+
+static void *
+read_buffers (void *ptr)
+{
+  file *file = ptr;
+  reader *reader = file->reader;
+  pthread_mutex_lock (&reader->lock);
+  for (;;)
+    {
+      while (reader->filled == READ_AHEAD_BUFFERS && !reader->stop)
+	pthread_cond_wait (&reader->cond, &reader->lock);
+      if (reader->stop)
+	break;
+      const unsigned tail = reader->tail;
+      pthread_mutex_unlock (&reader->lock);
+      const size_t bytes = read_buffer (file, reader->buffers[tail]);
+      pthread_mutex_lock (&reader->lock);
+      if (!bytes)
+	{
+	  reader->eof = true;
+	  pthread_cond_broadcast (&reader->cond);
+	  break;
+	}
+      reader->sizes[tail] = bytes;
+      reader->tail = (tail + 1) % READ_AHEAD_BUFFERS;
+      reader->filled++;
+      pthread_cond_broadcast (&reader->cond);
+    }
+  pthread_mutex_unlock (&reader->lock);
+  return 0;
+}
+
+static bool
+fill_ahead_buffer (file * file)
+{
+  reader *reader = file->reader;
+  pthread_mutex_lock (&reader->lock);
+  if (reader->holding)
+    {
+      reader->head = (reader->head + 1) % READ_AHEAD_BUFFERS;
+      reader->filled--;
+      reader->holding = false;
+      pthread_cond_broadcast (&reader->cond);
+    }
+  while (!reader->filled && !reader->eof)
+    pthread_cond_wait (&reader->cond, &reader->lock);
+  const bool res = reader->filled;
+  if (res)
+    {
+      const unsigned head = reader->head;
+      const size_t bytes = reader->sizes[head];
+      reader->holding = true;
+      file->buffer = reader->buffers[head];
+      file->pos = file->buffer;
+      file->end = file->buffer + bytes;
+      file->bytes += bytes;
+    }
+  pthread_mutex_unlock (&reader->lock);
+  return res;
+}
+
+static void
+free_reader (reader * reader)
+{
+  for (unsigned i = 0; i < READ_AHEAD_BUFFERS; i++)
+    kissat_free (0, reader->buffers[i], FILE_BUFFER_SIZE);
+  kissat_free (0, reader, sizeof *reader);
+}
+
+void
+kissat_read_ahead (file * file)
+{
+  assert (file->reading);
+  assert (!file->reader);
+  if (!file->compressed || file->buffer)
+    return;
+  reader *reader = kissat_calloc (0, 1, sizeof *reader);
+  for (unsigned i = 0; i < READ_AHEAD_BUFFERS; i++)
+    reader->buffers[i] = kissat_malloc (0, FILE_BUFFER_SIZE);
+  pthread_mutex_init (&reader->lock, 0);
+  pthread_cond_init (&reader->cond, 0);
+  file->reader = reader;
+  if (pthread_create (&reader->thread, 0, read_buffers, file))
+    {
+      file->reader = 0;
+      pthread_cond_destroy (&reader->cond);
+      pthread_mutex_destroy (&reader->lock);
+      free_reader (reader);
+    }
+}
+
+static void
+stop_reader (file * file)
+{
+  reader *reader = file->reader;
+  pthread_mutex_lock (&reader->lock);
+  reader->stop = true;
+  pthread_cond_broadcast (&reader->cond);
+  pthread_mutex_unlock (&reader->lock);
+  pthread_join (reader->thread, 0);
+  pthread_cond_destroy (&reader->cond);
+  pthread_mutex_destroy (&reader->lock);
+  free_reader (reader);
+  file->reader = 0;
+  file->buffer = 0;
+}
+
+#endif
+
+bool
+kissat_fill_buffer (file * file)
+{
+  assert (file->reading);
+  assert (file->pos == file->end);
+  if (file->mapped)
+    return false;
+#ifdef THREADS
+  if (file->reader)
+    return fill_ahead_buffer (file);
+#endif
+  if (!file->buffer)
+    file->buffer = kissat_malloc (0, FILE_BUFFER_SIZE);
+  const size_t bytes = read_buffer (file, file->buffer);
+  if (!bytes)
+    return false;
+  file->pos = file->buffer;
+  file->end = file->buffer + bytes;
+  file->bytes += bytes;
+  return true;
+}
+
+size_t
+kissat_read (file * file, void *ptr, size_t bytes)
+{
+  assert (file->reading);
+  unsigned char *p = ptr;
+  size_t res = 0;
+  while (res < bytes)
+    {
+      if (file->pos == file->end && !kissat_fill_buffer (file))
+	break;
+      size_t chunk = file->end - file->pos;
+      if (chunk > bytes - res)
+	chunk = bytes - res;
+      memcpy (p + res, file->pos, chunk);
+      file->pos += chunk;
+      res += chunk;
+    }
+  return res;
+}
+
+size_t
+kissat_write (file * file, const void *ptr, size_t bytes)
+{
+  assert (!file->reading);
+  const size_t res = fwrite (ptr, 1, bytes, file->file);
+  file->bytes += res;
+  return res;
+}
+
 void
 kissat_read_already_open_file (file * file, FILE * f, const char *path)
 {
@@ -207,6 +471,7 @@ kissat_read_already_open_file (file * file, FILE * f, const char *path)
   file->compressed = false;
   file->path = path;
   file->bytes = 0;
+  map_file (file);
 }
 
 void
@@ -218,11 +483,54 @@ kissat_write_already_open_file (file * file, FILE * f, const char *path)
   file->compressed = false;
   file->path = path;
   file->bytes = 0;
+  no_buffer (file);
+}
+
+static bool
+read_decompressed (file * file, compression compression,
+                   const int *sig, const char *path)
+{
+  if (!kissat_decompressing (compression))
+    return false;
+  if (!kissat_file_readable (path))
+    return false;
+  if (!match_signature (path, sig))
+    return false;
+  FILE *f = fopen (path, "r");
+  if (!f)
+    return false;
+  decompressor *decompressor =
+    kissat_new_decompressor (compression, f, path);
+  if (!decompressor)
+    {
+      fclose (f);
+      return false;
+    }
+  file->file = f;
+  file->close = true;
+  file->reading = true;
+  file->compressed = true;
+  file->path = path;
+  file->bytes = 0;
+  no_buffer (file);
+  file->decompressor = decompressor;
+  return true;
 }
 
 bool
 kissat_open_to_read_file (file * file, const char *path)
 {
+#define READ_DECOMPRESSED(SUFFIX, COMPRESSION, SIG) \
+do { \
+  if (kissat_has_suffix (path, SUFFIX) && \
+      read_decompressed (file, COMPRESSION, SIG, path)) \
+    return true; \
+} while (0)
+  READ_DECOMPRESSED (".bz2", BZIP2_COMPRESSION, bz2sig);
+  READ_DECOMPRESSED (".gz", GZIP_COMPRESSION, gzsig);
+  READ_DECOMPRESSED (".lzma", LZMA_COMPRESSION, lzmasig);
+  READ_DECOMPRESSED (".xz", XZ_COMPRESSION, xzsig);
+  READ_DECOMPRESSED (".zst", ZSTD_COMPRESSION, zstdsig);
 #ifdef _POSIX_C_SOURCE
 #define READ_PIPE(SUFFIX, CMD, SIG) \
 do { \
@@ -236,6 +544,7 @@ do { \
       file->compressed = true; \
       file->path = path; \
       file->bytes = 0; \
+      no_buffer (file); \
       return true; \
     } \
 } while (0)
@@ -244,6 +553,7 @@ do { \
   READ_PIPE (".lzma", "lzma -c -d %s", lzmasig);
   READ_PIPE (".7z", "7z x -so %s 2>/dev/null", sig7z);
   READ_PIPE (".xz", "xz -c -d %s", xzsig);
+  READ_PIPE (".zst", "zstd -q -c -d %s", zstdsig);
 #endif
   file->file = fopen (path, "r");
   if (!file->file)
@@ -253,7 +563,7 @@ do { \
   file->compressed = false;
   file->path = path;
   file->bytes = 0;
-
+  map_file (file);
   return true;
 }
 
@@ -275,6 +585,7 @@ do { \
       file->compressed = true; \
       file->path = path; \
       file->bytes = 0; \
+      no_buffer (file); \
       return true; \
     } \
 } while (0)
@@ -292,6 +603,7 @@ do { \
   file->compressed = false;
   file->path = path;
   file->bytes = 0;
+  no_buffer (file);
   return true;
 }
 
@@ -300,13 +612,29 @@ kissat_close_file (file * file)
 {
   assert (file);
   assert (file->file);
+#ifdef THREADS
+  if (file->reader)
+    stop_reader (file);
+#endif
+  const bool piped = file->compressed && !file->decompressor;
+  if (file->decompressor)
+    kissat_delete_decompressor (file->decompressor);
+  if (file->mapped)
+    {
+#ifdef _POSIX_C_SOURCE
+      munmap (file->buffer, file->end - file->buffer);
+#endif
+    }
+  else if (file->buffer)
+    kissat_free (0, file->buffer, FILE_BUFFER_SIZE);
+  no_buffer (file);
 #ifdef _POSIX_C_SOURCE
-  if (file->close && file->compressed)
+  if (file->close && piped)
     pclose (file->file);
 #else
-  assert (!file->compressed);
+  assert (!piped);
 #endif
-  if (file->close && !file->compressed)
+  if (file->close && !piped)
     fclose (file->file);
   file->file = 0;
 }
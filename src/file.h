@@ -21,14 +21,29 @@ struct file
   bool compressed;
   const char *path;
   uint64_t bytes;
+  bool mapped;
+  unsigned char *buffer;
+  const unsigned char *pos;
+  const unsigned char *end;
+  struct decompressor *decompressor;
+#ifdef THREADS
+  struct reader *reader;
+#endif
 };
 
 void kissat_read_already_open_file (file *, FILE *, const char *path);
 void kissat_write_already_open_file (file *, FILE *, const char *path);
 
 bool kissat_open_to_read_file (file *, const char *path);
+bool kissat_fill_buffer (file *);
+#ifdef THREADS
+void kissat_read_ahead (file *);
+#endif
 bool kissat_open_to_write_file (file *, const char *path);
 
+size_t kissat_read (file *, void *, size_t);
+size_t kissat_write (file *, const void *, size_t);
+
 void kissat_close_file (file *);
 
 static inline int
@@ -37,14 +52,9 @@ kissat_getc (file * file)
   assert (file);
   assert (file->file);
   assert (file->reading);
-#ifdef _POSIX_C_SOURCE
-  int res = getc_unlocked (file->file);
-#else
-  int res = getc (file->file);
-#endif
-  if (res != EOF)
-    file->bytes++;
-  return res;
+  if (file->pos == file->end && !kissat_fill_buffer (file))
+    return EOF;
+  return *file->pos++;
 }
 
 static inline int
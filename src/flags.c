@@ -81,10 +81,13 @@ kissat_mark_eliminated_variable (kissat * solver, unsigned idx)
   LOG ("marking internal variable %u as eliminated", idx);
   flags *f = FLAGS (idx);
   assert (f->active);
+  assert (!f->assumed);
   assert (!f->eliminated);
   assert (!f->fixed);
   f->eliminated = true;
   deactivate_variable (solver, f, idx);
+  if (!GET_OPTION (incremental))
+    solver->irreversible = true;
   int elit = kissat_export_literal (solver, lit);
   assert (elit);
   assert (elit != INT_MIN);
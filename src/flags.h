@@ -8,6 +8,7 @@ typedef struct flags flags;
 struct flags
 {
   bool active:1;
+  bool assumed:1;
   bool eliminate:1;
   bool eliminated:1;
   bool fixed:1;
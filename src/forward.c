@@ -147,9 +147,9 @@ find_forward_subsumption_candidates (kissat * solver, references * candidates)
 	continue;
       if (c->garbage)
 	continue;
-      if (c->size > clslim)
+      if (CLAUSE_SIZE (c) > clslim)
 	continue;
-      assert (c->size > 2);
+      assert (CLAUSE_SIZE (c) > 2);
       unsigned subsume = 0;
       for (all_literals_in_clause (lit, c))
 	{
@@ -171,7 +171,7 @@ find_forward_subsumption_candidates (kissat * solver, references * candidates)
 	continue;
       if (c->subsume)
 	left_over_from_last_subsumption_round++;
-      const unsigned ref = kissat_reference_clause (solver, c);
+      const reference ref = kissat_reference_clause (solver, c);
       PUSH_STACK (*candidates, ref);
     }
 
@@ -188,7 +188,7 @@ get_size_of_reference (kissat * solver, const word * arena, reference ref)
   assert (ref < SIZE_STACK (solver->arena));
   const clause *c = (clause *) (arena + ref);
   (void) solver;
-  return c->size;
+  return CLAUSE_SIZE (c);
 }
 
 #define GET_SIZE_OF_REFERENCE(REF) \
@@ -259,12 +259,15 @@ forward_literal (kissat * solver, unsigned lit, bool binaries,
 	}
       else
 	{
-	  const reference ref = watch.large.ref;
+	  const reference ref = kissat_large_watch_reference (p - 1);
+#ifdef HUGE
+	  *q++ = *p++;
+#endif
 	  assert (ref < SIZE_STACK (solver->arena));
 	  clause *d = (clause *) (arena + ref);
 	  if (d->garbage)
 	    {
-	      q--;
+	      q -= LARGE_WATCH_SIZE;
 	      continue;
 	    }
 
@@ -309,7 +312,7 @@ forward_literal (kissat * solver, unsigned lit, bool binaries,
 	  if (d->garbage)
 	    {
 	      assert (!subsume);
-	      q--;
+	      q -= LARGE_WATCH_SIZE;
 	      break;
 	    }
 
@@ -452,9 +455,9 @@ forward_subsumed_clause (kissat * solver, clause * c, bool * removed)
 	  kissat_mark_removed_literal (solver, remove);
 	  if (non_false > 3)
 	    {
-	      unsigned *lits = c->lits;
+	      unsigned *lits = BEGIN_LITS (c);
 	      unsigned new_size = 0;
-	      for (unsigned i = 0; i < c->size; i++)
+	      for (unsigned i = 0; i < CLAUSE_SIZE (c); i++)
 		{
 		  const unsigned lit = lits[i];
 		  if (remove == lit)
@@ -471,10 +474,9 @@ forward_subsumed_clause (kissat * solver, clause * c, bool * removed)
 	      if (!c->shrunken)
 		{
 		  c->shrunken = true;
-		  lits[c->size - 1] = INVALID_LIT;
+		  lits[CLAUSE_SIZE (c) - 1] = INVALID_LIT;
 		}
-	      c->size = new_size;
-	      c->searched = 2;
+	      kissat_shrink_clause_size (c, new_size);
 	      LOGCLS (c, "forward strengthened");
 	    }
 	  else
@@ -593,7 +595,7 @@ forward_subsume_all_clauses (kissat * solver)
       {
 	if (solver->statistics.subsumption_checks > limit)
 	  break;
-	if (TERMINATED (9))
+	if (INTERRUPTED (9))
 	  break;
 	reference ref = *p++;
 	clause *c = (clause *) (arena + ref);
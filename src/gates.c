@@ -85,11 +85,18 @@ get_antecedents (kissat * solver, unsigned lit, unsigned negative)
 
   while (w != end_watches)
     {
-      const watch watch = *w++;
-      if (g != end_gates && g->raw == watch.raw)
-	g++;
+      const watch watch = *w;
+      const unsigned size = DENSE_WATCH_SIZE (watch);
+      bool gate = (g != end_gates && g->raw == watch.raw);
+#ifdef HUGE
+      if (gate && !watch.type.binary)
+	gate = (g[1].raw == w[1].raw);
+#endif
+      if (gate)
+	g += size;
       else
-	PUSH_STACK (*antecedents, watch);
+	PUSH_DENSE_WATCH (*antecedents, w);
+      w += size;
     }
 
   assert (g == end_gates);
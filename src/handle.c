@@ -50,9 +50,18 @@ kissat_reset_signal_handler (void)
 
 // *INDENT-ON*
 
+static void (*volatile checkpoint_handler) (void);
+
 static void
 catch_signal (int sig)
 {
+  if (sig == SIGTERM && checkpoint_handler)
+    {
+      void (*h) (void) = checkpoint_handler;
+      checkpoint_handler = 0;
+      h ();
+      return;
+    }
   if (caught_signal)
     return;
   caught_signal = sig;
@@ -75,6 +84,24 @@ kissat_init_signal_handler (void (*h) (int sig))
 #undef SIGNAL
 }
 
+// The first 'SIGTERM' only calls the checkpoint handler (which should
+// just make the solver terminate) if one is set.  The solver then writes
+// a checkpoint and exits normally.  A second 'SIGTERM' is handled as
+// usual by the signal handler above.
+
+void
+kissat_init_checkpoint_handler (void (*h) (void))
+{
+  assert (h);
+  checkpoint_handler = h;
+}
+
+void
+kissat_reset_checkpoint_handler (void)
+{
+  checkpoint_handler = 0;
+}
+
 static volatile bool caught_alarm;
 static volatile bool alarm_handler_set;
 static void (*SIGALRM_handler) (int);
@@ -4,6 +4,9 @@
 void kissat_init_signal_handler (void (*handler) (int));
 void kissat_reset_signal_handler (void);
 
+void kissat_init_checkpoint_handler (void (*handler) (void));
+void kissat_reset_checkpoint_handler (void);
+
 void kissat_init_alarm (void (*handler) (void));
 void kissat_reset_alarm (void);
 
@@ -7,9 +7,9 @@
 void
 kissat_release_heap (kissat * solver, heap * heap)
 {
-  RELEASE_STACK (heap->stack);
-  DEALLOC (heap->pos, heap->size);
-  DEALLOC (heap->score, heap->size);
+  RELEASE_TAGGED_STACK (MEMORY (heaps), heap->stack);
+  DEALLOC_TAGGED (MEMORY (heaps), heap->pos, heap->size);
+  DEALLOC_TAGGED (MEMORY (heaps), heap->score, heap->size);
   memset (heap, 0, sizeof *heap);
 }
 
@@ -59,18 +59,20 @@ kissat_resize_heap (kissat * solver, heap * heap, unsigned new_size)
   LOG ("resizing %s heap from %u to %u",
        (heap->tainted ? "tainted" : "untainted"), old_size, new_size);
 
-  heap->pos = kissat_nrealloc (solver, heap->pos,
-			       old_size, new_size, sizeof (unsigned));
+  heap->pos = kissat_nrealloc_tagged (solver, MEMORY (heaps), heap->pos,
+				      old_size, new_size, sizeof (unsigned));
   if (heap->tainted)
     {
-      heap->score = kissat_nrealloc (solver, heap->score,
-				     old_size, new_size, sizeof (double));
+      heap->score = kissat_nrealloc_tagged (solver, MEMORY (heaps),
+					    heap->score, old_size, new_size,
+					    sizeof (double));
     }
   else
     {
       if (old_size)
-	DEALLOC (heap->score, old_size);
-      heap->score = kissat_calloc (solver, new_size, sizeof (double));
+	DEALLOC_TAGGED (MEMORY (heaps), heap->score, old_size);
+      heap->score = kissat_calloc_tagged (solver, MEMORY (heaps),
+					  new_size, sizeof (double));
     }
   heap->size = new_size;
 #ifdef CHECK_HEAP
@@ -179,7 +181,7 @@ kissat_push_heap (kissat * solver, heap * heap, unsigned idx)
   assert (!kissat_heap_contains (heap, idx));
   IMPORT (idx);
   heap->pos[idx] = SIZE_STACK (heap->stack);
-  PUSH_STACK (heap->stack, idx);
+  PUSH_TAGGED_STACK (MEMORY (heaps), heap->stack, idx);
   bubble_up (solver, heap, idx);
 }
 
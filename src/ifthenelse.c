@@ -71,12 +71,12 @@ match_ternary_ref (kissat * solver, reference ref,
 }
 
 static bool
-match_ternary_watch (kissat * solver, watch watch,
+match_ternary_watch (kissat * solver, const watch * watch,
 		     unsigned a, unsigned b, unsigned c)
 {
-  if (watch.type.binary)
+  if (watch->type.binary)
     {
-      const unsigned other = watch.binary.lit;
+      const unsigned other = watch->binary.lit;
       if (other != b && other != c)
 	return false;
       solver->resolve_gate = true;
@@ -84,7 +84,7 @@ match_ternary_watch (kissat * solver, watch watch,
     }
   else
     {
-      const reference ref = watch.large.ref;
+      const reference ref = kissat_large_watch_reference (watch);
       return match_ternary_ref (solver, ref, a, b, c);
     }
 }
@@ -96,10 +96,10 @@ find_ternary_clause (kissat * solver, uint64_t * steps,
   watches *watches = &WATCHES (a);
   const watch *begin = BEGIN_WATCHES (*watches);
   const watch *end = END_WATCHES (*watches);
-  for (const watch * p = begin; p != end; p++)
+  for (const watch * p = begin; p != end; p += DENSE_WATCH_SIZE (*p))
     {
       *steps += 1;
-      if (match_ternary_watch (solver, *p, a, b, c))
+      if (match_ternary_watch (solver, p, a, b, c))
 	return p;
     }
   return 0;
@@ -117,34 +117,36 @@ kissat_find_if_then_else_gate (kissat * solver,
   if (begin == end)
     return false;
   uint64_t large_clauses = 0;
-  for (const watch * p = begin; p != end; p++)
+  for (const watch * p = begin; p != end; p += DENSE_WATCH_SIZE (*p))
     if (!p->type.binary)
       large_clauses++;
   const uint64_t limit = solver->bounds.eliminate.occurrences;
   if (large_clauses * large_clauses > limit)
     return false;
-  const watch *last = end - 1;
   uint64_t steps = 0;
-  for (const watch * p1 = begin; steps < limit && p1 != last; p1++)
+  for (const watch * p1 = begin, *next1; steps < limit && p1 != end;
+       p1 = next1)
     {
-      watch w1 = *p1;
-      if (w1.type.binary)
+      next1 = p1 + DENSE_WATCH_SIZE (*p1);
+      if (p1->type.binary)
 	continue;
+      const reference ref1 = kissat_large_watch_reference (p1);
       unsigned a1, b1, c1;
-      if (!get_ternary_clause (solver, p1->large.ref, &a1, &b1, &c1))
+      if (!get_ternary_clause (solver, ref1, &a1, &b1, &c1))
 	continue;
       if (b1 == lit)
 	SWAP (unsigned, a1, b1);
       if (c1 == lit)
 	SWAP (unsigned, a1, c1);
       assert (a1 == lit);
-      for (const watch * p2 = p1 + 1; steps < limit && p2 != end; p2++)
+      for (const watch * p2 = next1; steps < limit && p2 != end;
+	   p2 += DENSE_WATCH_SIZE (*p2))
 	{
-	  watch w2 = *p2;
-	  if (w2.type.binary)
+	  if (p2->type.binary)
 	    continue;
+	  const reference ref2 = kissat_large_watch_reference (p2);
 	  unsigned a2, b2, c2;
-	  if (!get_ternary_clause (solver, p2->large.ref, &a2, &b2, &c2))
+	  if (!get_ternary_clause (solver, ref2, &a2, &b2, &c2))
 	    continue;
 	  if (b2 == lit)
 	    SWAP (unsigned, a2, b2);
@@ -170,20 +172,20 @@ kissat_find_if_then_else_gate (kissat * solver,
 	    find_ternary_clause (solver, &steps, not_lit, b2, not_c2);
 	  if (!p4)
 	    continue;
-	  watch w3 = p3 < p4 ? *p3 : *p4;
-	  watch w4 = p3 < p4 ? *p4 : *p3;
-	  LOGWATCH (lit, w1, "1st if-then-else");
-	  LOGWATCH (lit, w2, "2nd if-then-else");
+	  const watch *w3 = p3 < p4 ? p3 : p4;
+	  const watch *w4 = p3 < p4 ? p4 : p3;
+	  LOGWATCH (lit, p1, "1st if-then-else");
+	  LOGWATCH (lit, p2, "2nd if-then-else");
 	  LOGWATCH (not_lit, w3, "3rd if-then-else");
 	  LOGWATCH (not_lit, w4, "4th if-then-else");
 	  LOG ("found if-then-else gate %s = (%s ? %s : %s)",
 	       LOGLIT (lit), LOGLIT (NOT (b1)),
 	       LOGLIT (not_c1), LOGLIT (not_c2));
 	  solver->gate_eliminated = GATE_ELIMINATED (if_then_else);
-	  PUSH_STACK (solver->gates[negative], w1);
-	  PUSH_STACK (solver->gates[negative], w2);
-	  PUSH_STACK (solver->gates[!negative], w3);
-	  PUSH_STACK (solver->gates[!negative], w4);
+	  PUSH_DENSE_WATCH (solver->gates[negative], p1);
+	  PUSH_DENSE_WATCH (solver->gates[negative], p2);
+	  PUSH_DENSE_WATCH (solver->gates[!negative], w3);
+	  PUSH_DENSE_WATCH (solver->gates[!negative], w4);
 	  return true;
 	}
     }
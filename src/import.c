@@ -1,5 +1,7 @@
+#include "error.h"
 #include "internal.h"
 #include "logging.h"
+#include "require.h"
 #include "resize.h"
 
 static void
@@ -32,6 +34,29 @@ adjust_exports_for_external_literal (kissat * solver, unsigned eidx)
   LOG ("exporting internal variable %u as external literal %u", iidx, eidx);
 }
 
+// An eliminated variable occurring again in a new clause or assumption is
+// imported as a fresh internal variable.  Its clauses saved on the
+// extension stack are added back before the next search (see
+// 'kissat_restore_clauses'), which requires that elimination kept all of
+// them, i.e., was performed with the 'incremental' option enabled.
+
+static void
+revive_eliminated_variable (kissat * solver, unsigned eidx)
+{
+  import *import = &PEEK_STACK (solver->import, eidx);
+  assert (import->imported);
+  assert (import->eliminated);
+  kissat_require (!solver->irreversible,
+                  "can not reuse eliminated variable %u "
+                  "(option 'incremental' disabled during elimination)",
+                  eidx);
+  LOG ("reviving eliminated external variable %u", eidx);
+  import->imported = false;
+  import->eliminated = false;
+  import->lit = 0;
+  PUSH_STACK (solver->revived, eidx);
+}
+
 static unsigned
 import_literal (kissat * solver, int elit)
 {
@@ -39,7 +64,7 @@ import_literal (kissat * solver, int elit)
   adjust_imports_for_external_literal (solver, eidx);
   import *import = &PEEK_STACK (solver->import, eidx);
   if (import->eliminated)
-    return INVALID_LIT;
+    revive_eliminated_variable (solver, eidx);
   unsigned ilit;
   if (!import->imported)
     adjust_exports_for_external_literal (solver, eidx);
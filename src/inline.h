@@ -61,14 +61,23 @@ kissat_push_large_watch (kissat * solver, watches * watches, reference ref)
 {
   const watch watch = kissat_large_watch (ref);
   PUSH_WATCHES (*watches, watch);
+#ifdef HUGE
+  const union watch high = kissat_large_watch_high (ref);
+  PUSH_WATCHES (*watches, high);
+#endif
 }
 
 static inline void
 kissat_push_binary_watch (kissat * solver, watches * watches,
 			  bool redundant, bool hyper, unsigned other)
 {
+  const bool insert = solver->watching && watches->size &&
+    !(LAST_WATCH_POINTER (*watches))->type.binary;
   const watch watch = kissat_binary_watch (other, redundant, hyper);
-  PUSH_WATCHES (*watches, watch);
+  if (insert)
+    kissat_insert_binary_watch (solver, watches, watch);
+  else
+    PUSH_WATCHES (*watches, watch);
 }
 
 static inline void
@@ -78,8 +87,19 @@ kissat_push_blocking_watch (kissat * solver, watches * watches,
   assert (solver->watching);
   const watch head = kissat_blocking_watch (blocking);
   PUSH_WATCHES (*watches, head);
-  const watch tail = kissat_large_watch (ref);
-  PUSH_WATCHES (*watches, tail);
+  kissat_push_large_watch (solver, watches, ref);
+}
+
+static inline void
+kissat_push_ternary_watch (kissat * solver, watches * watches,
+			   unsigned first, unsigned second, reference ref)
+{
+  assert (solver->watching);
+  const watch head = kissat_ternary_watch (first);
+  PUSH_WATCHES (*watches, head);
+  const watch middle = kissat_blocking_watch (second);
+  PUSH_WATCHES (*watches, middle);
+  kissat_push_large_watch (solver, watches, ref);
 }
 
 static inline void
@@ -135,9 +155,13 @@ kissat_disconnect_reference (kissat * solver, unsigned lit, reference ref)
 {
   assert (!solver->watching);
   LOGREF (ref, "disconnecting %s in", LOGLIT (lit));
-  const watch watch = kissat_large_watch (ref);
   watches *watches = &WATCHES (lit);
+#ifdef HUGE
+  kissat_remove_large_watch (solver, watches, ref);
+#else
+  const watch watch = kissat_large_watch (ref);
   REMOVE_WATCHES (*watches, watch);
+#endif
 }
 
 static inline void
@@ -149,6 +173,26 @@ kissat_watch_reference (kissat * solver,
   kissat_watch_blocking (solver, b, a, ref);
 }
 
+static inline void
+kissat_watch_ternary (kissat * solver, const unsigned *lits, reference ref)
+{
+  assert (solver->watching);
+  const unsigned a = lits[0], b = lits[1], c = lits[2];
+  LOGREF (ref, "watching %s, %s and %s in ternary",
+	  LOGLIT (a), LOGLIT (b), LOGLIT (c));
+  watches *all_watches = solver->watches;
+  kissat_push_ternary_watch (solver, all_watches + a, b, c, ref);
+  kissat_push_ternary_watch (solver, all_watches + b, a, c, ref);
+  kissat_push_ternary_watch (solver, all_watches + c, a, b, ref);
+}
+
+static inline void
+kissat_unwatch_ternary (kissat * solver, const unsigned *lits, reference ref)
+{
+  for (unsigned i = 0; i < 3; i++)
+    kissat_unwatch_blocking (solver, lits[i], ref);
+}
+
 static inline void
 kissat_connect_literal (kissat * solver, unsigned lit, reference ref)
 {
@@ -196,12 +240,52 @@ kissat_inlined_connect_clause (kissat * solver, watches * all_watches,
     }
 }
 
+static inline void
+kissat_inlined_watch_clause (kissat * solver, watches * all_watches,
+			     clause * c, reference ref)
+{
+  assert (solver->watching);
+  assert (ref == kissat_reference_clause (solver, c));
+  const unsigned *lits = BEGIN_LITS (c);
+  const unsigned a = lits[0], b = lits[1];
+  if (CLAUSE_SIZE (c) == 3)
+    {
+      const unsigned d = lits[2];
+      kissat_push_ternary_watch (solver, all_watches + a, b, d, ref);
+      kissat_push_ternary_watch (solver, all_watches + b, a, d, ref);
+      kissat_push_ternary_watch (solver, all_watches + d, a, b, ref);
+    }
+  else
+    {
+      kissat_push_blocking_watch (solver, all_watches + a, b, ref);
+      kissat_push_blocking_watch (solver, all_watches + b, a, ref);
+    }
+}
+
 static inline void
 kissat_watch_clause (kissat * solver, clause * c)
 {
-  assert (c->searched < c->size);
+  assert (SHORT_CLAUSE (c) || c->searched < c->size);
+  const reference ref = kissat_reference_clause (solver, c);
+  const unsigned *lits = BEGIN_LITS (c);
+  if (CLAUSE_SIZE (c) == 3)
+    kissat_watch_ternary (solver, lits, ref);
+  else
+    kissat_watch_reference (solver, lits[0], lits[1], ref);
+}
+
+static inline void
+kissat_unwatch_clause (kissat * solver, clause * c)
+{
   const reference ref = kissat_reference_clause (solver, c);
-  kissat_watch_reference (solver, c->lits[0], c->lits[1], ref);
+  const unsigned *lits = BEGIN_LITS (c);
+  if (CLAUSE_SIZE (c) == 3)
+    kissat_unwatch_ternary (solver, lits, ref);
+  else
+    {
+      kissat_unwatch_blocking (solver, lits[0], ref);
+      kissat_unwatch_blocking (solver, lits[1], ref);
+    }
 }
 
 static inline void
@@ -1,4 +1,5 @@
 #include "allocate.h"
+#include "assume.h"
 #include "backtrack.h"
 #include "error.h"
 #include "search.h"
@@ -37,24 +38,28 @@ kissat_init (void)
   solver->scinc = 1.0;
   solver->first_reducible = INVALID_REF;
   solver->last_irredundant = INVALID_REF;
+#ifdef KISSAT_HAS_AVX2
+  solver->avx2 = kissat_avx2_supported ();
+#endif
 #ifndef NDEBUG
   kissat_init_checker (solver);
 #endif
   return solver;
 }
 
-#define DEALLOC_GENERIC(NAME, ELEMENTS_PER_BLOCK) \
+#define DEALLOC_GENERIC(M, NAME, ELEMENTS_PER_BLOCK) \
 do { \
   const size_t block_size = ELEMENTS_PER_BLOCK * sizeof *solver->NAME; \
-  kissat_dealloc (solver, solver->NAME, solver->size, block_size); \
+  kissat_dealloc_tagged (solver, (M), \
+                         solver->NAME, solver->size, block_size); \
   solver->NAME = 0; \
 } while (0)
 
 #define DEALLOC_VARIABLE_INDEXED(NAME) \
-  DEALLOC_GENERIC (NAME, 1)
+  DEALLOC_GENERIC (0, NAME, 1)
 
 #define DEALLOC_LITERAL_INDEXED(NAME) \
-  DEALLOC_GENERIC (NAME, 2)
+  DEALLOC_GENERIC (0, NAME, 2)
 
 #define RELEASE_LITERAL_INDEXED_STACKS(NAME,ACCESS) \
 do { \
@@ -82,21 +87,25 @@ kissat_release (kissat * solver)
   RELEASE_STACK (solver->import);
 
   DEALLOC_VARIABLE_INDEXED (assigned);
+#ifdef SPLIT_ASSIGNED
+  DEALLOC_VARIABLE_INDEXED (reasons);
+#endif
   DEALLOC_VARIABLE_INDEXED (flags);
   DEALLOC_VARIABLE_INDEXED (links);
   DEALLOC_VARIABLE_INDEXED (phases);
 
   DEALLOC_LITERAL_INDEXED (marks);
   DEALLOC_LITERAL_INDEXED (values);
-  DEALLOC_LITERAL_INDEXED (watches);
+  DEALLOC_GENERIC (MEMORY (watches), watches, 2);
 
   RELEASE_STACK (solver->import);
   RELEASE_STACK (solver->eliminated);
-  RELEASE_STACK (solver->extend);
+  RELEASE_TAGGED_STACK (MEMORY (extend), solver->extend);
   RELEASE_STACK (solver->witness);
+  RELEASE_STACK (solver->revived);
   RELEASE_STACK (solver->etrail);
 
-  RELEASE_STACK (solver->vectors.stack);
+  kissat_release_vectors (solver, &solver->vectors);
   RELEASE_STACK (solver->delayed);
 
   RELEASE_STACK (solver->clause.lits);
@@ -104,13 +113,20 @@ kissat_release (kissat * solver)
   RELEASE_STACK (solver->resolvent_lits);
 #endif
 
-  RELEASE_STACK (solver->arena);
+  kissat_release_arena (solver);
+#ifdef PACKED_CLAUSES
+  RELEASE_STACK (solver->packed);
+#endif
 
   RELEASE_STACK (solver->units);
   RELEASE_STACK (solver->frames);
   RELEASE_STACK (solver->sorter);
   RELEASE_STACK (solver->trail);
 
+  RELEASE_STACK (solver->assumptions);
+  RELEASE_STACK (solver->assuming);
+  RELEASE_STACK (solver->failed);
+
   RELEASE_STACK (solver->analyzed);
   RELEASE_STACK (solver->levels);
   RELEASE_STACK (solver->minimize);
@@ -223,6 +239,19 @@ kissat_set_conflict_limit (kissat * solver, unsigned limit)
        limits->conflicts, limit);
 }
 
+void
+kissat_set_memory_limit (kissat * solver, unsigned megabytes)
+{
+  kissat_require_initialized (solver);
+  limits *limits = &solver->limits;
+  limited *limited = &solver->limited;
+  limited->memory = true;
+  limits->memory.bytes = ((uint64_t) megabytes) << 20;
+  limits->memory.forced = 0;
+  LOG ("set memory limit to %" PRIu64 " bytes (%u MB)",
+       limits->memory.bytes, megabytes);
+}
+
 void
 kissat_print_statistics (kissat * solver)
 {
@@ -240,6 +269,10 @@ kissat_print_statistics (kissat * solver)
   kissat_section (solver, "statistics");
   const bool verbose = (complete || verbosity > 0);
   kissat_statistics_print (solver, verbose);
+#ifndef NMETRICS
+  kissat_section (solver, "memory");
+  kissat_print_memories (solver);
+#endif
 #ifndef NPROOFS
   if (solver->proof)
     {
@@ -260,264 +293,399 @@ kissat_print_statistics (kissat * solver)
   (void) solver;
 }
 
-void
-kissat_add (kissat * solver, int elit)
+static inline bool
+saving_original (kissat * solver)
 {
-  kissat_require_initialized (solver);
-  kissat_require (!GET (searches), "incremental solving not supported");
 #if !defined(NDEBUG) || !defined(NPROOFS) || defined(LOGGING)
-  const int checking = kissat_checking (solver);
-  const bool logging = kissat_logging (solver);
-  const bool proving = kissat_proving (solver);
+  return kissat_checking (solver) ||
+    kissat_logging (solver) || kissat_proving (solver);
+#else
+  (void) solver;
+  return false;
 #endif
-  if (elit)
+}
+
+// Adding large formulas is dominated by cache misses on the tables
+// indexed by variables and literals.  The bulk functions thus prefetch
+// in three stages ahead of the literal currently added: the import entry
+// of a distant literal, then the mark, value, flags and watches entries
+// of a closer literal, and finally the end of its watches vector.
+
+#define IMPORT_AHEAD 24
+#define ACCESS_AHEAD 12
+#define WATCHES_AHEAD 4
+
+static inline unsigned
+imported_literal (kissat * solver, int elit)
+{
+  const unsigned eidx = ABS (elit);
+  if (eidx >= SIZE_STACK (solver->import))
+    return INVALID_LIT;
+  const import *import = &PEEK_STACK (solver->import, eidx);
+  if (!import->imported || import->eliminated)
+    return INVALID_LIT;
+  return elit < 0 ? NOT (import->lit) : import->lit;
+}
+
+static inline void
+prefetch_added_literals (kissat * solver, const int *p, const int *end)
+{
+  const size_t remaining = end - p;
+  if (remaining > IMPORT_AHEAD)
+    {
+      const unsigned eidx = ABS (p[IMPORT_AHEAD]);
+      if (eidx < SIZE_STACK (solver->import))
+        __builtin_prefetch (&PEEK_STACK (solver->import, eidx), 0, 1);
+    }
+  if (remaining > ACCESS_AHEAD && p[ACCESS_AHEAD])
+    {
+      const unsigned ilit = imported_literal (solver, p[ACCESS_AHEAD]);
+      if (ilit != INVALID_LIT)
+        {
+          __builtin_prefetch (solver->marks + ilit, 1, 1);
+          __builtin_prefetch (solver->values + ilit, 0, 1);
+          __builtin_prefetch (solver->flags + IDX (ilit), 1, 1);
+          __builtin_prefetch (solver->watches + ilit, 1, 1);
+        }
+    }
+  if (remaining > WATCHES_AHEAD && p[WATCHES_AHEAD])
     {
-      kissat_require_valid_external_internal (elit);
+      const unsigned ilit = imported_literal (solver, p[WATCHES_AHEAD]);
+      if (ilit != INVALID_LIT)
+        {
+          watches *watches = solver->watches + ilit;
+          __builtin_prefetch (kissat_end_vector (&solver->vectors, watches),
+                              1, 1);
+        }
+    }
+}
+
+static inline void
+add_literal (kissat * solver, int elit, bool original)
+{
+  kissat_require_valid_external_internal (elit);
 #if !defined(NDEBUG) || !defined(NPROOFS) || defined(LOGGING)
-      if (checking || logging || proving)
-        PUSH_STACK (solver->original, elit);
+  if (original)
+    PUSH_STACK (solver->original, elit);
+#else
+  (void) original;
 #endif
-      unsigned ilit = kissat_import_literal (solver, elit);
+  unsigned ilit = imported_literal (solver, elit);
+  if (ilit == INVALID_LIT)
+    ilit = kissat_import_literal (solver, elit);
 
-      const mark mark = MARK (ilit);
-      if (!mark)
+  const mark mark = MARK (ilit);
+  if (!mark)
+    {
+      const value value = kissat_fixed (solver, ilit);
+      if (value > 0)
         {
-          const value value = kissat_fixed (solver, ilit);
-          if (value > 0)
+          if (!solver->clause.satisfied)
             {
-              if (!solver->clause.satisfied)
-                {
-                  LOG ("adding root level satisfied literal %u(%d)@0=1",
-                       ilit, elit);
-                  solver->clause.satisfied = true;
-                }
-            }
-          else if (value < 0)
-            {
-              LOG ("adding root level falsified literal %u(%d)@0=-1",
+              LOG ("adding root level satisfied literal %u(%d)@0=1",
                    ilit, elit);
-              if (!solver->clause.shrink)
-                {
-                  solver->clause.shrink = true;
-                  LOG ("thus original clause needs shrinking");
-                }
-            }
-          else
-            {
-              MARK (ilit) = 1;
-              MARK (NOT (ilit)) = -1;
-              assert (SIZE_STACK (solver->clause.lits) < UINT_MAX);
-              PUSH_STACK (solver->clause.lits, ilit);
-            }
-        }
-      else if (mark < 0)
-        {
-          assert (mark < 0);
-          if (!solver->clause.trivial)
-            {
-              LOG ("adding dual literal %u(%d) and %u(%d)",
-                   NOT (ilit), -elit, ilit, elit);
-              solver->clause.trivial = true;
+              solver->clause.satisfied = true;
             }
         }
-      else
+      else if (value < 0)
         {
-          assert (mark > 0);
-          LOG ("adding duplicated literal %u(%d)", ilit, elit);
+          LOG ("adding root level falsified literal %u(%d)@0=-1",
+               ilit, elit);
           if (!solver->clause.shrink)
             {
               solver->clause.shrink = true;
               LOG ("thus original clause needs shrinking");
             }
         }
+      else
+        {
+          MARK (ilit) = 1;
+          MARK (NOT (ilit)) = -1;
+          assert (SIZE_STACK (solver->clause.lits) < UINT_MAX);
+          PUSH_STACK (solver->clause.lits, ilit);
+        }
+    }
+  else if (mark < 0)
+    {
+      assert (mark < 0);
+      if (!solver->clause.trivial)
+        {
+          LOG ("adding dual literal %u(%d) and %u(%d)",
+               NOT (ilit), -elit, ilit, elit);
+          solver->clause.trivial = true;
+        }
     }
   else
     {
+      assert (mark > 0);
+      LOG ("adding duplicated literal %u(%d)", ilit, elit);
+      if (!solver->clause.shrink)
+        {
+          solver->clause.shrink = true;
+          LOG ("thus original clause needs shrinking");
+        }
+    }
+}
+
+static void
+add_clause (kissat * solver)
+{
 #if !defined(NDEBUG) || !defined(NPROOFS) || defined(LOGGING)
-      const size_t offset = solver->offset_of_last_original_clause;
-      size_t esize = SIZE_STACK (solver->original) - offset;
-      int *elits = BEGIN_STACK (solver->original) + offset;
-      assert (esize <= UINT_MAX);
+  const int checking = kissat_checking (solver);
+  const bool logging = kissat_logging (solver);
+  const bool proving = kissat_proving (solver);
 #endif
-      ADD_UNCHECKED_EXTERNAL (esize, elits);
-      const size_t isize = SIZE_STACK (solver->clause.lits);
-      unsigned *ilits = BEGIN_STACK (solver->clause.lits);
-      assert (isize < (unsigned) INT_MAX);
-
-      if (solver->inconsistent)
-        LOG ("inconsistent thus skipping original clause");
-      else if (solver->clause.satisfied)
-        LOG ("skipping satisfied original clause");
-      else if (solver->clause.trivial)
-        LOG ("skipping trivial original clause");
-      else
+#if !defined(NDEBUG) || !defined(NPROOFS) || defined(LOGGING)
+  const size_t offset = solver->offset_of_last_original_clause;
+  size_t esize = SIZE_STACK (solver->original) - offset;
+  int *elits = BEGIN_STACK (solver->original) + offset;
+  assert (esize <= UINT_MAX);
+#endif
+  ADD_UNCHECKED_EXTERNAL (esize, elits);
+  const size_t isize = SIZE_STACK (solver->clause.lits);
+  unsigned *ilits = BEGIN_STACK (solver->clause.lits);
+  assert (isize < (unsigned) INT_MAX);
+#ifdef LRAT
+  if (solver->lrat)
+    kissat_add_original_to_proof (solver, esize, elits);
+#endif
+
+  if (solver->inconsistent)
+    LOG ("inconsistent thus skipping original clause");
+  else if (solver->clause.satisfied)
+    LOG ("skipping satisfied original clause");
+  else if (solver->clause.trivial)
+    LOG ("skipping trivial original clause");
+  else
+    {
+      kissat_activate_literals (solver, isize, ilits);
+
+      if (!isize)
         {
-          kissat_activate_literals (solver, isize, ilits);
+          if (solver->clause.shrink)
+            LOG ("all original clause literals root level falsified");
+          else
+            LOG ("found empty original clause");
 
-          if (!isize)
+          if (!solver->inconsistent)
             {
-              if (solver->clause.shrink)
-                LOG ("all original clause literals root level falsified");
-              else
-                LOG ("found empty original clause");
+              LOG ("thus solver becomes inconsistent");
+              solver->inconsistent = true;
+              CHECK_AND_ADD_EMPTY ();
+              ADD_EMPTY_TO_PROOF ();
+            }
+        }
+      else if (isize == 1)
+        {
+          unsigned unit = TOP_STACK (solver->clause.lits);
+
+          if (solver->clause.shrink)
+            LOGUNARY (unit, "original clause shrinks to");
+          else
+            LOGUNARY (unit, "found original");
+
+          kissat_assign_unit (solver, unit);
 
-              if (!solver->inconsistent)
+          if (!solver->level)
+            {
+              clause *conflict = kissat_search_propagate (solver);
+              if (conflict)
                 {
-                  LOG ("thus solver becomes inconsistent");
+                  LOG ("propagation of root level unit failed");
                   solver->inconsistent = true;
                   CHECK_AND_ADD_EMPTY ();
+                  CHAIN_CONFLICT_IN_PROOF (conflict);
                   ADD_EMPTY_TO_PROOF ();
                 }
             }
-          else if (isize == 1)
-            {
-              unsigned unit = TOP_STACK (solver->clause.lits);
+        }
+      else
+        {
+          reference res = kissat_new_original_clause (solver);
 
-              if (solver->clause.shrink)
-                LOGUNARY (unit, "original clause shrinks to");
-              else
-                LOGUNARY (unit, "found original");
+          const unsigned a = ilits[0];
+          const unsigned b = ilits[1];
 
-              kissat_assign_unit (solver, unit);
+          const value u = VALUE (a);
+          const value v = VALUE (b);
 
-              if (!solver->level)
-                {
-                  clause *conflict = kissat_search_propagate (solver);
-                  if (conflict)
-                    {
-                      LOG ("propagation of root level unit failed");
-                      solver->inconsistent = true;
-                      CHECK_AND_ADD_EMPTY ();
-                      ADD_EMPTY_TO_PROOF ();
-                    }
-                }
+          const unsigned k = u ? LEVEL (a) : UINT_MAX;
+          const unsigned l = v ? LEVEL (b) : UINT_MAX;
+
+          bool assign = false;
+
+          if (!u && v < 0)
+            {
+              LOG ("original clause immediately forcing");
+              assign = true;
+            }
+          else if (u < 0 && k == l)
+            {
+              LOG ("both watches falsified at level @%u", k);
+              assert (v < 0);
+              assert (k > 0);
+              kissat_backtrack (solver, k - 1);
+            }
+          else if (u < 0)
+            {
+              LOG ("watches falsified at levels @%u and @%u", k, l);
+              assert (v < 0);
+              assert (k > l);
+              assert (l > 0);
+              assign = true;
+            }
+          else if (u > 0 && v < 0)
+            {
+              LOG ("first watch satisfied at level @%u "
+                   "second falsified at level @%u", k, l);
+              assert (k <= l);
+            }
+          else if (!u && v > 0)
+            {
+              LOG ("first watch unassigned "
+                   "second falsified at level @%u", l);
+              assign = true;
             }
           else
             {
-              reference res = kissat_new_original_clause (solver);
-
-              const unsigned a = ilits[0];
-              const unsigned b = ilits[1];
-
-              const value u = VALUE (a);
-              const value v = VALUE (b);
-
-              const unsigned k = u ? LEVEL (a) : UINT_MAX;
-              const unsigned l = v ? LEVEL (b) : UINT_MAX;
+              assert (!u);
+              assert (!v);
+            }
 
-              bool assign = false;
+          if (assign)
+            {
+              assert (solver->level > 0);
 
-              if (!u && v < 0)
-                {
-                  LOG ("original clause immediately forcing");
-                  assign = true;
-                }
-              else if (u < 0 && k == l)
-                {
-                  LOG ("both watches falsified at level @%u", k);
-                  assert (v < 0);
-                  assert (k > 0);
-                  kissat_backtrack (solver, k - 1);
-                }
-              else if (u < 0)
+              if (isize == 2)
                 {
-                  LOG ("watches falsified at levels @%u and @%u", k, l);
-                  assert (v < 0);
-                  assert (k > l);
-                  assert (l > 0);
-                  assign = true;
-                }
-              else if (u > 0 && v < 0)
-                {
-                  LOG ("first watch satisfied at level @%u "
-                       "second falsified at level @%u", k, l);
-                  assert (k <= l);
-                }
-              else if (!u && v > 0)
-                {
-                  LOG ("first watch unassigned "
-                       "second falsified at level @%u", l);
-                  assign = true;
+                  assert (res == INVALID_REF);
+                  kissat_assign_binary (solver, false, a, b);
                 }
               else
                 {
-                  assert (!u);
-                  assert (!v);
-                }
-
-              if (assign)
-                {
-                  assert (solver->level > 0);
-
-                  if (isize == 2)
-                    {
-                      assert (res == INVALID_REF);
-                      kissat_assign_binary (solver, false, a, b);
-                    }
-                  else
-                    {
-                      assert (res != INVALID_REF);
-                      clause *c = kissat_dereference_clause (solver, res);
-                      kissat_assign_reference (solver, a, res, c);
-                    }
+                  assert (res != INVALID_REF);
+                  clause *c = kissat_dereference_clause (solver, res);
+                  kissat_assign_reference (solver, a, res, c);
                 }
             }
         }
+    }
 
 #if !defined(NDEBUG) || !defined(NPROOFS)
-      if (solver->clause.satisfied || solver->clause.trivial)
-        {
+  if (solver->clause.satisfied || solver->clause.trivial)
+    {
 #ifndef NDEBUG
-          if (checking > 1)
-            kissat_remove_checker_external (solver, esize, elits);
+      if (checking > 1)
+        kissat_remove_checker_external (solver, esize, elits);
 #endif
 #ifndef NPROOFS
-          if (proving)
-            kissat_delete_external_from_proof (solver, esize, elits);
+      if (proving && !LRAT_PROOF)
+        kissat_delete_external_from_proof (solver, esize, elits);
 #endif
-        }
-      else if (solver->clause.shrink)
-        {
+    }
+  else if (solver->clause.shrink)
+    {
 #ifndef NDEBUG
-          if (checking > 1)
-            {
-              kissat_check_and_add_internal (solver, isize, ilits);
-              kissat_remove_checker_external (solver, esize, elits);
-            }
+      if (checking > 1)
+        {
+          kissat_check_and_add_internal (solver, isize, ilits);
+          kissat_remove_checker_external (solver, esize, elits);
+        }
 #endif
 #ifndef NPROOFS
-          if (proving)
-            {
-              kissat_add_lits_to_proof (solver, isize, ilits);
-              kissat_delete_external_from_proof (solver, esize, elits);
-            }
-#endif
+      if (proving && !LRAT_PROOF)
+        {
+          kissat_add_lits_to_proof (solver, isize, ilits);
+          kissat_delete_external_from_proof (solver, esize, elits);
         }
 #endif
+    }
+#endif
 
 #if !defined(NDEBUG) || !defined(NPROOFS) || defined(LOGGING)
-      if (checking)
-        {
-          LOGINTS (esize, elits, "saved original");
-          PUSH_STACK (solver->original, 0);
-          solver->offset_of_last_original_clause =
-            SIZE_STACK (solver->original);
-        }
-      else if (logging || proving)
-        {
-          LOGINTS (esize, elits, "reset original");
-          CLEAR_STACK (solver->original);
-          solver->offset_of_last_original_clause = 0;
-        }
+  if (checking)
+    {
+      LOGINTS (esize, elits, "saved original");
+      PUSH_STACK (solver->original, 0);
+      solver->offset_of_last_original_clause =
+        SIZE_STACK (solver->original);
+    }
+  else if (logging || proving)
+    {
+      LOGINTS (esize, elits, "reset original");
+      CLEAR_STACK (solver->original);
+      solver->offset_of_last_original_clause = 0;
+    }
 #endif
-      for (all_stack (unsigned, lit, solver->clause.lits))
-          MARK (lit) = MARK (NOT (lit)) = 0;
+  for (all_stack (unsigned, lit, solver->clause.lits))
+      MARK (lit) = MARK (NOT (lit)) = 0;
+
+  CLEAR_STACK (solver->clause.lits);
+
+  solver->clause.satisfied = false;
+  solver->clause.trivial = false;
+  solver->clause.shrink = 0;
+}
+
+// After 'kissat_solve' returned the solver might still be on a non-zero
+// decision level and might have extended the assignment to eliminated
+// variables.  Both are invalidated by adding clauses or assumptions.
+
+static inline void
+leave_search (kissat * solver)
+{
+  if (solver->extended)
+    {
+      LOG ("discarding extended assignment");
+      solver->extended = false;
+    }
+  if (solver->level && !solver->inconsistent)
+    kissat_backtrack_propagate_and_flush_trail (solver);
+}
+
+void
+kissat_add (kissat * solver, int elit)
+{
+  kissat_require_initialized (solver);
+  leave_search (solver);
+  if (elit)
+    add_literal (solver, elit, saving_original (solver));
+  else
+    add_clause (solver);
+}
 
-      CLEAR_STACK (solver->clause.lits);
+void
+kissat_add_clause (kissat * solver, const int *lits, size_t size)
+{
+  kissat_require_initialized (solver);
+  kissat_require (lits || !size, "zero literals pointer");
+  leave_search (solver);
+  const bool original = saving_original (solver);
+  for (const int *p = lits, *end = lits + size; p != end; p++)
+    {
+      const int elit = *p;
+      kissat_require (elit, "zero literal in clause");
+      prefetch_added_literals (solver, p, end);
+      add_literal (solver, elit, original);
+    }
+  add_clause (solver);
+}
 
-      solver->clause.satisfied = false;
-      solver->clause.trivial = false;
-      solver->clause.shrink = 0;
+void
+kissat_add_clauses (kissat * solver, const int *lits, size_t size)
+{
+  kissat_require_initialized (solver);
+  kissat_require (lits || !size, "zero literals pointer");
+  leave_search (solver);
+  const bool original = saving_original (solver);
+  for (const int *p = lits, *end = lits + size; p != end; p++)
+    {
+      const int elit = *p;
+      prefetch_added_literals (solver, p, end);
+      if (elit)
+        add_literal (solver, elit, original);
+      else
+        add_clause (solver);
     }
 }
 
@@ -527,8 +695,34 @@ kissat_solve (kissat * solver)
   kissat_require_initialized (solver);
   kissat_require (EMPTY_STACK (solver->clause.lits),
                   "incomplete clause (terminating zero not added)");
-  kissat_require (!GET (searches), "incremental solving not supported");
-  return kissat_search (solver);
+  leave_search (solver);
+  kissat_restore_clauses (solver);
+  kissat_freeze_assumptions (solver);
+  const int res = kissat_search (solver);
+  kissat_reset_assumptions (solver);
+  return res;
+}
+
+void
+kissat_assume (kissat * solver, int elit)
+{
+  kissat_require_initialized (solver);
+  kissat_require_valid_external_internal (elit);
+  kissat_require (elit, "zero assumption");
+  leave_search (solver);
+  (void) kissat_import_literal (solver, elit);
+  PUSH_STACK (solver->assumptions, elit);
+}
+
+int
+kissat_failed (kissat * solver, int elit)
+{
+  kissat_require_initialized (solver);
+  kissat_require_valid_external_internal (elit);
+  for (all_stack (int, failed, solver->failed))
+    if (failed == elit)
+      return 1;
+  return 0;
 }
 
 void
@@ -1,6 +1,7 @@
 #ifndef _internal_h_INCLUDED
 #define _internal_h_INCLUDED
 
+#include "allocate.h"
 #include "arena.h"
 #include "assign.h"
 #include "averages.h"
@@ -26,6 +27,7 @@
 #include "random.h"
 #include "reluctant.h"
 #include "rephase.h"
+#include "simd.h"
 #include "stack.h"
 #include "statistics.h"
 #include "literal.h"
@@ -72,13 +74,18 @@ typedef STACK (watch *) patches;
 
 struct kissat
 {
+#ifdef KISSAT_HAS_AVX2
+  bool avx2;
+#endif
 #ifdef LOGGING
   bool compacting;
 #endif
   bool extended;
   bool inconsistent;
+  bool irreversible;
   bool iterating;
   bool probing;
+  bool resuming;
 #ifndef QUIET
   bool sectioned;
 #endif
@@ -99,8 +106,12 @@ struct kissat
   imports import;
   extensions extend;
   unsigneds witness;
+  unsigneds revived;
 
   assigned *assigned;
+#ifdef SPLIT_ASSIGNED
+  reference *reasons;
+#endif
   flags *flags;
 
   mark *marks;
@@ -127,6 +138,11 @@ struct kissat
   unsigneds trail;
   unsigned propagated;
 
+  ints assumptions;
+  unsigneds assuming;
+  unsigned assumed;
+  ints failed;
+
   unsigned best_assigned;
   unsigned consistently_assigned;
   unsigned target_assigned;
@@ -156,6 +172,9 @@ struct kissat
   temporary clause;
 
   arena arena;
+#ifdef PACKED_CLAUSES
+  unsigneds packed;
+#endif
   clueue clueue;
   vectors vectors;
   reference first_reducible;
@@ -176,9 +195,16 @@ struct kissat
   waiting waiting;
 
   statistics statistics;
+#ifndef NMETRICS
+  memories memories;
+#endif
   mode mode;
+#ifndef QUIET
+  reordered reordered;
+#endif
 
   uint64_t ticks;
+  uint64_t allocated;
 
   format format;
 
@@ -218,6 +244,9 @@ struct kissat
 
 #ifndef NPROOFS
   proof *proof;
+#ifdef LRAT
+  bool lrat;
+#endif
 #endif
 };
 
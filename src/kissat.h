@@ -1,14 +1,21 @@
 #ifndef _kissat_h_INCLUDED
 #define _kissat_h_INCLUDED
 
+#include <stddef.h>
+
 typedef struct kissat kissat;
 
-// Default (partial) IPASIR interface.
+// Default IPASIR interface.  Clauses and assumptions can be added after
+// 'kissat_solve' returned.  Assumptions only hold for the next call.
+// Reusing variables eliminated during an earlier call requires that the
+// 'incremental' option was set during that call, which is the default.
 
 const char *kissat_signature (void);
 kissat *kissat_init (void);
 void kissat_add (kissat * solver, int lit);
+void kissat_assume (kissat * solver, int lit);
 int kissat_solve (kissat * solver);
+int kissat_failed (kissat * solver, int lit);
 void kissat_terminate (kissat * solver);
 int kissat_value (kissat * solver, int lit);
 void kissat_release (kissat * solver);
@@ -20,6 +27,14 @@ void kissat_set_terminate (kissat * solver,
 
 void kissat_reserve (kissat * solver, int max_var);
 
+// Adding many clauses is faster with these two functions than literal by
+// literal through 'kissat_add'.  The first adds a whole clause of 'size'
+// non-zero literals.  The second takes a flat buffer of literals, where
+// each zero terminates a clause (as if 'kissat_add' was called for each).
+
+void kissat_add_clause (kissat * solver, const int *lits, size_t size);
+void kissat_add_clauses (kissat * solver, const int *lits, size_t size);
+
 const char *kissat_id (void);
 const char *kissat_version (void);
 const char *kissat_compiler (void);
@@ -33,7 +48,18 @@ void kissat_set_configuration (kissat * solver, const char *name);
 
 void kissat_set_conflict_limit (kissat * solver, unsigned);
 void kissat_set_decision_limit (kissat * solver, unsigned);
+void kissat_set_memory_limit (kissat * solver, unsigned megabytes);
 
 void kissat_print_statistics (kissat * solver);
 
+// Save the state of the solver to a file and load it into a new solver
+// instance, which continues the search where the saved one stopped.  The
+// solver is backtracked to the root level before saving.  A checkpoint
+// can only be restored by the same build of the solver which wrote it.
+// The first function returns zero on failure and the second one zero if
+// the file can not be read or is not a valid checkpoint.
+
+int kissat_checkpoint (kissat * solver, const char *path);
+kissat *kissat_restore (const char *path);
+
 #endif
@@ -123,6 +123,8 @@ init_enabled (kissat * solver)
   bool probe;
   if (!GET_OPTION (simplify))
     probe = false;
+  else if (LRAT_PROOF)
+    probe = false;
   else if (!GET_OPTION (probe))
     probe = false;
   else if (GET_OPTION (substitute))
@@ -141,6 +143,8 @@ init_enabled (kissat * solver)
   bool eliminate;
   if (!GET_OPTION (simplify))
     eliminate = false;
+  else if (LRAT_PROOF)
+    eliminate = false;
   else if (!GET_OPTION (eliminate))
     eliminate = false;
   else
@@ -151,6 +155,8 @@ init_enabled (kissat * solver)
   bool autarky;
   if (!GET_OPTION (simplify))
     autarky = false;
+  else if (LRAT_PROOF)
+    autarky = false;
   else if (!GET_OPTION (autarky))
     autarky = false;
   else
@@ -218,7 +224,7 @@ common_limits (kissat * solver)
 void
 kissat_init_limits (kissat * solver)
 {
-  assert (solver->statistics.searches == 1);
+  assert (solver->statistics.searches);
 
   init_enabled (solver);
 
@@ -55,6 +55,12 @@ struct limits
   uint64_t decisions;
   uint64_t reports;
 
+  struct
+  {
+    uint64_t bytes;
+    uint64_t forced;
+  } memory;
+
   union
   {
     uint64_t ticks;
@@ -81,6 +87,7 @@ struct limited
 {
   bool conflicts;
   bool decisions;
+  bool memory;
 };
 
 struct enabled
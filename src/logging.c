@@ -80,6 +80,16 @@ log_lits (kissat * solver, size_t size, const unsigned *lits)
     }
 }
 
+static void
+log_clause_lits (kissat * solver, clause * c)
+{
+  for (all_literals_in_clause (lit, c))
+    {
+      fputc (' ', stdout);
+      fputs (LOGLIT (lit), stdout);
+    }
+}
+
 void
 kissat_log_lits (kissat * solver, size_t size, const unsigned *lits,
 		 const char *fmt, ...)
@@ -169,23 +179,27 @@ log_clause (kissat * solver, clause * c)
     {
       if (c->hyper)
 	{
-	  assert (c->size == 3);
+	  assert (CLAUSE_SIZE (c) == 3);
 	  fputs ("hyper ", stdout);
 	}
       if (c->redundant)
 	printf ("redundant glue %u", c->glue);
       else
 	fputs ("irredundant", stdout);
-      printf (" size %u", c->size);
+      printf (" size %u", CLAUSE_SIZE (c));
       if (c->reason)
 	fputs (" reason", stdout);
       if (c->garbage)
 	fputs (" garbage", stdout);
+#ifdef PACKED_CLAUSES
+      if (c->packed)
+	fputs (" packed", stdout);
+#endif
       fputs (" clause", stdout);
       if (kissat_clause_in_arena (solver, c))
 	{
 	  reference ref = kissat_reference_clause (solver, c);
-	  printf ("[%u]", ref);
+	  printf ("[%" REFERENCE_FORMAT "]", ref);
 	}
     }
 }
@@ -198,7 +212,7 @@ kissat_log_clause (kissat * solver, clause * c, const char *fmt, ...)
   begin_logging (solver, fmt, &ap);
   va_end (ap);
   log_clause (solver, c);
-  log_lits (solver, c->size, c->lits);
+  log_clause_lits (solver, c);
   end_logging ();
 }
 
@@ -236,7 +250,7 @@ log_ref (kissat * solver, reference ref)
 {
   clause *c = kissat_dereference_clause (solver, ref);
   log_clause (solver, c);
-  log_lits (solver, c->size, c->lits);
+  log_clause_lits (solver, c);
 }
 
 void
@@ -252,16 +266,16 @@ kissat_log_ref (kissat * solver, reference ref, const char *fmt, ...)
 
 void
 kissat_log_watch (kissat * solver,
-		  unsigned lit, watch watch, const char *fmt, ...)
+		  unsigned lit, const watch * watch, const char *fmt, ...)
 {
   va_list ap;
   va_start (ap, fmt);
   begin_logging (solver, fmt, &ap);
   va_end (ap);
-  if (watch.type.binary)
-    log_binary (solver, lit, watch.binary.lit);
+  if (watch->type.binary)
+    log_binary (solver, lit, watch->binary.lit);
   else
-    log_ref (solver, watch.large.ref);
+    log_ref (solver, kissat_large_watch_reference (watch));
   end_logging ();
 }
 
@@ -29,7 +29,8 @@ void kissat_log_xor (struct kissat *, unsigned lit,
 void kissat_log_ref (kissat *, reference, const char *, ...);
 void kissat_log_resolvent (kissat *, const char *, ...);
 
-void kissat_log_watch (kissat *, unsigned, watch, const char *, ...);
+void kissat_log_watch (kissat *, unsigned, const watch *,
+		       const char *, ...);
 
 #define LOG(...) \
 do { \
@@ -31,7 +31,7 @@ minimize_binary (kissat * solver, assigned * assigned,
 	  res = true;
 	  break;
 	}
-      if (a->reason == DECISION || a->analyzed == POISONED)
+      if (a->analyzed == POISONED || ASSIGNED_REASON (a) == DECISION)
 	{
 	  res = false;
 	  break;
@@ -40,10 +40,10 @@ minimize_binary (kissat * solver, assigned * assigned,
       if (!a->binary)
 	{
 	  res = minimize_reference (solver, assigned,
-				    a->reason, next, depth + 1);
+				    ASSIGNED_REASON (a), next, depth + 1);
 	  break;
 	}
-      next = a->reason;
+      next = ASSIGNED_REASON (a);
     }
   unsigned *begin = BEGIN_STACK (solver->minimize) + saved;
   const unsigned *end = END_STACK (solver->minimize);
@@ -87,19 +87,20 @@ minimize_literal (kissat * solver, assigned * assigned,
     return true;
   if (a->analyzed == REMOVABLE && depth)
     return true;
-  assert (a->reason != UNIT);
-  if (a->reason == DECISION)
-    return false;
   if (a->analyzed == POISONED)
     return false;
+  assert (ASSIGNED_REASON (a) != UNIT);
+  if (ASSIGNED_REASON (a) == DECISION)
+    return false;
   frame *frame = &FRAME (a->level);
   if (frame->used <= 1)
     return false;
   bool res = true;
   if (a->binary)
-    res = minimize_binary (solver, assigned, a->reason, depth);
+    res = minimize_binary (solver, assigned, ASSIGNED_REASON (a), depth);
   else
-    res = minimize_reference (solver, assigned, a->reason, lit, depth + 1);
+    res = minimize_reference (solver, assigned,
+			      ASSIGNED_REASON (a), lit, depth + 1);
   if (!depth)
     assert (a->analyzed == REMOVABLE);
   else if (res)
@@ -18,6 +18,7 @@ OPTION( compactlim, 10, 0, 100, "compact inactive limit (in percent)") \
 OPTION( decay, 50, 1, 200, "per mille scores decay") \
 OPTION( defraglim, 75, 50, 100, "usable defragmentation limit in percent") \
 OPTION( defragsize, 1<<18, 10, INT_MAX, "size defragmentation limit") \
+OPTION( defragstep, 1<<12, 0, INT_MAX, "vectors moved per defragmentation step (0=at once)") \
 OPTION( delay, 2, 0, 10, "maximum delay (autarky, failed, ...)") \
 OPTION( eagersubsume, 20, 0, 100, "eagerly subsume recently learned clauses") \
 OPTION( eliminate, 1, 0, 1, "bounded variable elimination (BVE)") \
@@ -46,19 +47,24 @@ OPTION( forcephase, 0, 0, 1, "force initial phase") \
 OPTION( forward, 1, 0, 1, "forward subsumption in BVE") \
 OPTION( hyper, 1, 0, 1, "on-the-fly hyper binary resolution") \
 OPTION( ifthenelse, 1, 0, 1, "extract and eliminate if-then-else gates") \
-OPTION( incremental, 0, 0, 1, "enable incremental solving") \
+OPTION( incremental, 1, 0, 1, "keep eliminated clauses (off in application)") \
 LOGOPT( log, 0, 0, 5, "logging level (1=on,2=more,3=check,4/5=mem)") \
+OPTION( memorypressure, 75, 10, 100, "memory limit pressure in percent") \
 OPTION( minimizedepth, 1e3, 1, 1e6, "minimization depth") \
 OPTION( modeinit, 1e3, 10, 1e8, "initial mode change interval") \
 OPTION( modeint, 1e3, 10, 1e8, "base mode change interval") \
 OPTION( otfs, 1, 0, 1, "on-the-fly strengthening") \
+PCKOPT( pack, 1, 0, 1, "bit-pack literals of cold tier-3 clauses") \
+PCKOPT( packsize, 8, 4, INT_MAX, "minimum size of packed clauses") \
 OPTION( phase, 1, 0, 1, "initial decision phase") \
 OPTION( phasesaving, 1, 0, 1, "enable phase saving") \
+OPTION( prefetch, 2, 0, 16, "propagation prefetch lookahead (0=disable)") \
 OPTION( probe, 1, 0, 1, "enable probing") \
 OPTION( probedelay, 0, 0, 1, "delay probing") \
 OPTION( probeinit, 100, 0, INT_MAX, "initial probing interval") \
 OPTION( probeint, 100, 2, INT_MAX, "probing interval") \
 NQTOPT( profile, 2, 0, 4, "profile level") \
+THROPT( proofbuffer, 4, 0, 1024, "asynchronous proof buffer in MB (0=off)") \
 NQTOPT( quiet, 0, 0, 1, "disable all messages") \
 OPTION( really, 1, 0, 1, "delay preprocessing after scheduling") \
 OPTION( reduce, 1, 0, 1, "learned clause reduction") \
@@ -69,6 +75,8 @@ OPTION( reducerestart, 0, 0, 2, "restart at reduce (1=stable,2=always)") \
 OPTION( reluctant, 1, 0, 1, "stable reluctant doubling restarting") \
 OPTION( reluctantint, 1<<10, 2, 1<<15, "reluctant interval") \
 OPTION( reluctantlim, 1<<20, 0, 1<<30, "reluctant limit (0=unlimited)") \
+OPTION( renumber, 0, 0, 1, "renumber variables for locality in compaction") \
+OPTION( reorder, 0, 0, 1, "reorder clauses by watches during collection") \
 OPTION( rephase, 1, 0, 1, "reinitialization of decision phases") \
 OPTION( rephaseinit, 1e3, 10, 1e5, "initial rephase interval") \
 OPTION( rephaseint, 1e3, 10, 1e5, "base rephase interval") \
@@ -76,6 +84,7 @@ OPTION( restart, 1, 0, 1, "enable restarts") \
 OPTION( restartint, 1, 1, 1e4, "base restart interval") \
 OPTION( restartmargin, 10, 0, 25, "fast/slow margin in percent") \
 OPTION( seed, 0, 0, INT_MAX, "random seed") \
+OPTION( simd, 1, 0, 1, "SIMD replacement search in long clauses") \
 OPTION( simplify, 1, 0, 1, "enable probing and elimination") \
 OPTION( stable, STABLE_DEFAULT, 0, 2, "enable stable search mode") \
 OPTION( stablebias, 100, 0, 1e3, "stable bias in percent") \
@@ -96,6 +105,7 @@ OPTION( ternarymaxadd, 20, 0, 1e4, "maximum clauses added in percent") \
 OPTION( ternarymaxeff, 100, 1, 1e4, "maximum relative efficiency") \
 OPTION( ternarymineff, 1e6, 0, 1e8, "minimum ternary efficiency") \
 OPTION( ternaryreleff, 40, 0, 2e3, "relative efficiency in per mille") \
+THROPT( threads, 4, 0, 64, "parser threads (0 and 1 parse sequentially)") \
 OPTION( tier1, 2, 1,1e2, "learned clause tier one glue limit") \
 OPTION( tier2, 6, 1,1e3, "learned clause tier two glue limit") \
 OPTION( transitive, 1, 0, 1, "transitive reduction of binary clauses") \
@@ -160,6 +170,18 @@ OPTION( xorsclslim, 5, 3, 31, "XOR extraction clause size limit") \
 #define EMBOPT(...) /**/
 #endif
 
+#ifdef PACKED_CLAUSES
+#define PCKOPT OPTION
+#else
+#define PCKOPT(...) /**/
+#endif
+
+#ifdef THREADS
+#define THROPT OPTION
+#else
+#define THROPT(...) /**/
+#endif
+
 // *INDENT-ON*
 
 typedef struct opt opt;
@@ -0,0 +1,78 @@
+#ifdef PACKED_CLAUSES
+
+#include "internal.h"
+#include "pack.h"
+
+#include <string.h>
+
+unsigned
+kissat_packing_width (kissat * solver)
+{
+  assert (LITS > 1);
+  unsigned res = 0;
+  for (unsigned max_lit = LITS - 1; max_lit; max_lit >>= 1)
+    res++;
+  return res;
+}
+
+bool
+kissat_packable_clause (kissat * solver, clause * c, unsigned size)
+{
+  if (!GET_OPTION (pack))
+    return false;
+  if (!c->redundant)
+    return false;
+  if (c->keep || c->hyper || c->used)
+    return false;
+  if (c->glue <= (unsigned) GET_OPTION (tier2))
+    return false;
+#ifdef SHORT_HEADER
+  if (size <= MAX_SHORT_SIZE)
+    return false;
+#endif
+  return size >= (unsigned) GET_OPTION (packsize);
+}
+
+// The literals 'lits' are not allowed to overlap with the clause 'c'.
+
+void
+kissat_pack_literals (clause * c, unsigned width,
+		      unsigned size, const unsigned *lits)
+{
+  assert (2 < size);
+  assert (!SHORT_CLAUSE (c));
+  c->packed = true;
+  c->shrunken = false;
+  c->searched = 2;
+  c->size = size;
+  c->lits[0] = lits[0];
+  c->lits[1] = lits[1];
+  PACKED_WIDTH (c) = width;
+  const size_t words = kissat_packed_words (size, width);
+  memset (PACKED_DATA (c), 0, words * sizeof (unsigned));
+  for (unsigned i = 2; i < size; i++)
+    kissat_set_packed_literal (c, i, lits[i]);
+}
+
+unsigned *
+kissat_unpack_literals (kissat * solver, clause * c)
+{
+  assert (c->packed);
+  CLEAR_STACK (solver->packed);
+  for (all_literals_in_clause (lit, c))
+    PUSH_STACK (solver->packed, lit);
+  return BEGIN_STACK (solver->packed);
+}
+
+void
+kissat_sort_packed_literals (kissat * solver, clause * c)
+{
+  const unsigned size = CLAUSE_SIZE (c);
+  unsigned *lits = kissat_unpack_literals (solver, c);
+  kissat_sort_literals (solver, size, lits);
+  kissat_pack_literals (c, PACKED_WIDTH (c), size, lits);
+}
+
+#else
+int kissat_pack_dummy_to_avoid_warning;
+#endif
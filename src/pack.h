@@ -0,0 +1,22 @@
+#ifndef _pack_h_INCLUDED
+#define _pack_h_INCLUDED
+
+#ifdef PACKED_CLAUSES
+
+#include <stdbool.h>
+
+struct clause;
+struct kissat;
+
+unsigned kissat_packing_width (struct kissat *);
+bool kissat_packable_clause (struct kissat *, struct clause *, unsigned size);
+
+void kissat_pack_literals (struct clause *, unsigned width,
+			   unsigned size, const unsigned *lits);
+unsigned *kissat_unpack_literals (struct kissat *, struct clause *);
+
+void kissat_sort_packed_literals (struct kissat *, struct clause *);
+
+#endif
+
+#endif
@@ -6,6 +6,7 @@
 
 #include <ctype.h>
 #include <inttypes.h>
+#include <string.h>
 
 static int
 next (file * file, uint64_t * lineno_ptr)
@@ -19,6 +20,59 @@ next (file * file, uint64_t * lineno_ptr)
 #define NEXT() \
   next (file, lineno_ptr)
 
+// The following two functions scan the body of the file directly in the
+// input buffer and only fall back to 'next' at the end of the buffer.
+
+static inline bool
+scan_index (file * file, uint64_t * lineno_ptr, int *idx_ptr, int *ch_ptr)
+{
+  int idx = *idx_ptr;
+  for (;;)
+    {
+      const unsigned char *p = file->pos;
+      const unsigned char *const end = file->end;
+      while (p != end && isdigit (*p))
+        {
+          if (EXTERNAL_MAX_VAR / 10 < idx)
+            return false;
+          idx *= 10;
+          const int digit = *p++ - '0';
+          if (EXTERNAL_MAX_VAR - digit < idx)
+            return false;
+          idx += digit;
+        }
+      file->pos = p;
+      const int ch = NEXT ();
+      if (!isdigit (ch))
+        {
+          *idx_ptr = idx;
+          *ch_ptr = ch;
+          return true;
+        }
+      file->pos--;
+    }
+}
+
+static inline int
+skip_comment (file * file, uint64_t * lineno_ptr)
+{
+  for (;;)
+    {
+      const unsigned char *p = file->pos;
+      const size_t bytes = file->end - p;
+      const unsigned char *q = bytes ? memchr (p, '\n', bytes) : 0;
+      if (q)
+        {
+          file->pos = q + 1;
+          *lineno_ptr += 1;
+          return '\n';
+        }
+      file->pos = file->end;
+      if (!kissat_fill_buffer (file))
+        return EOF;
+    }
+}
+
 static const char *
 nonl (int ch, const char *str, uint64_t * lineno_ptr)
 {
@@ -32,9 +86,560 @@ nonl (int ch, const char *str, uint64_t * lineno_ptr)
 
 #define TRY_RELAXED_PARSING "(try '--relaxed' parsing)"
 
+// Literals are encoded in binary CNF files as variable-length unsigned
+// integers with seven bits per byte (least significant group first).
+// Positive literals 'idx' are mapped to '2*idx', negative literals
+// '-idx' to '2*idx+1' and the terminating zero of a clause to '0'.
+
+static void
+write_varint (file * file, uint64_t u)
+{
+  while (u > 127)
+    {
+      kissat_putc (file, (u & 127) | 128);
+      u >>= 7;
+    }
+  kissat_putc (file, u);
+}
+
+static inline unsigned
+encode_literal (int lit)
+{
+  return lit < 0 ? 2u * (unsigned) -lit + 1 : 2u * (unsigned) lit;
+}
+
+typedef struct importer importer;
+
+#ifdef THREADS
+
+#include "allocate.h"
+
+#include <pthread.h>
+
+// Clauses of streamed input, which is not mapped, are imported by a
+// separate thread.  The parser fills blocks of literals, which are passed
+// through a small bounded ring to the importer, which adds them in order
+// with 'kissat_add_clauses'.  Together with reading compressed input ahead
+// (see 'file.c') decompression, tokenizing and importing clauses thus
+// form a pipeline of three threads.  While the importer is running the
+// parser does not access the solver at all.
+
+#define IMPORT_BLOCKS 4
+#define IMPORT_BLOCK_SIZE (1u << 16)
+
+struct importer
+{
+  kissat *solver;
+  int *pos;
+  int *end;
+  unsigned head;
+  unsigned tail;
+  unsigned filled;
+  bool stop;
+  int *blocks[IMPORT_BLOCKS];
+  size_t sizes[IMPORT_BLOCKS];
+  pthread_t thread;
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+};
+
+static void *
+import_blocks (void *ptr)
+{
+  importer *importer = ptr;
+  pthread_mutex_lock (&importer->lock);
+  for (;;)
+    {
+      while (!importer->filled && !importer->stop)
+        pthread_cond_wait (&importer->cond, &importer->lock);
+      if (!importer->filled)
+        break;
+      const unsigned head = importer->head;
+      pthread_mutex_unlock (&importer->lock);
+      kissat_add_clauses (importer->solver,
+                          importer->blocks[head], importer->sizes[head]);
+      pthread_mutex_lock (&importer->lock);
+      importer->head = (head + 1) % IMPORT_BLOCKS;
+      importer->filled--;
+      pthread_cond_broadcast (&importer->cond);
+    }
+  pthread_mutex_unlock (&importer->lock);
+  return 0;
+}
+
+static void
+push_block (importer * importer)
+{
+  const unsigned tail = importer->tail;
+  const size_t size = importer->pos - importer->blocks[tail];
+  if (!size)
+    return;
+  const unsigned next = (tail + 1) % IMPORT_BLOCKS;
+  pthread_mutex_lock (&importer->lock);
+  importer->sizes[tail] = size;
+  importer->tail = next;
+  importer->filled++;
+  pthread_cond_broadcast (&importer->cond);
+  while (importer->filled == IMPORT_BLOCKS)
+    pthread_cond_wait (&importer->cond, &importer->lock);
+  pthread_mutex_unlock (&importer->lock);
+  importer->pos = importer->blocks[next];
+  importer->end = importer->pos + IMPORT_BLOCK_SIZE;
+}
+
+static inline void
+import_literal (importer * importer, int lit)
+{
+  if (importer->pos == importer->end)
+    push_block (importer);
+  *importer->pos++ = lit;
+}
+
+static void
+free_importer (kissat * solver, importer * importer)
+{
+  for (unsigned i = 0; i < IMPORT_BLOCKS; i++)
+    kissat_free (solver, importer->blocks[i],
+                 IMPORT_BLOCK_SIZE * sizeof (int));
+  kissat_free (solver, importer, sizeof *importer);
+}
+
+static importer *
+start_importer (kissat * solver, file * file, struct file *binary)
+{
+  if (binary)
+    return 0;
+  if (file->mapped)
+    return 0;
+  if (GET_OPTION (threads) < 2)
+    return 0;
+  importer *importer = kissat_calloc (solver, 1, sizeof *importer);
+  importer->solver = solver;
+  for (unsigned i = 0; i < IMPORT_BLOCKS; i++)
+    importer->blocks[i] =
+      kissat_malloc (solver, IMPORT_BLOCK_SIZE * sizeof (int));
+  importer->pos = importer->blocks[0];
+  importer->end = importer->pos + IMPORT_BLOCK_SIZE;
+  pthread_mutex_init (&importer->lock, 0);
+  pthread_cond_init (&importer->cond, 0);
+  if (pthread_create (&importer->thread, 0, import_blocks, importer))
+    {
+      pthread_cond_destroy (&importer->cond);
+      pthread_mutex_destroy (&importer->lock);
+      free_importer (solver, importer);
+      return 0;
+    }
+  return importer;
+}
+
+static void
+stop_importer (kissat * solver, importer * importer)
+{
+  if (!importer)
+    return;
+  push_block (importer);
+  pthread_mutex_lock (&importer->lock);
+  importer->stop = true;
+  pthread_cond_broadcast (&importer->cond);
+  pthread_mutex_unlock (&importer->lock);
+  pthread_join (importer->thread, 0);
+  pthread_cond_destroy (&importer->cond);
+  pthread_mutex_destroy (&importer->lock);
+  free_importer (solver, importer);
+  kissat_very_verbose (solver, "imported clauses in separate thread");
+}
+
+#endif
+
+static inline void
+add_literal (kissat * solver, file * binary, importer * importer, int lit)
+{
+  if (binary)
+    write_varint (binary, encode_literal (lit));
+#ifdef THREADS
+  else if (importer)
+    import_literal (importer, lit);
+#endif
+  else
+    kissat_add (solver, lit);
+#ifndef THREADS
+  (void) importer;
+#endif
+}
+
+#ifdef THREADS
+
+// With threads the clause section of mapped files is split into rounds
+// of line aligned chunks, one per thread, which are tokenized in
+// parallel into separate literal buffers.  The literals of a round are
+// then added in order with 'kissat_add_clauses' while the next round is
+// tokenized.  Tokenizing a chunk only succeeds if the sequential parser
+// accepts its lines too.  Otherwise, and if the round has too many
+// clauses, we stop and let the sequential parser continue at the start
+// of the round, which then reports the same error at the same line.
+// Thus the parsed formula and parse errors do not depend on threads.
+
+#define CHUNK_SIZE (1u << 20)
+#define CHUNK_LITS (CHUNK_SIZE / 2 + 1)
+
+typedef struct chunk chunk;
+
+struct chunk
+{
+  const unsigned char *begin;
+  const unsigned char *end;
+  strictness strict;
+  int variables;
+  bool error;
+  bool joinable;
+  int *lits;
+  int *end_lits;
+  uint64_t clauses;
+  uint64_t lines;
+  pthread_t thread;
+};
+
+static void *
+tokenize_chunk (void *ptr)
+{
+  chunk *chunk = ptr;
+  const unsigned char *p = chunk->begin;
+  const unsigned char *const end = chunk->end;
+  const int variables = chunk->variables;
+  const bool relaxed = (chunk->strict == RELAXED_PARSING);
+  int *q = chunk->lits;
+  int *const stop = q + CHUNK_LITS;
+  uint64_t clauses = 0, lines = 0;
+  assert (p != end);
+  assert (end[-1] == '\n');
+  while (p != end)
+    {
+      int ch = *p++;
+      if (ch == ' ' || ch == '\t')
+        continue;
+      if (ch == '\n')
+        {
+          lines++;
+          continue;
+        }
+      if (ch == '\r')
+        {
+          if (*p++ != '\n')
+            goto ERROR;
+          lines++;
+          continue;
+        }
+      if (ch == 'c')
+        {
+          while (*p++ != '\n')
+            ;
+          lines++;
+          continue;
+        }
+      int sign;
+      if (ch == '-')
+        {
+          ch = *p++;
+          if (!isdigit (ch) || ch == '0')
+            goto ERROR;
+          sign = -1;
+        }
+      else if (!isdigit (ch))
+        goto ERROR;
+      else
+        sign = 1;
+      int idx = ch - '0';
+      while (isdigit (ch = *p++))
+        {
+          if (EXTERNAL_MAX_VAR / 10 < idx)
+            goto ERROR;
+          idx *= 10;
+          const int digit = ch - '0';
+          if (EXTERNAL_MAX_VAR - digit < idx)
+            goto ERROR;
+          idx += digit;
+        }
+      if (ch == '\r')
+        {
+          if (*p++ != '\n')
+            goto ERROR;
+          lines++;
+        }
+      else if (ch == 'c')
+        {
+          while (*p++ != '\n')
+            ;
+          lines++;
+        }
+      else if (ch == '\n')
+        lines++;
+      else if (ch != ' ' && ch != '\t')
+        goto ERROR;
+      if (!relaxed && idx > variables)
+        goto ERROR;
+      if (q == stop)
+        goto ERROR;
+      if (!idx)
+        clauses++;
+      *q++ = sign * idx;
+    }
+  chunk->end_lits = q;
+  chunk->clauses = clauses;
+  chunk->lines = lines;
+  return 0;
+ERROR:
+  chunk->error = true;
+  return 0;
+}
+
+static unsigned
+start_round (chunk * chunks, unsigned threads,
+             const unsigned char *begin, const unsigned char *end)
+{
+  unsigned size = 0;
+  while (size < threads && begin != end)
+    {
+      const unsigned char *p;
+      if ((size_t) (end - begin) <= CHUNK_SIZE)
+        p = end;
+      else
+        {
+          const unsigned char *const limit = begin + CHUNK_SIZE;
+          p = limit;
+          while (p != begin && p[-1] != '\n')
+            p--;
+          if (p == begin)
+            {
+              p = limit;
+              while (p[-1] != '\n')
+                p++;
+            }
+        }
+      chunk *chunk = chunks + size++;
+      chunk->begin = begin;
+      chunk->end = p;
+      chunk->error = false;
+      chunk->joinable =
+        !pthread_create (&chunk->thread, 0, tokenize_chunk, chunk);
+      if (!chunk->joinable)
+        tokenize_chunk (chunk);
+      begin = p;
+    }
+  return size;
+}
+
+static void
+join_round (chunk * chunks, unsigned size)
+{
+  for (unsigned i = 0; i < size; i++)
+    {
+      chunk *chunk = chunks + i;
+      if (chunk->joinable)
+        pthread_join (chunk->thread, 0);
+      chunk->joinable = false;
+    }
+}
+
+static void
+parse_parallel (kissat * solver, strictness strict,
+                file * file, struct file *binary,
+                uint64_t * lineno_ptr, int variables, uint64_t clauses,
+                uint64_t * parsed_ptr, int *lit_ptr)
+{
+  const unsigned threads = GET_OPTION (threads);
+  if (threads < 2)
+    return;
+  if (!file->mapped)
+    return;
+  const unsigned char *end = file->end;
+  while (end != file->pos && end[-1] != '\n')
+    end--;
+  if ((size_t) (end - file->pos) < 2 * (size_t) CHUNK_SIZE)
+    return;
+  const unsigned capacity = 2 * threads;
+  chunk *chunks = kissat_calloc (solver, capacity, sizeof *chunks);
+  for (unsigned i = 0; i < capacity; i++)
+    {
+      chunk *chunk = chunks + i;
+      chunk->strict = strict;
+      chunk->variables = variables;
+      chunk->lits = kissat_malloc (solver, CHUNK_LITS * sizeof (int));
+    }
+  uint64_t parsed = *parsed_ptr;
+  uint64_t lines = 0;
+  int lit = *lit_ptr;
+  chunk *round = chunks;
+  const unsigned char *begin = file->pos;
+  unsigned size = start_round (round, threads, begin, end);
+  while (size)
+    {
+      join_round (round, size);
+      uint64_t round_clauses = 0;
+      bool error = false;
+      for (unsigned i = 0; !error && i < size; i++)
+        {
+          const chunk *chunk = round + i;
+          error = chunk->error;
+          round_clauses += chunk->clauses;
+        }
+      if (!error && strict != RELAXED_PARSING &&
+          round_clauses > clauses - parsed)
+        error = true;
+      if (error)
+        break;
+      begin = round[size - 1].end;
+      chunk *next = (round == chunks) ? chunks + threads : chunks;
+      unsigned next_size = start_round (next, threads, begin, end);
+      for (unsigned i = 0; i < size; i++)
+        {
+          const chunk *chunk = round + i;
+          const size_t count = chunk->end_lits - chunk->lits;
+          if (binary)
+            for (const int *p = chunk->lits; p != chunk->end_lits; p++)
+              add_literal (solver, binary, 0, *p);
+          else
+            kissat_add_clauses (solver, chunk->lits, count);
+          if (count)
+            lit = chunk->end_lits[-1];
+          lines += chunk->lines;
+        }
+      parsed += round_clauses;
+      file->pos = begin;
+      round = next;
+      size = next_size;
+    }
+  for (unsigned i = 0; i < capacity; i++)
+    kissat_free (solver, chunks[i].lits, CHUNK_LITS * sizeof (int));
+  kissat_dealloc (solver, chunks, capacity, sizeof *chunks);
+  kissat_very_verbose (solver,
+                       "parsed %" PRIu64 " clauses in %" PRIu64 " lines "
+                       "with %u threads", parsed - *parsed_ptr, lines,
+                       threads);
+  *lineno_ptr += lines;
+  *parsed_ptr = parsed;
+  *lit_ptr = lit;
+}
+
+#endif
+
+static const char *
+parse_clauses (kissat * solver, strictness strict,
+               file * file, struct file *binary, importer * importer,
+               uint64_t * lineno_ptr, int variables, uint64_t clauses)
+{
+  int ch;
+  uint64_t parsed = 0;
+  int lit = 0;
+#ifdef THREADS
+  parse_parallel (solver, strict, file, binary, lineno_ptr,
+                  variables, clauses, &parsed, &lit);
+#endif
+  for (;;)
+    {
+      ch = NEXT ();
+      if (ch == ' ')
+        continue;
+      if (ch == '\t')
+        continue;
+      if (ch == '\n')
+        continue;
+      if (ch == '\r')
+        {
+          ch = NEXT ();
+          if (ch != '\n')
+            return "expected new-line after carriage-return";
+          continue;
+        }
+      if (ch == 'c')
+        {
+          ch = skip_comment (file, lineno_ptr);
+          if (ch == EOF && strict == PEDANTIC_PARSING)
+            return "unexpected end-of-file in comment after header";
+          if (ch == EOF)
+            break;
+          continue;
+        }
+      if (ch == EOF)
+        break;
+      int sign;
+      if (ch == '-')
+        {
+          ch = NEXT ();
+          if (ch == EOF)
+            return "unexpected end-of-file after '-'";
+          if (ch == '\n')
+            return nonl (ch, "unexpected new-line after '-'", lineno_ptr);
+          if (!isdigit (ch))
+            return "expected digit after '-'";
+          if (ch == '0')
+            return "expected non-zero digit after '-'";
+          sign = -1;
+        }
+      else if (!isdigit (ch))
+        return "expected digit or '-'";
+      else
+        sign = 1;
+      assert (isdigit (ch));
+      int idx = ch - '0';
+      if (!scan_index (file, lineno_ptr, &idx, &ch))
+        return "variable index too large";
+      if (ch == EOF)
+        {
+          if (strict == PEDANTIC_PARSING)
+            {
+              if (idx)
+                return "unexpected end-of-file after literal";
+              else
+                return "unexpected end-of-file after trailing zero";
+            }
+        }
+      else if (ch == '\r')
+        {
+          ch = NEXT ();
+          if (ch != '\n')
+            return "expected new-line after carriage-return";
+        }
+      else if (ch == 'c')
+        {
+          ch = skip_comment (file, lineno_ptr);
+          if (ch == EOF && strict == PEDANTIC_PARSING)
+            return "unexpected end-of-file in comment after literal";
+        }
+      else if (ch != ' ' && ch != '\t' && ch != '\n')
+        return "expected white space after literal";
+      if (strict != RELAXED_PARSING && idx > variables)
+        return nonl (ch, "maximum variable index exceeded "
+                     TRY_RELAXED_PARSING, lineno_ptr);
+      if (idx)
+        {
+          assert (sign == 1 || sign == -1);
+          assert (idx != INT_MIN);
+          lit = sign * idx;
+        }
+      else
+        {
+          if (strict != RELAXED_PARSING && parsed == clauses)
+            return "too many clauses " TRY_RELAXED_PARSING;
+          parsed++;
+          lit = 0;
+        }
+      add_literal (solver, binary, importer, lit);
+    }
+  if (lit)
+    return "trailing zero missing";
+  if (strict != RELAXED_PARSING && parsed < clauses)
+    {
+      if (parsed + 1 == clauses)
+        return "one clause missing " TRY_RELAXED_PARSING;
+      return "more than one clause missing " TRY_RELAXED_PARSING;
+    }
+  return 0;
+}
+
 static const char *
 parse_dimacs (kissat * solver, strictness strict,
-              file * file, uint64_t * lineno_ptr, int *max_var_ptr)
+              file * file, struct file *binary,
+              uint64_t * lineno_ptr, int *max_var_ptr)
 {
   *lineno_ptr = 1;
   bool first = true;
@@ -272,106 +877,104 @@ parse_dimacs (kissat * solver, strictness strict,
   kissat_message (solver,
                   "parsed 'p cnf %d %" PRIu64 "' header", variables, clauses);
   *max_var_ptr = variables;
-  kissat_reserve (solver, variables);
-  uint64_t parsed = 0;
-  int lit = 0;
-  for (;;)
+  if (binary)
     {
-      ch = NEXT ();
-      if (ch == ' ')
-        continue;
-      if (ch == '\t')
-        continue;
-      if (ch == '\n')
-        continue;
-      if (ch == '\r')
+      for (const char *p = BINARY_CNF_MAGIC; *p; p++)
+        kissat_putc (binary, *p);
+      write_varint (binary, variables);
+      write_varint (binary, clauses);
+    }
+  else
+    {
+      kissat_reserve (solver, variables);
+#ifdef LRAT
+      if (solver->lrat)
+        kissat_reserve_clauses_in_proof (solver, clauses);
+#endif
+    }
+  importer *importer = 0;
+#ifdef THREADS
+  importer = start_importer (solver, file, binary);
+#endif
+  const char *res = parse_clauses (solver, strict, file, binary, importer,
+                                   lineno_ptr, variables, clauses);
+#ifdef THREADS
+  stop_importer (solver, importer);
+#endif
+  return res;
+}
+
+// Returns '1' if a number was read, '0' on end-of-file before the first
+// byte, '-1' on end-of-file within the number and '-2' if it does not
+// fit into 64 bits.  Numbers not crossing the end of the input buffer
+// are decoded directly in the buffer.
+
+static inline int
+read_varint (file * file, uint64_t * res_ptr)
+{
+  uint64_t res = 0;
+  unsigned shift = 0;
+  int ch;
+  if (file->end - file->pos >= 10)
+    {
+      const unsigned char *p = file->pos;
+      do
         {
-          ch = NEXT ();
-          if (ch != '\n')
-            return "expected new-line after carriage-return";
-          continue;
+          if (shift > 63)
+            return -2;
+          ch = *p++;
+          if (shift == 63 && (ch & ~1))
+            return -2;
+          res |= (uint64_t) (ch & 127) << shift;
+          shift += 7;
         }
-      if (ch == 'c')
+      while (ch & 128);
+      file->pos = p;
+    }
+  else
+    {
+      do
         {
-          while ((ch = NEXT ()) != '\n')
-            if (ch == EOF)
-              {
-                if (strict != PEDANTIC_PARSING)
-                  break;
-                return "unexpected end-of-file in comment after header";
-              }
+          if (shift > 63)
+            return -2;
+          ch = kissat_getc (file);
           if (ch == EOF)
-            break;
-          continue;
+            return shift ? -1 : 0;
+          if (shift == 63 && (ch & ~1))
+            return -2;
+          res |= (uint64_t) (ch & 127) << shift;
+          shift += 7;
         }
-      if (ch == EOF)
+      while (ch & 128);
+    }
+  *res_ptr = res;
+  return 1;
+}
+
+static const char *
+parse_binary_clauses (kissat * solver, strictness strict, file * file,
+                      importer * importer, int variables, uint64_t clauses)
+{
+  uint64_t tmp;
+  uint64_t parsed = 0;
+  int lit = 0;
+  for (;;)
+    {
+      const int res = read_varint (file, &tmp);
+      if (!res)
         break;
-      int sign;
-      if (ch == '-')
-        {
-          ch = NEXT ();
-          if (ch == EOF)
-            return "unexpected end-of-file after '-'";
-          if (ch == '\n')
-            return nonl (ch, "unexpected new-line after '-'", lineno_ptr);
-          if (!isdigit (ch))
-            return "expected digit after '-'";
-          if (ch == '0')
-            return "expected non-zero digit after '-'";
-          sign = -1;
-        }
-      else if (!isdigit (ch))
-        return "expected digit or '-'";
-      else
-        sign = 1;
-      assert (isdigit (ch));
-      int idx = ch - '0';
-      while (isdigit (ch = NEXT ()))
+      if (res == -1)
+        return "unexpected end-of-file in literal";
+      if (res < 0 || tmp == 1)
+        return "invalid literal encoding";
+      if (tmp)
         {
-          if (EXTERNAL_MAX_VAR / 10 < idx)
+          const uint64_t idx = tmp >> 1;
+          if (idx > EXTERNAL_MAX_VAR)
             return "variable index too large";
-          idx *= 10;
-          const int digit = ch - '0';
-          if (EXTERNAL_MAX_VAR - digit < idx)
-            return "variable index too large";
-          idx += digit;
-        }
-      if (ch == EOF)
-        {
-          if (strict == PEDANTIC_PARSING)
-            {
-              if (idx)
-                return "unexpected end-of-file after literal";
-              else
-                return "unexpected end-of-file after trailing zero";
-            }
-        }
-      else if (ch == '\r')
-        {
-          ch = NEXT ();
-          if (ch != '\n')
-            return "expected new-line after carriage-return";
-        }
-      else if (ch == 'c')
-        {
-          while ((ch = NEXT ()) != '\n')
-            if (ch == EOF)
-              {
-                if (strict != PEDANTIC_PARSING)
-                  break;
-                return "unexpected end-of-file in comment after literal";
-              }
-        }
-      else if (ch != ' ' && ch != '\t' && ch != '\n')
-        return "expected white space after literal";
-      if (strict != RELAXED_PARSING && idx > variables)
-        return nonl (ch, "maximum variable index exceeded "
-                     TRY_RELAXED_PARSING, lineno_ptr);
-      if (idx)
-        {
-          assert (sign == 1 || sign == -1);
-          assert (idx != INT_MIN);
-          lit = sign * idx;
+          if (strict != RELAXED_PARSING && idx > (uint64_t) variables)
+            return "maximum variable index exceeded " TRY_RELAXED_PARSING;
+          lit = (tmp & 1) ? -(int) idx : (int) idx;
         }
       else
         {
@@ -380,7 +983,7 @@ parse_dimacs (kissat * solver, strictness strict,
           parsed++;
           lit = 0;
         }
-      kissat_add (solver, lit);
+      add_literal (solver, 0, importer, lit);
     }
   if (lit)
     return "trailing zero missing";
@@ -393,6 +996,43 @@ parse_dimacs (kissat * solver, strictness strict,
   return 0;
 }
 
+static const char *
+parse_binary (kissat * solver, strictness strict,
+              file * file, int *max_var_ptr)
+{
+  for (const char *p = BINARY_CNF_MAGIC; *p; p++)
+    if (kissat_getc (file) != (unsigned char) *p)
+      return "invalid binary CNF signature";
+  uint64_t tmp;
+  if (read_varint (file, &tmp) <= 0)
+    return "could not read maximum variable";
+  if (tmp > EXTERNAL_MAX_VAR)
+    return "maximum variable too large";
+  const int variables = tmp;
+  uint64_t clauses;
+  if (read_varint (file, &clauses) <= 0)
+    return "could not read number of clauses";
+  kissat_message (solver,
+                  "parsed binary 'p cnf %d %" PRIu64 "' header",
+                  variables, clauses);
+  *max_var_ptr = variables;
+  kissat_reserve (solver, variables);
+#ifdef LRAT
+  if (solver->lrat)
+    kissat_reserve_clauses_in_proof (solver, clauses);
+#endif
+  importer *importer = 0;
+#ifdef THREADS
+  importer = start_importer (solver, file, 0);
+#endif
+  const char *res = parse_binary_clauses (solver, strict, file, importer,
+                                          variables, clauses);
+#ifdef THREADS
+  stop_importer (solver, importer);
+#endif
+  return res;
+}
+
 const char *
 kissat_parse_dimacs (kissat * solver,
                      strictness strict,
@@ -400,7 +1040,40 @@ kissat_parse_dimacs (kissat * solver,
 {
   const char *res;
   START (parse);
-  res = parse_dimacs (solver, strict, file, lineno_ptr, max_var_ptr);
+  res = parse_dimacs (solver, strict, file, 0, lineno_ptr, max_var_ptr);
+  STOP (parse);
+  return res;
+}
+
+bool
+kissat_binary_cnf_file (file * file)
+{
+  if (file->pos == file->end && !kissat_fill_buffer (file))
+    return false;
+  return *file->pos == (unsigned char) BINARY_CNF_MAGIC[0];
+}
+
+const char *
+kissat_parse_binary (kissat * solver, strictness strict,
+                     file * file, uint64_t * offset_ptr, int *max_var_ptr)
+{
+  const char *res;
+  START (parse);
+  res = parse_binary (solver, strict, file, max_var_ptr);
+  STOP (parse);
+  *offset_ptr = file->bytes - (file->end - file->pos);
+  return res;
+}
+
+const char *
+kissat_convert_dimacs (kissat * solver, strictness strict,
+                       file * dimacs, file * binary,
+                       uint64_t * lineno_ptr, int *max_var_ptr)
+{
+  const char *res;
+  START (parse);
+  res = parse_dimacs (solver, strict, dimacs, binary,
+                      lineno_ptr, max_var_ptr);
   STOP (parse);
   return res;
 }
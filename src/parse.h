@@ -15,4 +15,19 @@ typedef enum strictness strictness;
 const char *kissat_parse_dimacs (struct kissat *, strictness, file *,
 				 uint64_t * linenoptr, int *max_var_ptr);
 
+// Binary CNF files start with this signature, followed by the maximum
+// variable and the number of clauses of the DIMACS header and then the
+// encoded literals of the clauses (see 'parse.c').
+
+#define BINARY_CNF_MAGIC "\177CNF1"
+
+bool kissat_binary_cnf_file (file *);
+
+const char *kissat_parse_binary (struct kissat *, strictness, file *,
+				 uint64_t * offset_ptr, int *max_var_ptr);
+
+const char *kissat_convert_dimacs (struct kissat *, strictness,
+				   file * dimacs, file * binary,
+				   uint64_t * linenoptr, int *max_var_ptr);
+
 #endif
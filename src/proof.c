@@ -4,27 +4,216 @@
 #include "file.h"
 #include "inline.h"
 
+#ifdef LRAT
+#include "error.h"
+
+#include <inttypes.h>
+#endif
+
+// All memory allocated here is attributed to the 'proof' memory tag.
+
+#define PUSH_PROOF_STACK(S,E) PUSH_TAGGED_STACK (MEMORY (proof), S, E)
+#define RELEASE_PROOF_STACK(S) RELEASE_TAGGED_STACK (MEMORY (proof), S)
+
+#ifdef THREADS
+
+#include <pthread.h>
+
+// Proof lines are written into one of two buffers, while a background
+// thread writes the other one to the proof file.  The solver only has to
+// wait if it filled its buffer before the thread finished writing.
+
+typedef struct writer writer;
+
+struct writer
+{
+  FILE *file;
+  size_t size;
+  size_t filled;
+  size_t flushing;
+  unsigned current;
+  unsigned pending;
+  bool stop;
+  unsigned char *buffers[2];
+  pthread_t thread;
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+};
+
+#endif
+
+#ifdef LRAT
+
+// Identifiers of binary clauses are found through a hash table keyed by
+// both (external) literals, since binary clauses are not allocated.
+
+typedef STACK (uint64_t) identifiers;
+
+typedef struct binary_id binary_id;
+
+struct binary_id
+{
+  uint64_t key;
+  uint64_t id;
+};
+
+#endif
+
 struct proof
 {
   bool binary;
+#ifdef LRAT
+  bool lrat;
+#endif
   file *file;
+#ifdef THREADS
+  writer *writer;
+#endif
   ints line;
+#ifdef LRAT
+  identifiers chain;
+  identifiers reasons;
+  identifiers units;
+  unsigneds visited;
+  unsigneds work;
+  chars marks;
+  binary_id *binaries;
+  size_t size_binaries;
+  size_t count_binaries;
+  uint64_t reserved;
+  uint64_t originals;
+  uint64_t derived;
+  uint64_t last;
+#endif
   uint64_t added;
   uint64_t deleted;
   uint64_t lines;
   uint64_t literals;
 };
 
+#ifdef THREADS
+
+static void *
+write_buffers (void *ptr)
+{
+  writer *writer = ptr;
+  pthread_mutex_lock (&writer->lock);
+  for (;;)
+    {
+      while (!writer->flushing && !writer->stop)
+	pthread_cond_wait (&writer->cond, &writer->lock);
+      const size_t bytes = writer->flushing;
+      if (!bytes)
+	break;
+      const unsigned char *buffer = writer->buffers[writer->pending];
+      pthread_mutex_unlock (&writer->lock);
+      fwrite (buffer, 1, bytes, writer->file);
+      pthread_mutex_lock (&writer->lock);
+      writer->flushing = 0;
+      pthread_cond_broadcast (&writer->cond);
+    }
+  pthread_mutex_unlock (&writer->lock);
+  return 0;
+}
+
+static void
+flush_writer (writer * writer)
+{
+  if (!writer->filled)
+    return;
+  pthread_mutex_lock (&writer->lock);
+  while (writer->flushing)
+    pthread_cond_wait (&writer->cond, &writer->lock);
+  writer->pending = writer->current;
+  writer->flushing = writer->filled;
+  pthread_cond_broadcast (&writer->cond);
+  pthread_mutex_unlock (&writer->lock);
+  writer->current = !writer->current;
+  writer->filled = 0;
+}
+
+static void
+free_writer (kissat * solver, writer * writer)
+{
+  for (unsigned i = 0; i < 2; i++)
+    kissat_free_tagged (solver, MEMORY (proof),
+			writer->buffers[i], writer->size);
+  kissat_free_tagged (solver, MEMORY (proof), writer, sizeof *writer);
+}
+
+static void
+start_writer (kissat * solver, proof * proof)
+{
+  const size_t size = (size_t) GET_OPTION (proofbuffer) << 20;
+  if (!size)
+    return;
+  // Already open files such as '<stdout>' might be shared with messages
+  // and thus have to be written synchronously.
+  if (!proof->file->close)
+    return;
+  writer *writer =
+    kissat_calloc_tagged (solver, MEMORY (proof), 1, sizeof *writer);
+  writer->file = proof->file->file;
+  writer->size = size;
+  for (unsigned i = 0; i < 2; i++)
+    writer->buffers[i] = kissat_malloc_tagged (solver, MEMORY (proof), size);
+  pthread_mutex_init (&writer->lock, 0);
+  pthread_cond_init (&writer->cond, 0);
+  if (pthread_create (&writer->thread, 0, write_buffers, writer))
+    {
+      pthread_cond_destroy (&writer->cond);
+      pthread_mutex_destroy (&writer->lock);
+      free_writer (solver, writer);
+      return;
+    }
+  proof->writer = writer;
+  LOG ("started asynchronous proof writer with two %zu MB buffers",
+       size >> 20);
+}
+
+static void
+stop_writer (kissat * solver, proof * proof)
+{
+  writer *writer = proof->writer;
+  if (!writer)
+    return;
+  flush_writer (writer);
+  pthread_mutex_lock (&writer->lock);
+  writer->stop = true;
+  pthread_cond_broadcast (&writer->cond);
+  pthread_mutex_unlock (&writer->lock);
+  pthread_join (writer->thread, 0);
+  pthread_cond_destroy (&writer->cond);
+  pthread_mutex_destroy (&writer->lock);
+  free_writer (solver, writer);
+  proof->writer = 0;
+  LOG ("stopped asynchronous proof writer");
+}
+
+#endif
+
 void
-kissat_init_proof (kissat * solver, file * file, bool binary)
+kissat_init_proof (kissat * solver, file * file, bool binary, bool lrat)
 {
   assert (file);
   assert (!solver->proof);
-  proof *proof = kissat_calloc (solver, 1, sizeof (struct proof));
+  proof *proof =
+    kissat_calloc_tagged (solver, MEMORY (proof), 1, sizeof (struct proof));
   proof->binary = binary;
+#ifdef LRAT
+  proof->lrat = lrat;
+  solver->lrat = lrat;
+#else
+  assert (!lrat);
+  (void) lrat;
+#endif
   proof->file = file;
+#ifdef THREADS
+  start_writer (solver, proof);
+#endif
   solver->proof = proof;
-  LOG ("starting to trace %s proof", binary ? "binary" : "non-binary");
+  LOG ("starting to trace %s %s proof",
+       binary ? "binary" : "non-binary", lrat ? "LRAT" : "DRAT");
 }
 
 void
@@ -33,8 +222,22 @@ kissat_release_proof (kissat * solver)
   proof *proof = solver->proof;
   assert (proof);
   LOG ("stopping to trace proof");
-  RELEASE_STACK (proof->line);
-  kissat_free (solver, proof, sizeof (struct proof));
+#ifdef THREADS
+  stop_writer (solver, proof);
+#endif
+  RELEASE_PROOF_STACK (proof->line);
+#ifdef LRAT
+  RELEASE_PROOF_STACK (proof->chain);
+  RELEASE_PROOF_STACK (proof->reasons);
+  RELEASE_PROOF_STACK (proof->units);
+  RELEASE_PROOF_STACK (proof->visited);
+  RELEASE_PROOF_STACK (proof->work);
+  RELEASE_PROOF_STACK (proof->marks);
+  kissat_free_tagged (solver, MEMORY (proof), proof->binaries,
+		      proof->size_binaries * sizeof *proof->binaries);
+  solver->lrat = false;
+#endif
+  kissat_free_tagged (solver, MEMORY (proof), proof, sizeof (struct proof));
   solver->proof = 0;
 }
 
@@ -70,7 +273,7 @@ import_internal_proof_literal (kissat * solver, proof * proof, unsigned ilit)
 {
   int elit = kissat_export_literal (solver, ilit);
   assert (elit);
-  PUSH_STACK (proof->line, elit);
+  PUSH_PROOF_STACK (proof->line, elit);
   proof->literals++;
 }
 
@@ -78,7 +281,7 @@ static void
 import_external_proof_literal (kissat * solver, proof * proof, int elit)
 {
   assert (elit);
-  PUSH_STACK (proof->line, elit);
+  PUSH_PROOF_STACK (proof->line, elit);
   proof->literals++;
 }
 
@@ -114,7 +317,39 @@ import_external_proof_literals (kissat * solver, proof * proof,
 static void
 import_proof_clause (kissat * solver, proof * proof, clause * c)
 {
-  import_internal_proof_literals (solver, proof, c->size, c->lits);
+  assert (EMPTY_STACK (proof->line));
+  for (all_literals_in_clause (ilit, c))
+    import_internal_proof_literal (solver, proof, ilit);
+}
+
+static inline void
+write_proof_char (proof * proof, int ch)
+{
+#ifdef THREADS
+  writer *writer = proof->writer;
+  if (writer)
+    {
+      if (writer->filled == writer->size)
+	flush_writer (writer);
+      writer->buffers[writer->current][writer->filled++] = ch;
+      proof->file->bytes++;
+      return;
+    }
+#endif
+  kissat_putc (proof->file, ch);
+}
+
+static void
+print_binary_number (proof * proof, uint64_t x)
+{
+  unsigned char ch;
+  while (x & ~(uint64_t) 0x7f)
+    {
+      ch = (x & 0x7f) | 0x80;
+      write_proof_char (proof, ch);
+      x >>= 7;
+    }
+  write_proof_char (proof, (unsigned char) x);
 }
 
 static void
@@ -122,18 +357,8 @@ print_binary_proof_line (proof * proof)
 {
   assert (proof->binary);
   for (all_stack (int, elit, proof->line))
-    {
-      unsigned x = 2u * ABS (elit) + (elit < 0);
-      unsigned char ch;
-      while (x & ~0x7f)
-	{
-	  ch = (x & 0x7f) | 0x80;
-	  kissat_putc (proof->file, ch);
-	  x >>= 7;
-	}
-      kissat_putc (proof->file, (unsigned char) x);
-    }
-  kissat_putc (proof->file, 0);
+    print_binary_number (proof, 2u * ABS (elit) + (elit < 0));
+  write_proof_char (proof, 0);
 }
 
 static void
@@ -152,7 +377,7 @@ print_non_binary_proof_line (proof * proof)
       unsigned eidx;
       if (elit < 0)
 	{
-	  kissat_putc (proof->file, '-');
+	  write_proof_char (proof, '-');
 	  eidx = -elit;
 	}
       else
@@ -160,11 +385,24 @@ print_non_binary_proof_line (proof * proof)
       for (unsigned tmp = eidx; tmp; tmp /= 10)
 	*--p = '0' + (tmp % 10);
       while (p != end_of_buffer)
-	kissat_putc (proof->file, *p++);
-      kissat_putc (proof->file, ' ');
+	write_proof_char (proof, *p++);
+      write_proof_char (proof, ' ');
     }
-  kissat_putc (proof->file, '0');
-  kissat_putc (proof->file, '\n');
+  write_proof_char (proof, '0');
+  write_proof_char (proof, '\n');
+}
+
+static void
+flush_proof_line (proof * proof)
+{
+#ifndef NDEBUG
+#ifdef THREADS
+  if (!proof->writer)
+#endif
+    fflush (proof->file->file);
+#else
+  (void) proof;
+#endif
 }
 
 static void
@@ -176,9 +414,7 @@ print_proof_line (proof * proof)
   else
     print_non_binary_proof_line (proof);
   CLEAR_STACK (proof->line);
-#ifndef NDEBUG
-  fflush (proof->file->file);
-#endif
+  flush_proof_line (proof);
 }
 
 static void
@@ -186,7 +422,7 @@ print_added_proof_line (proof * proof)
 {
   proof->added++;
   if (proof->binary)
-    kissat_putc (proof->file, 'a');
+    write_proof_char (proof, 'a');
   print_proof_line (proof);
 }
 
@@ -194,19 +430,537 @@ static void
 print_delete_proof_line (proof * proof)
 {
   proof->deleted++;
-  kissat_putc (proof->file, 'd');
+  write_proof_char (proof, 'd');
   if (!proof->binary)
-    kissat_putc (proof->file, ' ');
+    write_proof_char (proof, ' ');
   print_proof_line (proof);
 }
 
+#ifdef LRAT
+
+static void
+print_ascii_number (proof * proof, uint64_t n)
+{
+  char buffer[24];
+  char *end_of_buffer = buffer + sizeof buffer;
+  char *p = end_of_buffer;
+  do
+    *--p = '0' + (n % 10);
+  while (n /= 10);
+  while (p != end_of_buffer)
+    write_proof_char (proof, *p++);
+}
+
+static uint64_t
+next_derived_id (proof * proof)
+{
+  if (!proof->derived)
+    proof->derived = MAX (proof->reserved, proof->originals);
+  return ++proof->derived;
+}
+
+static void
+print_added_lrat_line (proof * proof, uint64_t id)
+{
+  proof->added++;
+  proof->lines++;
+  if (proof->binary)
+    {
+      write_proof_char (proof, 'a');
+      print_binary_number (proof, 2 * id);
+      print_binary_proof_line (proof);
+      for (all_stack (uint64_t, hint, proof->chain))
+	print_binary_number (proof, 2 * hint);
+      write_proof_char (proof, 0);
+    }
+  else
+    {
+      print_ascii_number (proof, id);
+      write_proof_char (proof, ' ');
+      for (all_stack (int, elit, proof->line))
+	{
+	  if (elit < 0)
+	    write_proof_char (proof, '-');
+	  print_ascii_number (proof, ABS (elit));
+	  write_proof_char (proof, ' ');
+	}
+      write_proof_char (proof, '0');
+      for (all_stack (uint64_t, hint, proof->chain))
+	{
+	  write_proof_char (proof, ' ');
+	  print_ascii_number (proof, hint);
+	}
+      write_proof_char (proof, ' ');
+      write_proof_char (proof, '0');
+      write_proof_char (proof, '\n');
+    }
+  CLEAR_STACK (proof->line);
+  CLEAR_STACK (proof->chain);
+  flush_proof_line (proof);
+}
+
+static void
+print_deleted_lrat_line (proof * proof, uint64_t id)
+{
+  assert (id);
+  proof->deleted++;
+  proof->lines++;
+  if (proof->binary)
+    {
+      write_proof_char (proof, 'd');
+      print_binary_number (proof, 2 * id);
+      write_proof_char (proof, 0);
+    }
+  else
+    {
+      print_ascii_number (proof, MAX (proof->derived, proof->originals));
+      write_proof_char (proof, ' ');
+      write_proof_char (proof, 'd');
+      write_proof_char (proof, ' ');
+      print_ascii_number (proof, id);
+      write_proof_char (proof, ' ');
+      write_proof_char (proof, '0');
+      write_proof_char (proof, '\n');
+    }
+  flush_proof_line (proof);
+}
+
+static uint64_t
+binary_key (int a, int b)
+{
+  uint64_t u = 2u * ABS (a) + (a < 0);
+  uint64_t v = 2u * ABS (b) + (b < 0);
+  if (u > v)
+    SWAP (uint64_t, u, v);
+  return (u << 32) | v;
+}
+
+static size_t
+hash_binary_key (proof * proof, uint64_t key)
+{
+  const uint64_t hash = key * 0x9e3779b97f4a7c15ull;
+  return (size_t) (hash >> 32) & (proof->size_binaries - 1);
+}
+
+static void
+enlarge_binaries (kissat * solver, proof * proof)
+{
+  const size_t old_size = proof->size_binaries;
+  const size_t new_size = old_size ? 2 * old_size : 1024;
+  binary_id *old_binaries = proof->binaries;
+  binary_id *new_binaries =
+    kissat_calloc_tagged (solver, MEMORY (proof),
+			  new_size, sizeof *new_binaries);
+  proof->binaries = new_binaries;
+  proof->size_binaries = new_size;
+  for (size_t i = 0; i < old_size; i++)
+    {
+      const binary_id *entry = old_binaries + i;
+      if (!entry->key)
+	continue;
+      size_t pos = hash_binary_key (proof, entry->key);
+      while (new_binaries[pos].key)
+	pos = (pos + 1) & (new_size - 1);
+      new_binaries[pos] = *entry;
+    }
+  kissat_free_tagged (solver, MEMORY (proof),
+		      old_binaries, old_size * sizeof *old_binaries);
+}
+
+static void
+insert_binary_id (kissat * solver, proof * proof,
+		  int a, int b, uint64_t id)
+{
+  if (2 * (proof->count_binaries + 1) > proof->size_binaries)
+    enlarge_binaries (solver, proof);
+  const uint64_t key = binary_key (a, b);
+  const size_t mask = proof->size_binaries - 1;
+  size_t pos = hash_binary_key (proof, key);
+  while (proof->binaries[pos].key)
+    pos = (pos + 1) & mask;
+  binary_id *entry = proof->binaries + pos;
+  entry->key = key;
+  entry->id = id;
+  proof->count_binaries++;
+}
+
+static binary_id *
+find_binary_id (proof * proof, int a, int b)
+{
+  if (!proof->size_binaries)
+    return 0;
+  const uint64_t key = binary_key (a, b);
+  const size_t mask = proof->size_binaries - 1;
+  size_t pos = hash_binary_key (proof, key);
+  for (;;)
+    {
+      binary_id *entry = proof->binaries + pos;
+      if (!entry->key)
+	return 0;
+      if (entry->key == key)
+	return entry;
+      pos = (pos + 1) & mask;
+    }
+}
+
+static uint64_t
+binary_clause_id (kissat * solver, proof * proof, unsigned a, unsigned b)
+{
+  const int elit_a = kissat_export_literal (solver, a);
+  const int elit_b = kissat_export_literal (solver, b);
+  const binary_id *entry = find_binary_id (proof, elit_a, elit_b);
+  assert (entry);
+  return entry->id;
+}
+
+static uint64_t
+remove_binary_id (kissat * solver, proof * proof, unsigned a, unsigned b)
+{
+  const int elit_a = kissat_export_literal (solver, a);
+  const int elit_b = kissat_export_literal (solver, b);
+  binary_id *entry = find_binary_id (proof, elit_a, elit_b);
+  assert (entry);
+  const uint64_t res = entry->id;
+  binary_id *binaries = proof->binaries;
+  const size_t mask = proof->size_binaries - 1;
+  size_t i = entry - binaries, j = i;
+  for (;;)
+    {
+      j = (j + 1) & mask;
+      if (!binaries[j].key)
+	break;
+      const size_t k = hash_binary_key (proof, binaries[j].key);
+      const bool stays = (i < j) ? (i < k && k <= j) : (i < k || k <= j);
+      if (stays)
+	continue;
+      binaries[i] = binaries[j];
+      i = j;
+    }
+  binaries[i].key = 0;
+  assert (proof->count_binaries);
+  proof->count_binaries--;
+  return res;
+}
+
+static void
+set_unit_id (kissat * solver, proof * proof, int elit, uint64_t id)
+{
+  const unsigned eidx = ABS (elit);
+  while (SIZE_STACK (proof->units) <= eidx)
+    PUSH_PROOF_STACK (proof->units, 0);
+  POKE_STACK (proof->units, eidx, id);
+}
+
+static uint64_t
+unit_id (kissat * solver, proof * proof, unsigned ilit)
+{
+  const int elit = kissat_export_literal (solver, ilit);
+  const unsigned eidx = ABS (elit);
+  assert (eidx < SIZE_STACK (proof->units));
+  const uint64_t res = PEEK_STACK (proof->units, eidx);
+  assert (res);
+  return res;
+}
+
+static uint64_t
+clause_id (kissat * solver, proof * proof, clause * c)
+{
+  if (c == &solver->conflict)
+    return binary_clause_id (solver, proof, c->lits[0], c->lits[1]);
+  assert (c->id);
+  return c->id;
+}
+
+static void
+register_lrat_clause (kissat * solver, proof * proof, uint64_t id)
+{
+  const size_t size = SIZE_STACK (proof->line);
+  const int *elits = BEGIN_STACK (proof->line);
+  if (size == 1)
+    set_unit_id (solver, proof, elits[0], id);
+  else if (size == 2)
+    insert_binary_id (solver, proof, elits[0], elits[1], id);
+  else
+    proof->last = id;
+}
+
+static uint64_t
+add_lrat_line (kissat * solver, proof * proof)
+{
+  const uint64_t id = next_derived_id (proof);
+  register_lrat_clause (solver, proof, id);
+  print_added_lrat_line (proof, id);
+  return id;
+}
+
+void
+kissat_reserve_clauses_in_proof (kissat * solver, uint64_t clauses)
+{
+  proof *proof = solver->proof;
+  assert (proof);
+  assert (proof->lrat);
+  if (proof->derived)
+    return;
+  LOG ("reserving %" PRIu64 " original clause identifiers", clauses);
+  proof->reserved = clauses;
+}
+
+uint64_t
+kissat_last_id_in_proof (kissat * solver)
+{
+  proof *proof = solver->proof;
+  assert (proof);
+  assert (proof->lrat);
+  assert (proof->last);
+  return proof->last;
+}
+
+void
+kissat_add_original_to_proof (kissat * solver, size_t size, int *elits)
+{
+  proof *proof = solver->proof;
+  assert (proof);
+  assert (proof->lrat);
+  const uint64_t id = ++proof->originals;
+  if (proof->derived && id > proof->reserved)
+    kissat_fatal ("original clause %" PRIu64 " exceeds the %" PRIu64
+		  " clause identifiers reserved for the LRAT proof",
+		  id, proof->reserved);
+  if (solver->inconsistent)
+    return;
+  if (solver->clause.satisfied || solver->clause.trivial)
+    {
+      print_deleted_lrat_line (proof, id);
+      return;
+    }
+  unsigneds *ilits = &solver->clause.lits;
+  const size_t isize = SIZE_STACK (*ilits);
+  if (solver->clause.shrink)
+    {
+      // Falsified literals are removed by resolution with root-level
+      // units (duplicated literals do not need any reason).
+      char *marks = 0;
+      for (size_t i = 0; i < size; i++)
+	{
+	  const unsigned eidx = ABS (elits[i]);
+	  if (eidx >= SIZE_STACK (proof->units))
+	    continue;
+	  const uint64_t unit = PEEK_STACK (proof->units, eidx);
+	  if (!unit)
+	    continue;
+	  while (SIZE_STACK (proof->marks) <= eidx)
+	    PUSH_PROOF_STACK (proof->marks, 0);
+	  marks = BEGIN_STACK (proof->marks);
+	  if (marks[eidx])
+	    continue;
+	  marks[eidx] = 1;
+	  PUSH_PROOF_STACK (proof->visited, eidx);
+	  PUSH_PROOF_STACK (proof->chain, unit);
+	}
+      for (all_stack (unsigned, eidx, proof->visited))
+	marks[eidx] = 0;
+      CLEAR_STACK (proof->visited);
+      PUSH_PROOF_STACK (proof->chain, id);
+      if (isize)
+	{
+	  import_internal_proof_literals (solver, proof, isize,
+					  BEGIN_STACK (*ilits));
+	  add_lrat_line (solver, proof);
+	  print_deleted_lrat_line (proof, id);
+	}
+    }
+  else if (isize)
+    {
+      import_internal_proof_literals (solver, proof, isize,
+				      BEGIN_STACK (*ilits));
+      register_lrat_clause (solver, proof, id);
+      CLEAR_STACK (proof->line);
+    }
+  else
+    PUSH_PROOF_STACK (proof->chain, id);
+}
+
+void
+kissat_add_propagated_unit_to_proof (kissat * solver, unsigned lit,
+				     bool binary, reference reason)
+{
+  proof *proof = solver->proof;
+  assert (proof);
+  assert (proof->lrat);
+  assert (EMPTY_STACK (proof->chain));
+  if (binary)
+    {
+      const unsigned other = reason;
+      PUSH_PROOF_STACK (proof->chain, unit_id (solver, proof, other));
+      PUSH_PROOF_STACK (proof->chain,
+			binary_clause_id (solver, proof, lit, other));
+    }
+  else
+    {
+      clause *c = kissat_dereference_clause (solver, reason);
+      for (all_literals_in_clause (other, c))
+	if (other != lit)
+	  PUSH_PROOF_STACK (proof->chain, unit_id (solver, proof, other));
+      PUSH_PROOF_STACK (proof->chain, clause_id (solver, proof, c));
+    }
+  import_internal_proof_literal (solver, proof, lit);
+  add_lrat_line (solver, proof);
+}
+
+void
+kissat_chain_conflict_in_proof (kissat * solver, clause * conflict)
+{
+  proof *proof = solver->proof;
+  assert (proof);
+  assert (proof->lrat);
+  assert (EMPTY_STACK (proof->chain));
+  for (all_literals_in_clause (lit, conflict))
+    PUSH_PROOF_STACK (proof->chain, unit_id (solver, proof, lit));
+  PUSH_PROOF_STACK (proof->chain, clause_id (solver, proof, conflict));
+}
+
+static uint64_t
+reason_id (kissat * solver, proof * proof, unsigned lit)
+{
+  assert (VALUE (lit) > 0);
+  assigned *a = ASSIGNED (lit);
+  const reference reason = ASSIGNED_REASON (a);
+  if (a->binary)
+    return binary_clause_id (solver, proof, lit, reason);
+  clause *c = kissat_dereference_clause (solver, reason);
+  return clause_id (solver, proof, c);
+}
+
+#define RESOLVED (1u << 31)
+
+// The chain of a learned clause is derived by a depth-first search over
+// the reasons of the falsified literals of the conflict, which are not
+// in the learned clause.  Reasons are listed in reverse topological
+// order (after all the reasons they depend on) followed by the conflict.
+
+void
+kissat_chain_learned_in_proof (kissat * solver, clause * conflict)
+{
+  proof *proof = solver->proof;
+  assert (proof);
+  assert (proof->lrat);
+  assert (EMPTY_STACK (proof->chain));
+  assert (EMPTY_STACK (proof->reasons));
+  assert (EMPTY_STACK (proof->work));
+  while (SIZE_STACK (proof->marks) < VARS)
+    PUSH_PROOF_STACK (proof->marks, 0);
+  char *marks = BEGIN_STACK (proof->marks);
+  for (all_stack (unsigned, lit, solver->clause.lits))
+    {
+      const unsigned idx = IDX (lit);
+      marks[idx] = 1;
+      PUSH_PROOF_STACK (proof->visited, idx);
+    }
+  for (all_literals_in_clause (lit, conflict))
+    PUSH_PROOF_STACK (proof->work, lit);
+  while (!EMPTY_STACK (proof->work))
+    {
+      const unsigned lit = POP_STACK (proof->work);
+      if (lit & RESOLVED)
+	{
+	  const unsigned not_lit = NOT (lit & ~RESOLVED);
+	  const uint64_t id = reason_id (solver, proof, not_lit);
+	  PUSH_PROOF_STACK (proof->reasons, id);
+	  continue;
+	}
+      const unsigned idx = IDX (lit);
+      if (marks[idx])
+	continue;
+      marks[idx] = 1;
+      PUSH_PROOF_STACK (proof->visited, idx);
+      assert (VALUE (lit) < 0);
+      assigned *a = solver->assigned + idx;
+      if (!a->level)
+	{
+	  PUSH_PROOF_STACK (proof->chain, unit_id (solver, proof, lit));
+	  continue;
+	}
+      assert (lit < RESOLVED);
+      PUSH_PROOF_STACK (proof->work, lit | RESOLVED);
+      const reference reason = ASSIGNED_REASON (a);
+      if (a->binary)
+	PUSH_PROOF_STACK (proof->work, reason);
+      else
+	{
+	  assert (reason != DECISION);
+	  const unsigned not_lit = NOT (lit);
+	  clause *c = kissat_dereference_clause (solver, reason);
+	  for (all_literals_in_clause (other, c))
+	    if (other != not_lit)
+	      PUSH_PROOF_STACK (proof->work, other);
+	}
+    }
+  for (all_stack (uint64_t, id, proof->reasons))
+    PUSH_PROOF_STACK (proof->chain, id);
+  PUSH_PROOF_STACK (proof->chain, clause_id (solver, proof, conflict));
+  for (all_stack (unsigned, idx, proof->visited))
+    marks[idx] = 0;
+  CLEAR_STACK (proof->visited);
+  CLEAR_STACK (proof->reasons);
+}
+
+uint64_t
+kissat_flush_literals_in_proof (kissat * solver, uint64_t id,
+				size_t size, unsigned *lits,
+				size_t old_size, unsigned *old_lits)
+{
+  proof *proof = solver->proof;
+  assert (proof);
+  assert (proof->lrat);
+  assert (EMPTY_STACK (proof->chain));
+  assert (id);
+  const value *values = solver->values;
+  for (size_t i = 0; i < old_size; i++)
+    {
+      const unsigned lit = old_lits[i];
+      if (values[lit] < 0 && !LEVEL (lit))
+	PUSH_PROOF_STACK (proof->chain, unit_id (solver, proof, lit));
+    }
+  PUSH_PROOF_STACK (proof->chain, id);
+  import_internal_proof_literals (solver, proof, size, lits);
+  const uint64_t res = add_lrat_line (solver, proof);
+  print_deleted_lrat_line (proof, id);
+  return res;
+}
+
+void
+kissat_delete_id_from_proof (kissat * solver, uint64_t id)
+{
+  proof *proof = solver->proof;
+  assert (proof);
+  assert (proof->lrat);
+  print_deleted_lrat_line (proof, id);
+}
+
+#endif
+
+static void
+add_proof_line (kissat * solver, proof * proof)
+{
+#ifdef LRAT
+  if (proof->lrat)
+    {
+      add_lrat_line (solver, proof);
+      return;
+    }
+#else
+  (void) solver;
+#endif
+  print_added_proof_line (proof);
+}
+
 void
 kissat_add_binary_to_proof (kissat * solver, unsigned a, unsigned b)
 {
   proof *proof = solver->proof;
   assert (proof);
   import_internal_proof_binary (solver, proof, a, b);
-  print_added_proof_line (proof);
+  add_proof_line (solver, proof);
 }
 
 void
@@ -215,7 +969,11 @@ kissat_add_clause_to_proof (kissat * solver, clause * c)
   proof *proof = solver->proof;
   assert (proof);
   import_proof_clause (solver, proof, c);
-  print_added_proof_line (proof);
+  add_proof_line (solver, proof);
+#ifdef LRAT
+  if (proof->lrat)
+    c->id = proof->last;
+#endif
 }
 
 void
@@ -224,7 +982,7 @@ kissat_add_empty_to_proof (kissat * solver)
   proof *proof = solver->proof;
   assert (proof);
   assert (EMPTY_STACK (proof->line));
-  print_added_proof_line (proof);
+  add_proof_line (solver, proof);
 }
 
 void
@@ -233,7 +991,7 @@ kissat_add_lits_to_proof (kissat * solver, size_t size, unsigned *ilits)
   proof *proof = solver->proof;
   assert (proof);
   import_internal_proof_literals (solver, proof, size, ilits);
-  print_added_proof_line (proof);
+  add_proof_line (solver, proof);
 }
 
 void
@@ -243,7 +1001,7 @@ kissat_add_unit_to_proof (kissat * solver, unsigned ilit)
   assert (proof);
   assert (EMPTY_STACK (proof->line));
   import_internal_proof_literal (solver, proof, ilit);
-  print_added_proof_line (proof);
+  add_proof_line (solver, proof);
 }
 
 void
@@ -252,6 +1010,9 @@ kissat_shrink_clause_in_proof (kissat * solver, clause * c,
 {
   proof *proof = solver->proof;
   const value *values = solver->values;
+#ifdef LRAT
+  assert (!proof->lrat);
+#endif
   assert (EMPTY_STACK (proof->line));
   for (all_literals_in_clause (ilit, c))
     {
@@ -271,6 +1032,13 @@ kissat_delete_binary_from_proof (kissat * solver, unsigned a, unsigned b)
 {
   proof *proof = solver->proof;
   assert (proof);
+#ifdef LRAT
+  if (proof->lrat)
+    {
+      print_deleted_lrat_line (proof, remove_binary_id (solver, proof, a, b));
+      return;
+    }
+#endif
   import_internal_proof_binary (solver, proof, a, b);
   print_delete_proof_line (proof);
 }
@@ -280,6 +1048,13 @@ kissat_delete_clause_from_proof (kissat * solver, clause * c)
 {
   proof *proof = solver->proof;
   assert (proof);
+#ifdef LRAT
+  if (proof->lrat)
+    {
+      print_deleted_lrat_line (proof, c->id);
+      return;
+    }
+#endif
   import_proof_clause (solver, proof, c);
   print_delete_proof_line (proof);
 }
@@ -289,6 +1064,9 @@ kissat_delete_external_from_proof (kissat * solver, size_t size, int *elits)
 {
   proof *proof = solver->proof;
   assert (proof);
+#ifdef LRAT
+  assert (!proof->lrat);
+#endif
   import_external_proof_literals (solver, proof, size, elits);
   print_delete_proof_line (proof);
 }
@@ -299,6 +1077,9 @@ kissat_delete_internal_from_proof (kissat * solver,
 {
   proof *proof = solver->proof;
   assert (proof);
+#ifdef LRAT
+  assert (!proof->lrat);
+#endif
   import_internal_proof_literals (solver, proof, size, ilits);
   print_delete_proof_line (proof);
 }
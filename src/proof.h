@@ -3,7 +3,10 @@
 
 #ifndef NPROOFS
 
+#include "reference.h"
+
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 
 typedef struct proof proof;
@@ -11,7 +14,8 @@ typedef struct proof proof;
 struct clause;
 struct file;
 
-void kissat_init_proof (struct kissat *, struct file *, bool binary);
+void kissat_init_proof (struct kissat *, struct file *,
+			bool binary, bool lrat);
 void kissat_release_proof (struct kissat *);
 
 #ifndef QUIET
@@ -90,8 +94,64 @@ do { \
                                        SIZE_STACK (S), BEGIN_STACK (S)); \
 } while (0)
 
+#ifdef LRAT
+
+// In LRAT proofs each clause has an identifier.  Original clauses are
+// numbered in the order they are added.  Derived clauses are numbered
+// after the original clauses reserved through the DIMACS header, which
+// is necessary, since units are already derived while parsing.  Each
+// derived clause lists the identifiers of the clauses which make it
+// follow by unit propagation (its 'chain').  This chain has to be
+// prepared with 'CHAIN_..._IN_PROOF' before learned and empty clauses
+// are added to the proof, while units derived by root-level propagation
+// are added through 'kissat_add_propagated_unit_to_proof'.  Techniques
+// which can not provide chains are disabled while tracing LRAT proofs.
+
+void kissat_reserve_clauses_in_proof (struct kissat *, uint64_t);
+void kissat_add_original_to_proof (struct kissat *, size_t, int *);
+uint64_t kissat_last_id_in_proof (struct kissat *);
+
+void kissat_add_propagated_unit_to_proof (struct kissat *, unsigned lit,
+					  bool binary, reference reason);
+
+void kissat_chain_conflict_in_proof (struct kissat *, struct clause *);
+void kissat_chain_learned_in_proof (struct kissat *, struct clause *);
+
+uint64_t kissat_flush_literals_in_proof (struct kissat *, uint64_t id,
+					 size_t, unsigned *,
+					 size_t, unsigned *);
+void kissat_delete_id_from_proof (struct kissat *, uint64_t);
+
+#define LRAT_PROOF (solver->lrat)
+
+#define CHAIN_CONFLICT_IN_PROOF(CONFLICT) \
+do { \
+  if (solver->lrat) \
+    kissat_chain_conflict_in_proof (solver, (CONFLICT)); \
+} while (0)
+
+#define CHAIN_LEARNED_IN_PROOF(CONFLICT) \
+do { \
+  if (solver->lrat) \
+    kissat_chain_learned_in_proof (solver, (CONFLICT)); \
+} while (0)
+
 #else
 
+#define LRAT_PROOF false
+
+#define CHAIN_CONFLICT_IN_PROOF(...) do { } while (0)
+#define CHAIN_LEARNED_IN_PROOF(...) do { } while (0)
+
+#endif
+
+#else
+
+#define LRAT_PROOF false
+
+#define CHAIN_CONFLICT_IN_PROOF(...) do { } while (0)
+#define CHAIN_LEARNED_IN_PROOF(...) do { } while (0)
+
 #define ADD_BINARY_TO_PROOF(...) do { } while (0)
 #define ADD_CLAUSE_TO_PROOF(...) do { } while (0)
 #define ADD_LITS_TO_PROOF(...) do { } while (0)
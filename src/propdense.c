@@ -50,10 +50,10 @@ non_watching_propagate_literal (kissat * solver,
 	}
       else
 	{
-	  const reference ref = watch.large.ref;
+	  const reference ref = LARGE_WATCH_REF (watch);
 	  assert (ref < SIZE_STACK (solver->arena));
 	  clause *c = (clause *) (arena + ref);
-	  assert (c->size > 2);
+	  assert (CLAUSE_SIZE (c) > 2);
 	  assert (!c->redundant);
 	  ticks++;
 	  if (c->garbage)
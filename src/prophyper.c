@@ -29,12 +29,19 @@ watch_hyper_delayed (kissat * solver, unsigneds * delayed)
 		     "watching blocking %s in %s",
 		     LOGLIT (lit), LOGLIT (watch.binary.lit));
 	  assert (lit < LITS);
-	  PUSH_WATCHES (*lit_watches, watch);
+	  kissat_push_binary_watch (solver, lit_watches,
+				    true, true, watch.binary.lit);
 	}
       else
 	{
 	  assert (d != end_delayed);
+#ifdef HUGE
+	  reference ref = *d++;
+	  assert (d != end_delayed);
+	  ref |= (reference) * d++ << 32;
+#else
 	  const reference ref = *d++;
+#endif
 	  const unsigned blocking = watch.blocking.lit;
 	  LOGREF (ref, "watching %s blocking %s in", LOGLIT (lit),
 		  LOGLIT (blocking));
@@ -53,6 +60,33 @@ delay_watching_hyper (kissat * solver, unsigneds * delayed,
   PUSH_STACK (*delayed, watch.raw);
 }
 
+static inline bool
+hyper_binary_resolve (kissat * solver, value * values, assigned * assigned,
+		      unsigneds * delayed, unsigned unit, clause * c)
+{
+  const unsigned dom = kissat_find_dominator (solver, unit, c);
+  if (dom == INVALID_LIT)
+    return false;
+
+  LOGBINARY (dom, unit, "hyper binary resolvent");
+
+  INC (hyper_binary_resolved);
+  INC (clauses_added);
+
+  INC (hyper_binaries);
+  INC (clauses_redundant);
+
+  CHECK_AND_ADD_BINARY (dom, unit);
+  ADD_BINARY_TO_PROOF (dom, unit);
+
+  kissat_assign_binary (solver, values, assigned, true, unit, dom);
+
+  delay_watching_hyper (solver, delayed, dom, unit);
+  delay_watching_hyper (solver, delayed, unit, dom);
+
+  return true;
+}
+
 #define HYPER_PROPAGATION
 #define PROPAGATE_LITERAL large_propagate_literal
 #define PROPAGATION_TYPE "large"
@@ -84,10 +118,7 @@ binary_propagate_literal (kissat * solver, unsigned lit)
     {
       watch head = *p++;
       if (!head.type.binary)
-	{
-	  p++;
-	  continue;
-	}
+	break;
       const unsigned other = head.binary.lit;
       assert (VALID_INTERNAL_LITERAL (other));
       const value other_value = values[other];
@@ -1,13 +1,22 @@
 #include "inline.h"
+#include "simd.h"
 
 #ifndef HYPER_PROPAGATION
 
+// Watches moved during propagating a literal are delayed and then pushed
+// to the watch vectors of their new watched literals.  The number of such
+// pushes which had to move a non-empty watch vector to enlarge it is
+// counted in 'delayed_moved'.
+
 static inline void
 kissat_watch_large_delayed (kissat * solver, unsigneds * delayed)
 {
   const unsigned *end_delayed = END_STACK (*delayed);
   const unsigned *d = BEGIN_STACK (*delayed);
   watches *all_watches = solver->watches;
+#ifndef NMETRICS
+  uint64_t count = 0;
+#endif
   while (d != end_delayed)
     {
       const unsigned lit = *d++;
@@ -16,12 +25,29 @@ kissat_watch_large_delayed (kissat * solver, unsigneds * delayed)
       assert (!watch.type.binary);
       watches *lit_watches = all_watches + lit;
       assert (d != end_delayed);
+#ifdef HUGE
+      reference ref = *d++;
+      assert (d != end_delayed);
+      ref |= (reference) * d++ << 32;
+#else
       const reference ref = *d++;
+#endif
       const unsigned blocking = watch.blocking.lit;
       LOGREF (ref, "watching %s blocking %s in", LOGLIT (lit),
               LOGLIT (blocking));
+#ifndef NMETRICS
+      const vector old_watches = *lit_watches;
+#endif
       kissat_push_blocking_watch (solver, lit_watches, blocking, ref);
+#ifndef NMETRICS
+      if (old_watches.size && old_watches.offset != lit_watches->offset)
+	INC (delayed_moved);
+      count++;
+#endif
     }
+#ifndef NMETRICS
+  ADD (delayed_watches, count);
+#endif
   CLEAR_STACK (*delayed);
 }
 
@@ -57,9 +83,44 @@ kissat_delay_watching_large (kissat * solver, unsigneds * delayed,
   const watch watch = kissat_blocking_watch (other);
   PUSH_STACK (*delayed, lit);
   PUSH_STACK (*delayed, watch.raw);
-  PUSH_STACK (*delayed, ref);
+  PUSH_STACK (*delayed, (unsigned) ref);
+#ifdef HUGE
+  PUSH_STACK (*delayed, (unsigned) (ref >> 32));
+#endif
 }
 
+static inline unsigned *
+kissat_find_non_false_literal (kissat * solver, const value * values,
+                               unsigned *begin, unsigned *end)
+{
+#ifdef KISSAT_HAS_AVX2
+  if (end - begin >= SIMD_REPLACEMENT_LENGTH &&
+      solver->avx2 && GET_OPTION (simd))
+    return kissat_avx2_find_non_false (values, begin, end);
+#else
+  (void) solver;
+#endif
+  unsigned *p = begin;
+  while (p != end && values[*p] < 0)
+    p++;
+  return p;
+}
+
+#ifdef PACKED_CLAUSES
+
+static inline unsigned
+kissat_find_non_false_packed_literal (const value * values,
+                                      const clause * c,
+                                      unsigned begin, unsigned end)
+{
+  unsigned i = begin;
+  while (i != end && values[kissat_packed_literal (c, i)] < 0)
+    i++;
+  return i;
+}
+
+#endif
+
 static inline clause *
 PROPAGATE_LITERAL (kissat * solver,
 #if defined(HYPER_PROPAGATION) || defined(PROBING_PROPAGATION)
@@ -89,36 +150,52 @@ PROPAGATE_LITERAL (kissat * solver,
 
   clause *res = 0;
 
-  while (p != end_watches)
+  while (q != end_watches)
     {
-      const watch head = *q++ = *p++;
-      const unsigned blocking = head.blocking.lit;
+      const watch head = *q;
+      if (!head.type.binary)
+        break;
+      q++;
+      const unsigned blocking = head.binary.lit;
       assert (VALID_INTERNAL_LITERAL (blocking));
       const value blocking_value = values[blocking];
-      if (head.type.binary)
+      if (blocking_value > 0)
+        continue;
+      const bool redundant = head.binary.redundant;
+      if (blocking_value < 0)
         {
-          if (blocking_value > 0)
-            continue;
-          const bool redundant = head.binary.redundant;
-          if (blocking_value < 0)
-            {
-              res = kissat_binary_conflict (solver, redundant,
-                                            not_lit, blocking);
-              break;
-            }
-          else
-            {
-              assert (!blocking_value);
-              kissat_assign_binary (solver, values, assigned,
-                                    redundant, blocking, not_lit);
-            }
+          res = kissat_binary_conflict (solver, redundant, not_lit, blocking);
+          break;
         }
-      else
+      assert (!blocking_value);
+      kissat_assign_binary (solver, values, assigned,
+                            redundant, blocking, not_lit);
+    }
+  p = q;
+
+  while (!res && p != end_watches)
+    {
+      const watch head = *q++ = *p++;
+      assert (!head.type.binary);
+      if (head.type.ternary)
         {
-          const watch tail = *q++ = *p++;
-          if (blocking_value > 0)
+          const watch middle = *q++ = *p++;
+          for (unsigned i = 0; i < LARGE_WATCH_SIZE; i++)
+            *q++ = *p++;
+          const unsigned first = head.ternary.lit;
+          assert (VALID_INTERNAL_LITERAL (first));
+          const value first_value = values[first];
+          if (first_value > 0)
+            continue;
+          const unsigned second = middle.blocking.lit;
+          assert (VALID_INTERNAL_LITERAL (second));
+          const value second_value = values[second];
+          if (second_value > 0)
+            continue;
+          if (!first_value && !second_value)
             continue;
-          const reference ref = tail.raw;
+          const reference ref =
+            kissat_large_watch_reference (q - LARGE_WATCH_SIZE);
           assert (ref < SIZE_STACK (solver->arena));
           clause *c = (clause *) (arena + ref);
 #if defined(HYPER_PROPAGATION) || defined(PROBING_PROPAGATION)
@@ -128,117 +205,165 @@ PROPAGATE_LITERAL (kissat * solver,
           ticks++;
           if (c->garbage)
             {
-              q -= 2;
+              q -= 2 + LARGE_WATCH_SIZE;
               continue;
             }
-          unsigned *lits = BEGIN_LITS (c);
-          const unsigned other = lits[0] ^ lits[1] ^ not_lit;
-          assert (lits[0] != lits[1]);
-          assert (VALID_INTERNAL_LITERAL (other));
-          assert (not_lit != other);
-          assert (lit != other);
-          const value other_value = values[other];
-          if (other_value > 0)
-            q[-2].blocking.lit = other;
-          else
+          assert (CLAUSE_SIZE (c) == 3);
+          if (first_value && second_value)
             {
-              const unsigned *end_lits = lits + c->size;
-              unsigned *searched = lits + c->searched;
-              assert (c->lits + 2 <= searched);
-              assert (searched < end_lits);
-              unsigned *r, replacement = INVALID_LIT;
-              value replacement_value = -1;
-              for (r = searched; r != end_lits; r++)
-                {
-                  replacement = *r;
-                  assert (VALID_INTERNAL_LITERAL (replacement));
-                  replacement_value = values[replacement];
-                  if (replacement_value >= 0)
-                    break;
-                }
-              if (replacement_value < 0)
+              assert (first_value < 0);
+              assert (second_value < 0);
+              LOGREF (ref, "conflicting");
+              res = c;
+              break;
+            }
+          const unsigned unit = first_value ? second : first;
+#ifdef HYPER_PROPAGATION
+          if (!hyper || !hyper_binary_resolve (solver, values, assigned,
+                                               delayed, unit, c))
+#endif
+            kissat_assign_reference (solver, values,
+                                     assigned, unit, ref, c);
+          continue;
+        }
+      const unsigned blocking = head.blocking.lit;
+      assert (VALID_INTERNAL_LITERAL (blocking));
+      const value blocking_value = values[blocking];
+      for (unsigned i = 0; i < LARGE_WATCH_SIZE; i++)
+        *q++ = *p++;
+      if (blocking_value > 0)
+        continue;
+      const reference ref =
+        kissat_large_watch_reference (q - LARGE_WATCH_SIZE);
+      assert (ref < SIZE_STACK (solver->arena));
+      clause *c = (clause *) (arena + ref);
+#if defined(HYPER_PROPAGATION) || defined(PROBING_PROPAGATION)
+      if (c == ignore)
+        continue;
+#endif
+      ticks++;
+      if (c->garbage)
+        {
+          q -= 1 + LARGE_WATCH_SIZE;
+          continue;
+        }
+      unsigned *lits = BEGIN_LITS (c);
+      const unsigned other = lits[0] ^ lits[1] ^ not_lit;
+      assert (lits[0] != lits[1]);
+      assert (VALID_INTERNAL_LITERAL (other));
+      assert (not_lit != other);
+      assert (lit != other);
+      const value other_value = values[other];
+      if (other_value > 0)
+        q[-1 - LARGE_WATCH_SIZE].blocking.lit = other;
+      else
+        {
+          unsigned replacement = INVALID_LIT;
+          value replacement_value = -1;
+          unsigned *r = 0;
+#ifdef PACKED_CLAUSES
+          unsigned pos = 0;
+          if (c->packed)
+            {
+              INC (packed_ticks);
+              const unsigned size = c->size;
+              const unsigned searched = c->searched;
+              assert (2 <= searched);
+              assert (searched < size);
+              pos = kissat_find_non_false_packed_literal (values, c,
+                                                          searched, size);
+              if (pos == size)
                 {
-                  for (r = lits + 2; r != searched; r++)
-                    {
-                      replacement = *r;
-                      assert (VALID_INTERNAL_LITERAL (replacement));
-                      replacement_value = values[replacement];
-                      if (replacement_value >= 0)
-                        break;
-                    }
+                  pos = kissat_find_non_false_packed_literal (values, c,
+                                                              2, searched);
+                  if (pos == searched)
+                    pos = size;
                 }
-
-              if (replacement_value >= 0)
-                c->searched = r - c->lits;
-
-              if (replacement_value > 0)
+              if (pos != size)
                 {
-                  assert (replacement != INVALID_LIT);
-                  q[-2].blocking.lit = replacement;
+                  replacement = kissat_packed_literal (c, pos);
+                  assert (VALID_INTERNAL_LITERAL (replacement));
+                  replacement_value = values[replacement];
+                  assert (replacement_value >= 0);
+                  c->searched = pos;
                 }
-              else if (!replacement_value)
+            }
+          else
+#endif
+            {
+              unsigned *end_lits = lits + CLAUSE_SIZE (c);
+              unsigned *searched =
+                SHORT_CLAUSE (c) ? lits + 2 : lits + c->searched;
+              assert (lits + 2 <= searched);
+              assert (searched < end_lits);
+              r = kissat_find_non_false_literal (solver, values,
+                                                 searched, end_lits);
+              if (r == end_lits)
                 {
-                  assert (replacement != INVALID_LIT);
-                  LOGREF (ref, "unwatching %s in", LOGLIT (not_lit));
-                  q -= 2;
-                  lits[0] = other;
-                  lits[1] = replacement;
-                  assert (lits[0] != lits[1]);
-                  *r = not_lit;
-                  kissat_delay_watching_large (solver, delayed,
-                                               replacement, other, ref);
-                  ticks++;
+                  r = kissat_find_non_false_literal (solver, values,
+                                                     lits + 2, searched);
+                  if (r == searched)
+                    r = end_lits;
                 }
-              else if (other_value)
+              if (r != end_lits)
                 {
-                  assert (replacement_value < 0);
-                  assert (blocking_value < 0);
-                  assert (other_value < 0);
-                  LOGREF (ref, "conflicting");
-                  res = c;
-                  break;
+                  replacement = *r;
+                  assert (VALID_INTERNAL_LITERAL (replacement));
+                  replacement_value = values[replacement];
+                  assert (replacement_value >= 0);
+                  if (!SHORT_CLAUSE (c))
+                    c->searched = r - lits;
                 }
-#ifdef HYPER_PROPAGATION
-              else if (hyper)
-                {
-                  assert (replacement_value < 0);
-                  unsigned dom = kissat_find_dominator (solver, other, c);
-                  if (dom != INVALID_LIT)
-                    {
-                      LOGBINARY (dom, other, "hyper binary resolvent");
-
-                      INC (hyper_binary_resolved);
-                      INC (clauses_added);
-
-                      INC (hyper_binaries);
-                      INC (clauses_redundant);
-
-                      CHECK_AND_ADD_BINARY (dom, other);
-                      ADD_BINARY_TO_PROOF (dom, other);
-
-                      kissat_assign_binary (solver, values, assigned,
-                                            true, other, dom);
-
-                      delay_watching_hyper (solver, delayed, dom, other);
-                      delay_watching_hyper (solver, delayed, other, dom);
-
-                      kissat_delay_watching_large (solver, delayed,
-                                                   not_lit, other, ref);
+            }
 
-                      LOGREF (ref, "unwatching %s in", LOGLIT (not_lit));
-                      q -= 2;
-                    }
-                  else
-                    kissat_assign_reference (solver, values,
-                                             assigned, other, ref, c);
-                }
-#endif
+          if (replacement_value > 0)
+            {
+              assert (replacement != INVALID_LIT);
+              q[-1 - LARGE_WATCH_SIZE].blocking.lit = replacement;
+            }
+          else if (!replacement_value)
+            {
+              assert (replacement != INVALID_LIT);
+              LOGREF (ref, "unwatching %s in", LOGLIT (not_lit));
+              q -= 1 + LARGE_WATCH_SIZE;
+              lits[0] = other;
+              lits[1] = replacement;
+              assert (lits[0] != lits[1]);
+#ifdef PACKED_CLAUSES
+              if (c->packed)
+                kissat_set_packed_literal (c, pos, not_lit);
               else
-                {
-                  assert (replacement_value < 0);
-                  kissat_assign_reference (solver, values,
-                                           assigned, other, ref, c);
-                }
+#endif
+                *r = not_lit;
+              kissat_delay_watching_large (solver, delayed,
+                                           replacement, other, ref);
+              ticks++;
+            }
+          else if (other_value)
+            {
+              assert (replacement_value < 0);
+              assert (blocking_value < 0);
+              assert (other_value < 0);
+              LOGREF (ref, "conflicting");
+              res = c;
+              break;
+            }
+#ifdef HYPER_PROPAGATION
+          else if (hyper && hyper_binary_resolve (solver, values, assigned,
+                                                  delayed, other, c))
+            {
+              assert (replacement_value < 0);
+              kissat_delay_watching_large (solver, delayed,
+                                           not_lit, other, ref);
+              LOGREF (ref, "unwatching %s in", LOGLIT (not_lit));
+              q -= 1 + LARGE_WATCH_SIZE;
+            }
+#endif
+          else
+            {
+              assert (replacement_value < 0);
+              kissat_assign_reference (solver, values,
+                                       assigned, other, ref, c);
             }
         }
     }
@@ -54,12 +54,108 @@ update_consistently_assigned (kissat * solver)
     LOG ("keeping consistently assigned %u", assigned);
 }
 
+// Prefetching runs ahead of propagation on the trail in two stages.  The
+// watch vectors of literals up to twice the lookahead distance ahead are
+// requested first.  When propagation is one lookahead distance away, the
+// (hopefully cached) watches are scanned and the headers of large clauses
+// which are not already blocked are requested.  Ternary watches do not
+// need the arena.  Scanning watches twice does not pay off if the arena
+// fits into the cache anyhow, so the second stage is restricted to large
+// arenas.  Prefetching is a pure hint and thus does not change the
+// 'ticks' used to limit the effort of search and simplification.
+
+#define MAX_PREFETCHED_CLAUSES 8
+#define MAX_SCANNED_WATCHES 32
+#define MIN_PREFETCHED_ARENA_BYTES (1u << 23)
+
+typedef struct prefetcher prefetcher;
+
+struct prefetcher
+{
+  bool arena;
+  unsigned lookahead;
+  unsigned watches;
+  unsigned clauses;
+};
+
+static inline void
+prefetch_watches (kissat * solver, unsigned lit)
+{
+  const unsigned not_lit = NOT (lit);
+  watches *watches = &WATCHES (not_lit);
+  if (watches->size)
+    __builtin_prefetch (BEGIN_WATCHES (*watches), 0, 1);
+}
+
+static inline void
+prefetch_clauses (kissat * solver, unsigned lit)
+{
+  const unsigned not_lit = NOT (lit);
+  watches *watches = &WATCHES (not_lit);
+  const watch *p = BEGIN_WATCHES (*watches);
+  const watch *end = END_WATCHES (*watches);
+  while (p != end && p->type.binary)
+    p++;
+  const value *values = solver->values;
+  const word *arena = BEGIN_STACK (solver->arena);
+  unsigned prefetched = 0, scanned = 0;
+  while (p != end && prefetched < MAX_PREFETCHED_CLAUSES &&
+         scanned++ < MAX_SCANNED_WATCHES)
+    {
+      const watch head = *p;
+      if (head.type.ternary)
+        {
+          p += 2 + LARGE_WATCH_SIZE;
+          continue;
+        }
+      const reference ref = kissat_large_watch_reference (p + 1);
+      p += 1 + LARGE_WATCH_SIZE;
+      if (values[head.blocking.lit] > 0)
+        continue;
+      __builtin_prefetch (arena + ref, 0, 1);
+      prefetched++;
+    }
+}
+
+static inline void
+prefetch_ahead (kissat * solver, prefetcher * prefetcher)
+{
+  const unsigned *trail = BEGIN_STACK (solver->trail);
+  const unsigned size = SIZE_STACK (solver->trail);
+  const unsigned propagated = solver->propagated;
+  const unsigned lookahead = prefetcher->lookahead;
+
+  unsigned limit = propagated + 2 * lookahead;
+  if (limit > size)
+    limit = size;
+  while (prefetcher->watches < limit)
+    prefetch_watches (solver, trail[prefetcher->watches++]);
+
+  if (!prefetcher->arena)
+    return;
+
+  limit = propagated + lookahead;
+  if (limit > size)
+    limit = size;
+  if (prefetcher->clauses < propagated)
+    prefetcher->clauses = propagated;
+  while (prefetcher->clauses < limit)
+    prefetch_clauses (solver, trail[prefetcher->clauses++]);
+}
+
 static clause *
 search_propagate (kissat * solver)
 {
+  prefetcher prefetcher;
+  const size_t arena_bytes = SIZE_STACK (solver->arena) * sizeof (word);
+  prefetcher.arena = arena_bytes >= MIN_PREFETCHED_ARENA_BYTES;
+  prefetcher.lookahead = GET_OPTION (prefetch);
+  prefetcher.watches = prefetcher.clauses = solver->propagated;
   clause *res = 0;
   while (!res && solver->propagated < SIZE_STACK (solver->trail))
     {
+      if (prefetcher.lookahead)
+        prefetch_ahead (solver, &prefetcher);
       const unsigned lit = PEEK_STACK (solver->trail, solver->propagated);
       res = search_propagate_literal (solver, lit);
       solver->propagated++;
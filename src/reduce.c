@@ -22,12 +22,22 @@ kissat_reducing (kissat * solver)
   return true;
 }
 
+bool
+kissat_memory_pressure (kissat * solver)
+{
+  if (!solver->limited.memory)
+    return false;
+  const uint64_t limit = solver->limits.memory.bytes;
+  const uint64_t pressure = limit / 100 * GET_OPTION (memorypressure);
+  return solver->allocated >= pressure;
+}
+
 typedef struct reducible reducible;
 
 struct reducible
 {
   uint64_t rank;
-  unsigned ref;
+  reference ref;
 };
 
 #define RANK_REDUCIBLE(RED) \
@@ -79,7 +89,7 @@ collect_reducibles (kissat * solver, reducibles * reds, reference start_ref)
         continue;
       if (c->hyper)
         {
-          assert (c->size == 3);
+          assert (CLAUSE_SIZE (c) == 3);
           if (c->used)
             {
 #ifndef QUIET
@@ -107,7 +117,7 @@ collect_reducibles (kissat * solver, reducibles * reds, reference start_ref)
       assert (!c->garbage);
       assert (kissat_clause_in_arena (solver, c));
       reducible red;
-      const uint64_t negative_size = (1u << LD_MAX_VAR) - c->size;
+      const uint64_t negative_size = (1u << LD_MAX_VAR) - CLAUSE_SIZE (c);
       const uint64_t negative_glue = (1u << LD_MAX_GLUE) - c->glue;
       red.rank = negative_size | (negative_glue << LD_MAX_VAR);
       red.ref = (word *) c - arena;
@@ -145,10 +155,14 @@ sort_reducibles (kissat * solver, reducibles * reds)
 }
 
 static void
-mark_less_useful_clauses_as_garbage (kissat * solver, reducibles * reds)
+mark_less_useful_clauses_as_garbage (kissat * solver, reducibles * reds,
+                                     bool pressure)
 {
   const size_t size = SIZE_STACK (*reds);
-  size_t target = size * (GET_OPTION (reducefraction) / 100.0);
+  unsigned fraction = GET_OPTION (reducefraction);
+  if (pressure)
+    fraction = (fraction + 100) / 2;
+  size_t target = size * (fraction / 100.0);
 #ifndef QUIET
   statistics *statistics = &solver->statistics;
   const size_t clauses =
@@ -214,7 +228,12 @@ kissat_reduce (kissat * solver)
                 " conflicts", solver->limits.reduce.conflicts, CONFLICTS);
   force_restart_before_reduction (solver);
   bool compact = compacting (solver);
-  reference start = compact ? 0 : solver->first_reducible;
+  const bool pressure = kissat_memory_pressure (solver);
+  if (pressure)
+    kissat_phase (solver, "reduce", GET (reductions),
+                  "aggressive reduction under memory pressure");
+  const bool full = compact || pressure || GET_OPTION (reorder);
+  reference start = full ? 0 : solver->first_reducible;
   if (start != INVALID_REF)
     {
 #ifndef QUIET
@@ -235,7 +254,7 @@ kissat_reduce (kissat * solver)
           if (collect_reducibles (solver, &reds, start))
             {
               sort_reducibles (solver, &reds);
-              mark_less_useful_clauses_as_garbage (solver, &reds);
+              mark_less_useful_clauses_as_garbage (solver, &reds, pressure);
               RELEASE_STACK (reds);
               kissat_sparse_collect (solver, compact, start);
             }
@@ -249,6 +268,10 @@ kissat_reduce (kissat * solver)
     }
   else
     kissat_phase (solver, "reduce", GET (reductions), "nothing to reduce");
+  if (pressure && solver->vectors.usable)
+    kissat_defrag_vectors (solver, &solver->vectors, LITS, solver->watches);
+  else
+    kissat_defrag_watches_step (solver);
   UPDATE_CONFLICT_LIMIT (reduce, reductions, NDIVLOGN, false);
   REPORT (0, '-');
   STOP (reduce);
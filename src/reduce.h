@@ -8,4 +8,6 @@ struct kissat;
 bool kissat_reducing (struct kissat *);
 int kissat_reduce (struct kissat *);
 
+bool kissat_memory_pressure (struct kissat *);
+
 #endif
@@ -3,12 +3,28 @@
 
 #include "stack.h"
 
+#ifdef HUGE
+
+#include <inttypes.h>
+#include <stdint.h>
+
+typedef uint64_t reference;
+
+#define LD_MAX_REF 48
+#define INVALID_REF UINT64_MAX
+#define REFERENCE_FORMAT PRIu64
+
+#else
+
 typedef unsigned reference;
 
 #define LD_MAX_REF 31
-#define MAX_REF (((reference)1 << LD_MAX_REF)-1)
-
 #define INVALID_REF UINT_MAX
+#define REFERENCE_FORMAT "u"
+
+#endif
+
+#define MAX_REF (((reference)1 << LD_MAX_REF)-1)
 
 // *INDENT-OFF*
 typedef STACK (reference) references;
@@ -203,7 +203,7 @@ kissat_rephase (kissat * solver)
   kissat_backtrack_propagate_and_flush_trail (solver);
   assert (!solver->inconsistent);
   kissat_autarky (solver);
-  if (TERMINATED (10))
+  if (INTERRUPTED (10))
     return;
   START (rephase);
   INC (rephased);
@@ -12,12 +12,28 @@
 #define MB \
   (kissat_current_resident_set_size ()/(double)(1<<20))
 
+#ifndef NMETRICS
+
+#define MEMORY_MB(NAME) \
+  (solver->memories.NAME.current/(double)(1<<20))
+
+#define MEMORY_REPORTS \
+REP("arena", "2.0f", MEMORY_MB (arena)) \
+REP("watches", "2.0f", MEMORY_MB (watches))
+
+#else
+
+#define MEMORY_REPORTS
+
+#endif
+
 #define REMAINING_VARIABLES \
   kissat_percent (solver->active, SIZE_STACK(solver->import))
 
 #define REPORTS \
 REP("seconds", "5.2f", kissat_time (solver)) \
 REP("MB", "2.0f", MB) \
+MEMORY_REPORTS \
 REP("level", ".0f", AVERAGE (level)) \
 REP("reductions", "2" PRIu64, statistics->reductions) \
 REP("restarts", "2" PRIu64, statistics->restarts) \
@@ -5,40 +5,45 @@
 
 #include <limits.h>
 
-#define NREALLOC_GENERIC(TYPE, NAME, ELEMENTS_PER_BLOCK) \
+#define NREALLOC_GENERIC(M, TYPE, NAME, ELEMENTS_PER_BLOCK) \
 do { \
   const size_t block_size = sizeof (TYPE); \
   solver->NAME = \
-    kissat_nrealloc (solver, solver->NAME, old_size, new_size, \
-                     ELEMENTS_PER_BLOCK * block_size); \
+    kissat_nrealloc_tagged (solver, (M), solver->NAME, old_size, new_size, \
+                            ELEMENTS_PER_BLOCK * block_size); \
 } while (0)
 
-#define CREALLOC_GENERIC(TYPE, NAME, ELEMENTS_PER_BLOCK) \
+#define CREALLOC_GENERIC(M, TYPE, NAME, ELEMENTS_PER_BLOCK) \
 do { \
   const size_t block_size = sizeof (TYPE); \
-  TYPE *NAME = kissat_calloc (solver, \
-                              ELEMENTS_PER_BLOCK * new_size, block_size); \
+  TYPE *NAME = kissat_calloc_tagged (solver, (M), \
+                                     ELEMENTS_PER_BLOCK * new_size, \
+                                     block_size); \
   if (old_size) \
     { \
       const size_t bytes = ELEMENTS_PER_BLOCK * old_size * block_size; \
       memcpy (NAME, solver->NAME, bytes); \
     } \
-  kissat_dealloc (solver, solver->NAME, \
-                  ELEMENTS_PER_BLOCK * old_size, block_size); \
+  kissat_dealloc_tagged (solver, (M), solver->NAME, \
+                         ELEMENTS_PER_BLOCK * old_size, block_size); \
   solver->NAME = NAME; \
 } while (0)
 
 #define NREALLOC_VARIABLE_INDEXED(TYPE, NAME) \
-  NREALLOC_GENERIC (TYPE, NAME, 1)
+  NREALLOC_GENERIC (0, TYPE, NAME, 1)
 
 #define NREALLOC_LITERAL_INDEXED(TYPE, NAME) \
-  NREALLOC_GENERIC (TYPE, NAME, 2)
+  NREALLOC_GENERIC (0, TYPE, NAME, 2)
 
 #define CREALLOC_VARIABLE_INDEXED(TYPE, NAME) \
-  CREALLOC_GENERIC (TYPE, NAME, 1)
+  CREALLOC_GENERIC (0, TYPE, NAME, 1)
 
 #define CREALLOC_LITERAL_INDEXED(TYPE, NAME) \
-  CREALLOC_GENERIC (TYPE, NAME, 2)
+  CREALLOC_GENERIC (0, TYPE, NAME, 2)
+
+// The size is kept even, so that the literal indexed 'values' array has
+// a multiple of four bytes, which is needed for the word sized gathers
+// in 'kissat_avx2_find_non_false'.
 
 void
 kissat_increase_size (kissat * solver, unsigned new_size)
@@ -47,23 +52,28 @@ kissat_increase_size (kissat * solver, unsigned new_size)
   const unsigned old_size = solver->size;
   if (old_size >= new_size)
     return;
+  new_size += new_size & 1;
 
 #ifndef NMETRICS
   LOG ("%s before increasing size from %u to %u",
        FORMAT_BYTES (kissat_allocated (solver)), old_size, new_size);
 #endif
   CREALLOC_VARIABLE_INDEXED (assigned, assigned);
+#ifdef SPLIT_ASSIGNED
+  CREALLOC_VARIABLE_INDEXED (reference, reasons);
+#endif
   CREALLOC_VARIABLE_INDEXED (flags, flags);
   NREALLOC_VARIABLE_INDEXED (links, links);
   CREALLOC_VARIABLE_INDEXED (phase, phases);
 
   CREALLOC_LITERAL_INDEXED (mark, marks);
   CREALLOC_LITERAL_INDEXED (value, values);
-  CREALLOC_LITERAL_INDEXED (watches, watches);
+  CREALLOC_GENERIC (MEMORY (watches), watches, watches, 2);
 
   kissat_resize_heap (solver, &solver->scores, new_size);
 
   solver->size = new_size;
+  assert (!(solver->size & 1));
 
 #ifndef NMETRICS
   LOG ("%s after increasing size from %zu to %zu",
@@ -75,7 +85,7 @@ void
 kissat_decrease_size (kissat * solver)
 {
   const unsigned old_size = solver->size;
-  const unsigned new_size = solver->vars;
+  const unsigned new_size = solver->vars + (solver->vars & 1);
 
 #ifndef NMETRICS
   LOG ("%s before decreasing size from %u to %u",
@@ -83,17 +93,21 @@ kissat_decrease_size (kissat * solver)
 #endif
 
   NREALLOC_VARIABLE_INDEXED (assigned, assigned);
+#ifdef SPLIT_ASSIGNED
+  NREALLOC_VARIABLE_INDEXED (reference, reasons);
+#endif
   NREALLOC_VARIABLE_INDEXED (flags, flags);
   NREALLOC_VARIABLE_INDEXED (links, links);
   NREALLOC_VARIABLE_INDEXED (phase, phases);
 
   NREALLOC_LITERAL_INDEXED (mark, marks);
   NREALLOC_LITERAL_INDEXED (value, values);
-  NREALLOC_LITERAL_INDEXED (watches, watches);
+  NREALLOC_GENERIC (MEMORY (watches), watches, watches, 2);
 
   kissat_resize_heap (solver, &solver->scores, new_size);
 
   solver->size = new_size;
+  assert (!(solver->size & 1));
 
 #ifndef NMETRICS
   LOG ("%s after decreasing size from %zu to %zu",
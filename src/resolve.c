@@ -42,15 +42,18 @@ occurrences_literal (kissat * solver, unsigned lit, bool * update)
 	}
       else
 	{
-	  const reference ref = head.large.ref;
+	  const reference ref = kissat_large_watch_reference (p - 1);
+#ifdef HUGE
+	  *q++ = *p++;
+#endif
 	  assert (ref < SIZE_STACK (solver->arena));
 	  clause *c = (struct clause *) (arena + ref);
 	  if (c->garbage)
-	    q--;
-	  else if (c->size > clslim)
+	    q -= LARGE_WATCH_SIZE;
+	  else if (CLAUSE_SIZE (c) > clslim)
 	    {
 	      LOG ("literal %s watches too long clause of size %u",
-		   LOGLIT (lit), c->size);
+		   LOGLIT (lit), CLAUSE_SIZE (c));
 	      failed = true;
 	      break;
 	    }
@@ -74,12 +77,12 @@ occurrences_literal (kissat * solver, unsigned lit, bool * update)
 static inline clause *
 watch_to_clause (kissat * solver,
 		 const value * values, const word * arena,
-		 clause * tmp, unsigned lit, watch watch)
+		 clause * tmp, unsigned lit, const watch * watch)
 {
   clause *res;
-  if (watch.type.binary)
+  if (watch->type.binary)
     {
-      const unsigned other = watch.binary.lit;
+      const unsigned other = watch->binary.lit;
       assert (!values[other]);
       tmp->lits[0] = lit;
       tmp->lits[1] = other;
@@ -87,7 +90,7 @@ watch_to_clause (kissat * solver,
     }
   else
     {
-      const reference ref = watch.large.ref;
+      const reference ref = kissat_large_watch_reference (watch);
       assert (ref < SIZE_STACK (solver->arena));
       res = (struct clause *) (arena + ref);
       assert (!res->garbage);
@@ -119,9 +122,13 @@ generate_resolvents (kissat * solver, unsigned lit,
 
   const unsigned clslim = solver->bounds.eliminate.clause_size;
 
-  for (all_stack (watch, watch0, *watches0))
+  const watch *end0 = END_STACK (*watches0);
+  const watch *end1 = END_STACK (*watches1);
+
+  for (const watch * p0 = BEGIN_STACK (*watches0); p0 != end0;
+       p0 += DENSE_WATCH_SIZE (*p0))
     {
-      clause *c = watch_to_clause (solver, values, arena, &tmp0, lit, watch0);
+      clause *c = watch_to_clause (solver, values, arena, &tmp0, lit, p0);
 
       for (all_literals_in_clause (other, c))
 	{
@@ -131,10 +138,11 @@ generate_resolvents (kissat * solver, unsigned lit,
 	  marks[other] = 1;
 	}
 
-      for (all_stack (watch, watch1, *watches1))
+      for (const watch * p1 = BEGIN_STACK (*watches1); p1 != end1;
+	   p1 += DENSE_WATCH_SIZE (*p1))
 	{
 	  clause *d =
-	    watch_to_clause (solver, values, arena, &tmp1, not_lit, watch1);
+	    watch_to_clause (solver, values, arena, &tmp1, not_lit, p1);
 
 	  LOGCLS (c, "first %s antecedent", LOGLIT (lit));
 	  LOGCLS (d, "second %s antecedent", LOGLIT (not_lit));
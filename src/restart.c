@@ -1,4 +1,5 @@
 #include "backtrack.h"
+#include "collect.h"
 #include "decide.h"
 #include "internal.h"
 #include "klimits.h"
@@ -124,6 +125,7 @@ kissat_restart (kissat * solver)
   kissat_backtrack (solver, level);
   if (!solver->stable)
     kissat_new_focused_restart_limit (solver);
+  kissat_defrag_watches_step (solver);
   REPORT (1, 'R');
   STOP (restart);
 }
@@ -1,6 +1,8 @@
 #include "analyze.h"
+#include "assume.h"
 #include "decide.h"
 #include "eliminate.h"
+#include "inline.h"
 #include "internal.h"
 #include "logging.h"
 #include "print.h"
@@ -10,6 +12,7 @@
 #include "reduce.h"
 #include "reluctant.h"
 #include "report.h"
+#include "resources.h"
 #include "restart.h"
 #include "terminate.h"
 #include "trail.h"
@@ -17,6 +20,48 @@
 
 #include <inttypes.h>
 
+static void
+start_mode (kissat * solver)
+{
+#ifndef QUIET
+  if (solver->stable)
+    {
+      START (stable);
+      REPORT (0, '[');
+    }
+  else
+    {
+      START (focused);
+      REPORT (0, '{');
+    }
+#else
+  (void) solver;
+#endif
+}
+
+// A solver restored from a checkpoint continues the interrupted search
+// and thus keeps mode, limits, averages and the random number generator.
+
+static void
+resume_search (kissat * solver)
+{
+  assert (solver->resuming);
+  solver->resuming = false;
+
+  START (search);
+#ifndef QUIET
+  solver->mode.entered = kissat_process_time ();
+#endif
+
+  REPORT (0, '*');
+
+  kissat_phase (solver, "search", GET (searches),
+                "resuming %s search after %" PRIu64 " conflicts",
+                (solver->stable ? "stable" : "focus"), CONFLICTS);
+
+  start_mode (solver);
+}
+
 static void
 start_search (kissat * solver)
 {
@@ -36,6 +81,15 @@ start_search (kissat * solver)
 
   if (solver->stable)
     kissat_init_reluctant (solver);
+  else
+    {
+      // An earlier incremental call might have ended in stable mode,
+      // where backtracking does not update the queue search pointer.
+
+      const unsigned last = solver->queue.last;
+      if (!DISCONNECTED (last))
+        kissat_update_queue (solver, solver->links, last);
+    }
 
   kissat_init_limits (solver);
 
@@ -66,17 +120,8 @@ start_search (kissat * solver)
                          "starting search with decisions limited to %" PRIu64
                          " and conflicts limited to %" PRIu64,
                          limits->decisions, limits->conflicts);
-  if (stable)
-    {
-      START (stable);
-      REPORT (0, '[');
-    }
-  else
-    {
-      START (focused);
-      REPORT (0, '{');
-    }
 #endif
+  start_mode (solver);
 }
 
 static void
@@ -106,7 +151,6 @@ stop_search (kissat * solver, int res)
     {
       REPORT (0, ']');
       STOP (stable);
-      solver->stable = false;
     }
   else
     {
@@ -158,12 +202,58 @@ decision_limit_hit (kissat * solver)
   return true;
 }
 
+// The memory limit is checked against the tracked allocated bytes.  When
+// it is exceeded we first force a reduction, which under memory pressure
+// is more aggressive, and only give up (returning 'unknown') if memory
+// is still above the limit afterwards.
+
+static bool
+memory_limit_hit (kissat * solver)
+{
+  if (!solver->limited.memory)
+    return false;
+  limits *limits = &solver->limits;
+  statistics *statistics = &solver->statistics;
+  const uint64_t allocated = solver->allocated;
+  if (allocated < limits->memory.bytes)
+    {
+      if (limits->memory.forced)
+        limits->memory.forced = 0;
+      return false;
+    }
+  if (!limits->memory.forced &&
+      GET_OPTION (reduce) && statistics->clauses_redundant)
+    {
+      kissat_very_verbose (solver, "memory limit %s exceeded "
+                           "with %s allocated (forcing reduction)",
+                           FORMAT_BYTES (limits->memory.bytes),
+                           FORMAT_BYTES (allocated));
+      limits->memory.forced = statistics->reductions + 1;
+      limits->reduce.conflicts = CONFLICTS;
+      return false;
+    }
+  if (limits->memory.forced > statistics->reductions)
+    return false;
+  kissat_verbose (solver, "memory limit %s hit with %s allocated",
+                  FORMAT_BYTES (limits->memory.bytes),
+                  FORMAT_BYTES (allocated));
+  return true;
+}
+
 int
 kissat_search (kissat * solver)
 {
-  start_search (solver);
-
-  int res = kissat_walk_initially (solver);
+  int res;
+  if (solver->resuming)
+    {
+      resume_search (solver);
+      res = solver->inconsistent ? 20 : 0;
+    }
+  else
+    {
+      start_search (solver);
+      res = kissat_walk_initially (solver);
+    }
 
   while (!res)
     {
@@ -172,12 +262,16 @@ kissat_search (kissat * solver)
         res = kissat_analyze (solver, conflict);
       else if (solver->iterating)
         iterate (solver);
+      else if (kissat_assuming (solver))
+        res = kissat_decide_assumption (solver);
       else if (!solver->unassigned)
         res = 10;
       else if (TERMINATED (11))
         break;
       else if (conflict_limit_hit (solver))
         break;
+      else if (memory_limit_hit (solver))
+        break;
       else if (kissat_reducing (solver))
         res = kissat_reduce (solver);
       else if (kissat_restarting (solver))
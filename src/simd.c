@@ -0,0 +1,49 @@
+#include "simd.h"
+
+#ifdef KISSAT_HAS_AVX2
+
+#include <immintrin.h>
+
+bool
+kissat_avx2_supported (void)
+{
+  return __builtin_cpu_supports ("avx2");
+}
+
+// Gathers the values of eight literals at once.  Since values are bytes
+// but the gather instruction only loads 32-bit words, we load the aligned
+// word containing the value and shift its byte into the sign bit.  These
+// aligned word loads stay within 'values', since its start is (at least)
+// word aligned and 'solver->size' is kept even (see 'resize.c'), so that
+// its size is a multiple of four.
+
+__attribute__ ((target ("avx2"))) unsigned *
+kissat_avx2_find_non_false (const value * values,
+			    unsigned *begin, unsigned *end)
+{
+  const int *words = (const int *) values;
+  const __m256i three = _mm256_set1_epi32 (3);
+  const __m256i top = _mm256_set1_epi32 (24);
+  unsigned *p = begin;
+  while (end - p >= SIMD_REPLACEMENT_LENGTH)
+    {
+      const __m256i lits = _mm256_loadu_si256 ((const __m256i *) p);
+      const __m256i indices = _mm256_srli_epi32 (lits, 2);
+      const __m256i offsets = _mm256_and_si256 (lits, three);
+      const __m256i bits = _mm256_slli_epi32 (offsets, 3);
+      const __m256i shifts = _mm256_sub_epi32 (top, bits);
+      const __m256i gathered = _mm256_i32gather_epi32 (words, indices, 4);
+      const __m256i signs = _mm256_sllv_epi32 (gathered, shifts);
+      const int falsified = _mm256_movemask_ps (_mm256_castsi256_ps (signs));
+      if (falsified != 0xff)
+	return p + __builtin_ctz (~falsified);
+      p += SIMD_REPLACEMENT_LENGTH;
+    }
+  while (p != end && values[*p] < 0)
+    p++;
+  return p;
+}
+
+#else
+int kissat_simd_dummy_to_avoid_warning;
+#endif
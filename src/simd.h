@@ -0,0 +1,23 @@
+#ifndef _simd_h_INCLUDED
+#define _simd_h_INCLUDED
+
+#if !defined(NSIMD) && defined(__x86_64__) && defined(__GNUC__)
+#define KISSAT_HAS_AVX2
+#endif
+
+#ifdef KISSAT_HAS_AVX2
+
+#include "value.h"
+
+#include <stdbool.h>
+
+#define SIMD_REPLACEMENT_LENGTH 8
+
+bool kissat_avx2_supported (void);
+
+unsigned *kissat_avx2_find_non_false (const value *,
+				      unsigned *begin, unsigned *end);
+
+#endif
+
+#endif
@@ -1,5 +1,6 @@
 #include "internal.h"
 #include "logging.h"
+#include "pack.h"
 
 static inline value
 move_smallest_literal_to_front (kissat * solver,
@@ -103,3 +104,27 @@ kissat_sort_literals (kissat * solver,
     move_smallest_literal_to_front (solver, values, assigned,
 				    (u >= 0), 1, size, lits);
 }
+
+#ifdef INLINE_SORT
+static inline
+#endif
+  void
+kissat_sort_clause (kissat * solver,
+#ifdef INLINE_SORT
+		    const value * values, const assigned * assigned,
+#endif
+		    clause * c)
+{
+#ifdef PACKED_CLAUSES
+  if (c->packed)
+    {
+      kissat_sort_packed_literals (solver, c);
+      return;
+    }
+#endif
+  kissat_sort_literals (solver,
+#ifdef INLINE_SORT
+			values, assigned,
+#endif
+			CLAUSE_SIZE (c), BEGIN_LITS (c));
+}
@@ -3,9 +3,11 @@
 #include "utilities.h"
 
 #include <assert.h>
+#include <stdbool.h>
 
-void
-kissat_stack_enlarge (struct kissat *solver, chars * s, size_t bytes)
+static void
+enlarge_stack (struct kissat *solver, struct memory *memory,
+	       chars * s, size_t bytes, bool large)
 {
   const size_t size = SIZE_STACK (*s);
   const size_t old_bytes = CAPACITY_STACK (*s);
@@ -19,13 +21,39 @@ kissat_stack_enlarge (struct kissat *solver, chars * s, size_t bytes)
       while (!kissat_aligned_word (new_bytes))
 	new_bytes <<= 1;
     }
-  s->begin = kissat_realloc (solver, s->begin, old_bytes, new_bytes);
+  if (large)
+    s->begin = kissat_large_realloc (solver, memory,
+				     s->begin, old_bytes, new_bytes);
+  else
+    s->begin = kissat_realloc_tagged (solver, memory,
+				      s->begin, old_bytes, new_bytes);
   s->allocated = s->begin + new_bytes;
   s->end = s->begin + size;
 }
 
 void
-kissat_shrink_stack (struct kissat *solver, chars * s, size_t bytes)
+kissat_stack_enlarge (struct kissat *solver, chars * s, size_t bytes)
+{
+  enlarge_stack (solver, 0, s, bytes, false);
+}
+
+void
+kissat_tagged_stack_enlarge (struct kissat *solver, struct memory *memory,
+			     chars * s, size_t bytes)
+{
+  enlarge_stack (solver, memory, s, bytes, false);
+}
+
+void
+kissat_large_stack_enlarge (struct kissat *solver, struct memory *memory,
+			    chars * s, size_t bytes)
+{
+  enlarge_stack (solver, memory, s, bytes, true);
+}
+
+static void
+shrink_stack (struct kissat *solver, struct memory *memory,
+	      chars * s, size_t bytes, bool large)
 {
   assert (bytes > 0);
   const size_t old_bytes_capacity = CAPACITY_STACK (*s);
@@ -50,9 +78,27 @@ kissat_shrink_stack (struct kissat *solver, chars * s, size_t bytes)
   if (new_bytes_capacity == old_bytes_capacity)
     return;
   assert (new_bytes_capacity < old_bytes_capacity);
-  s->begin = kissat_realloc (solver, s->begin,
-			     old_bytes_capacity, new_bytes_capacity);
+  if (large)
+    s->begin = kissat_large_realloc (solver, memory, s->begin,
+				     old_bytes_capacity, new_bytes_capacity);
+  else
+    s->begin = kissat_realloc_tagged (solver, memory, s->begin,
+				      old_bytes_capacity,
+				      new_bytes_capacity);
   s->allocated = s->begin + new_bytes_capacity;
   s->end = s->begin + old_bytes_size;
   assert (s->end <= s->allocated);
 }
+
+void
+kissat_shrink_stack (struct kissat *solver, chars * s, size_t bytes)
+{
+  shrink_stack (solver, 0, s, bytes, false);
+}
+
+void
+kissat_shrink_large_stack (struct kissat *solver, struct memory *memory,
+			   chars * s, size_t bytes)
+{
+  shrink_stack (solver, memory, s, bytes, true);
+}
@@ -42,6 +42,46 @@ do { \
     kissat_shrink_stack (solver, (chars*) &(S), sizeof *(S).begin); \
 } while (0)
 
+// Stacks attributed to a memory tag (see 'allocate.h') are enlarged and
+// released through the 'TAGGED' variants.  The arena and the vector stack
+// of watches are resized and released through the 'large' variants, which
+// with 'HUGE_PAGES' are mapped and always take a memory tag.
+
+#define ENLARGE_TAGGED_STACK(M,S) \
+do { \
+  assert (FULL_STACK (S)); \
+  kissat_tagged_stack_enlarge (solver, (M), \
+                               (chars*) &(S), sizeof *(S).begin); \
+} while (0)
+
+#define PUSH_TAGGED_STACK(M,S,E) \
+do { \
+  if (FULL_STACK(S)) \
+    ENLARGE_TAGGED_STACK (M, S); \
+  *(S).end++ = (E); \
+} while (0)
+
+#define RELEASE_TAGGED_STACK(M,S) \
+do { \
+  kissat_dealloc_tagged (solver, (M), (S).begin, \
+                         CAPACITY_STACK (S), sizeof *(S).begin); \
+  INIT_STACK (S); \
+} while (0)
+
+#define SHRINK_LARGE_STACK(M,S) \
+do { \
+  if (!FULL_STACK (S)) \
+    kissat_shrink_large_stack (solver, (M), \
+                               (chars*) &(S), sizeof *(S).begin); \
+} while (0)
+
+#define RELEASE_LARGE_STACK(M,S) \
+do { \
+  kissat_large_free (solver, (M), (S).begin, \
+                     CAPACITY_STACK (S) * sizeof *(S).begin); \
+  INIT_STACK (S); \
+} while (0)
+
 #define PUSH_STACK(S,E) \
 do { \
   if (FULL_STACK(S)) \
@@ -123,8 +163,17 @@ typedef STACK (unsigned) unsigneds;
 // *INDENT-ON*
 
 struct kissat;
+struct memory;
 
 void kissat_stack_enlarge (struct kissat *, chars *, size_t size_of_element);
 void kissat_shrink_stack (struct kissat *, chars *, size_t size_of_element);
 
+void kissat_tagged_stack_enlarge (struct kissat *, struct memory *,
+				  chars *, size_t);
+
+void kissat_large_stack_enlarge (struct kissat *, struct memory *,
+				 chars *, size_t);
+void kissat_shrink_large_stack (struct kissat *, struct memory *,
+				chars *, size_t);
+
 #endif
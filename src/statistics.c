@@ -40,6 +40,14 @@ kissat_statistics_print (kissat * solver, bool verbose)
 
 /*------------------------------------------------------------------------*/
 
+#ifdef NMETRICS
+#define PER_BIN_INSERTED(NAME) \
+  -1
+#else
+#define PER_BIN_INSERTED(NAME) \
+  RELATIVE (NAME, binary_watches_inserted)
+#endif
+
 #define PER_BIN_RESOLVED(NAME) \
   RELATIVE (NAME, hyper_binary_resolved)
 
@@ -52,6 +60,9 @@ kissat_statistics_print (kissat * solver, bool verbose)
 #define PER_CONFLICT(NAME) \
   RELATIVE (NAME, conflicts)
 
+#define PER_DEFRAG(NAME) \
+  RELATIVE (NAME, defragmentations)
+
 #ifdef NSTATISTICS
 #define PER_FLIPPED(NAME) \
   -1
@@ -113,6 +124,9 @@ kissat_statistics_print (kissat * solver, bool verbose)
 #define PCNT_COLLECTIONS(NAME) \
   PERCENT (NAME, garbage_collections)
 
+#define PCNT_COMPACTED(NAME) \
+  PERCENT (NAME, compacted)
+
 #define PCNT_CONFLICTS(NAME) \
   PERCENT (NAME, conflicts)
 
@@ -122,6 +136,9 @@ kissat_statistics_print (kissat * solver, bool verbose)
 #define PCNT_DEFRAGS(NAME) \
   PERCENT (NAME, defragmentations)
 
+#define PCNT_DELAYED(NAME) \
+  PERCENT (NAME, delayed_watches)
+
 #define PCNT_ELIMINATED(NAME) \
   PERCENT (NAME, eliminated)
 
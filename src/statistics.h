@@ -18,6 +18,8 @@ STATISTIC( autarky, 1, PCNT_VARIABLES, "%", "variables") \
 METRIC( autarky_determined, 1, CONF_INT, "", "interval") \
 METRIC( backward_strengthened, 1, PCNT_STR, "%", "strengthened") \
 METRIC( backward_subsumed, 1, PCNT_SUB, "%", "subsumed") \
+METRIC( binary_watches_inserted, 2, NO_SECONDARY, 0, 0) \
+METRIC( binary_watches_moved, 2, PER_BIN_INSERTED, 0, "per inserted") \
 METRIC( chronological, 1, PCNT_CONFLICTS, "%", "conflicts") \
 METRIC( chronological_reused_trails, 1, PCNT_CONFLICTS, "%", "conflicts") \
 METRIC( clauses_added, 2, PCNT_CLS_ADDED, "%", "added") \
@@ -27,14 +29,18 @@ COUNTER( clauses_irredundant, 2, NO_SECONDARY, 0, 0) \
 METRIC( clauses_kept2, 2, PCNT_CLS_ADDED, "%", "added") \
 METRIC( clauses_kept3, 2, PCNT_CLS_ADDED, "%", "added") \
 METRIC( clauses_original, 2, PCNT_CLS_ADDED, "%", "added") \
+METRIC( clauses_packed, 2, PCNT_CLS_ADDED, "%", "added") \
 METRIC( clauses_promoted1, 2, PCNT_CLS_ADDED, "%", "added") \
 METRIC( clauses_promoted2, 2, PCNT_CLS_ADDED, "%", "added") \
 METRIC( clauses_reduced, 2, PCNT_CLS_ADDED, "%", "added") \
 COUNTER( clauses_redundant, 2, NO_SECONDARY, 0, 0) \
+METRIC( clauses_unpacked, 2, PCNT_CLS_ADDED, "%", "added") \
 METRIC( compacted, 1, PCNT_REDUCTIONS, "%", "reductions") \
 COUNTER( conflicts, 0, PER_SECOND, 0, "per second") \
 COUNTER( decisions, 0, PER_CONFLICT, 0, "per conflict") \
 METRIC( defragmentations, 1, CONF_INT, "", "interval") \
+METRIC( delayed_moved, 1, PCNT_DELAYED, "%", "delayed") \
+METRIC( delayed_watches, 1, PER_PROPAGATION, 0, "per prop") \
 METRIC( dense_garbage_collections, 2, PCNT_COLLECTIONS, "%", "collections") \
 METRIC( dense_propagations, 1, PCNT_PROPS, "%", "propagations") \
 METRIC( dense_ticks, 1, PCNT_TICKS, "%", "ticks") \
@@ -74,11 +80,14 @@ METRIC( minimized, 1, PCNT_LITERALS_DEDUCED, "%", "deduced") \
 METRIC( moved, 1, PCNT_REDUCTIONS, "%", "reductions") \
 METRIC( on_the_fly_strengthened, 1, PCNT_CONFLICTS, "%", "of conflicts") \
 METRIC( on_the_fly_subsumed, 1, PCNT_CONFLICTS, "%", "of conflicts") \
+METRIC( packed_ticks, 1, PCNT_TICKS, "%", "ticks") \
 METRIC( probing_propagations, 1, PCNT_PROPS, "%", "propagations") \
 COUNTER( probings, 2, CONF_INT, "", "interval") \
 COUNTER( probing_ticks, 2, PCNT_TICKS, "%", "ticks") \
 COUNTER( propagations, 0, PER_SECOND, "", "per second") \
 COUNTER( reductions, 1, CONF_INT, "", "interval") \
+METRIC( renumbered, 1, PCNT_COMPACTED, "%", "compacted") \
+METRIC( reordered, 1, PCNT_COLLECTIONS, "%", "collections") \
 COUNTER( rephased, 1, CONF_INT, "", "interval") \
 METRIC( rescaled, 2, CONF_INT, "", "interval") \
 COUNTER( resolutions, 2, PER_SECOND, 0, "per second") \
@@ -107,6 +116,7 @@ COUNTER( transitive_ticks, 2, PCNT_TICKS, "%", "ticks") \
 COUNTER( units, 2, PCNT_VARIABLES, "%", "variables") \
 COUNTER( variables_added, 2, PER_VARIABLE, 0, "per variable") \
 COUNTER( variables_removed, 2, PER_VARIABLE, 0, "variables") \
+METRIC( vectors_defrag_steps, 2, PER_DEFRAG, 0, "per defrag") \
 METRIC( vectors_defrags_needed, 1, PCNT_DEFRAGS, "%", "defrags") \
 METRIC( vectors_enlarged, 2, CONF_INT, "", "interval") \
 STATISTIC( vivification_checks, 2, NO_SECONDARY, 0, 0) \
@@ -6,9 +6,12 @@ static clause *
 large_on_the_fly_strengthen (kissat * solver, clause * c, unsigned lit)
 {
   assert (solver->antecedent_size > 3);
+#ifdef PACKED_CLAUSES
+  assert (!c->packed);
+#endif
   LOGCLS (c, "large on-the-fly strengthening "
 	  "by removing %s from", LOGLIT (lit));
-  unsigned *lits = c->lits;
+  unsigned *lits = BEGIN_LITS (c);
   assert (lits[0] == lit || lits[1] == lit);
   INC (on_the_fly_strengthened);
 #ifndef NDEBUG
@@ -22,7 +25,7 @@ large_on_the_fly_strengthen (kissat * solver, clause * c, unsigned lit)
   SHRINK_CLAUSE_IN_PROOF (c, lit, lits[0]);
   CHECK_SHRINK_CLAUSE (c, lit, lits[0]);
   {
-    const unsigned old_size = c->size;
+    const unsigned old_size = CLAUSE_SIZE (c);
     unsigned new_size = 1;
     const bool irredundant = !c->redundant;
     for (unsigned i = 2; i < old_size; i++)
@@ -36,8 +39,7 @@ large_on_the_fly_strengthen (kissat * solver, clause * c, unsigned lit)
 	  kissat_mark_added_literal (solver, other);
       }
     assert (new_size > 2);
-    c->size = new_size;
-    c->searched = 2;
+    kissat_shrink_clause_size (c, new_size);
     if (c->redundant && c->glue >= new_size)
       kissat_promote_clause (solver, c, new_size - 1);
     if (!c->shrunken)
@@ -51,7 +53,7 @@ large_on_the_fly_strengthen (kissat * solver, clause * c, unsigned lit)
     assert (VALUE (lits[1]) < 0);
     unsigned highest_pos = 1;
     unsigned highest_level = LEVEL (lits[1]);
-    const unsigned size = c->size;
+    const unsigned size = CLAUSE_SIZE (c);
     for (unsigned i = 2; i < size; i++)
       {
 	const unsigned other = lits[i];
@@ -65,30 +67,39 @@ large_on_the_fly_strengthen (kissat * solver, clause * c, unsigned lit)
     if (highest_pos != 1)
       SWAP (unsigned, lits[1], lits[highest_pos]);
     LOGCLS (c, "sorted on-the-fly strengthened");
-    kissat_watch_blocking (solver, lits[1], lits[0], ref);
   }
-  {
-    watches *watches = &WATCHES (lits[0]);
+  if (CLAUSE_SIZE (c) == 3)
+    {
+      kissat_unwatch_blocking (solver, lits[0], ref);
+      kissat_watch_ternary (solver, lits, ref);
+    }
+  else
+    {
+      kissat_watch_blocking (solver, lits[1], lits[0], ref);
+      watches *watches = &WATCHES (lits[0]);
 #ifndef NDEBUG
-    const watch *end_of_watches = END_WATCHES (*watches);
+      const watch *end_of_watches = END_WATCHES (*watches);
 #endif
-    watch *p = BEGIN_WATCHES (*watches);
-    assert (solver->watching);
-    for (;;)
-      {
-	assert (p != end_of_watches);
-	const watch head = *p++;
-	if (head.type.binary)
-	  continue;
-	assert (p != end_of_watches);
-	const watch tail = *p++;
-	if (tail.large.ref == ref)
-	  break;
-      }
-    p[-2].blocking.lit = lits[1];
-    LOGREF (ref, "updating watching %s now blocking %s in",
-	    LOGLIT (lits[0]), LOGLIT (lits[1]));
-  }
+      watch *p = BEGIN_WATCHES (*watches);
+      assert (solver->watching);
+      for (;;)
+	{
+	  assert (p != end_of_watches);
+	  const watch head = *p++;
+	  if (head.type.binary)
+	    continue;
+	  if (head.type.ternary)
+	    p++;
+	  assert (p != end_of_watches);
+	  const watch *tail = p;
+	  p += LARGE_WATCH_SIZE;
+	  if (kissat_large_watch_reference (tail) == ref)
+	    break;
+	}
+      p[-1 - LARGE_WATCH_SIZE].blocking.lit = lits[1];
+      LOGREF (ref, "updating watching %s now blocking %s in",
+	      LOGLIT (lits[0]), LOGLIT (lits[1]));
+    }
 #ifndef NDEBUG
   clause *new_next = kissat_next_clause (c);
   assert (old_next == new_next);
@@ -127,7 +138,7 @@ binary_on_the_fly_strengthen (kissat * solver, clause * c, unsigned lit)
 	{
 	  assert (second == INVALID_LIT);
 	  second = other;
-#ifndef NDEBUG
+#ifdef NDEBUG
 	  break;
 #endif
 	}
@@ -137,9 +148,7 @@ binary_on_the_fly_strengthen (kissat * solver, clause * c, unsigned lit)
   const bool redundant = c->redundant;
   LOGBINARY (first, second, "on-the-fly strengthened");
   kissat_new_binary_clause (solver, redundant, first, second);
-  const reference ref = kissat_reference_clause (solver, c);
-  kissat_unwatch_blocking (solver, c->lits[0], ref);
-  kissat_unwatch_blocking (solver, c->lits[1], ref);
+  kissat_unwatch_clause (solver, c);
   kissat_mark_clause_as_garbage (solver, c);
   clause *conflict =
     kissat_binary_conflict (solver, redundant, first, second);
@@ -169,29 +178,38 @@ kissat_on_the_fly_subsume (kissat * solver, clause * c, clause * d)
   LOGCLS (d, "on-the-fly subsumed");
   assert (c != d);
   assert (!d->garbage);
-  assert (c->size > 1);
-  assert (c->size <= d->size);
+  assert (CLAUSE_SIZE (c) > 1);
+  assert (CLAUSE_SIZE (c) <= CLAUSE_SIZE (d));
   kissat_mark_clause_as_garbage (solver, d);
   INC (on_the_fly_subsumed);
   if (d->redundant)
     return;
   if (!c->redundant)
     return;
-  if (c->size == 2)
+  if (CLAUSE_SIZE (c) == 2)
     {
       assert (c == &solver->conflict);
-      const unsigned *lits = c->lits;
+      const unsigned *lits = BEGIN_LITS (c);
       LOGBINARY (lits[0], lits[1], "turned irredundant");
       for (unsigned i = 0; i < 2; i++)
 	{
 	  const unsigned lit = lits[i];
+	  const unsigned other = lits[!i];
 	  watches *watches = &WATCHES (lit);
-	  watch *p = LAST_WATCH_POINTER (*watches);
-	  assert (p->type.binary);
-	  assert (p->binary.redundant);
-	  assert (p->binary.lit == lits[!i]);
+#ifndef NDEBUG
+	  const watch *end_of_watches = END_WATCHES (*watches);
+#endif
+	  watch *p = BEGIN_WATCHES (*watches);
+	  for (;;)
+	    {
+	      assert (p != end_of_watches);
+	      assert (p->type.binary);
+	      if (p->binary.lit == other &&
+		  p->binary.redundant && !p->binary.hyper)
+		break;
+	      p++;
+	    }
 	  p->binary.redundant = false;
-	  assert (!p->binary.hyper);
 	}
     }
   else
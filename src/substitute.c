@@ -226,8 +226,8 @@ determine_representatives (kissat * solver, unsigned *repr)
   kissat_free (solver, reach, bytes);
   kissat_free (solver, mark, bytes);
   for (all_literals (lit))
-    if (repr[lit] == INVALID_LIT)
-      repr[lit] = lit;
+    if (repr[lit] == INVALID_LIT || flags[IDX (lit)].assumed)
+      repr[lit] = lit;		// frozen assumptions represent themselves
 }
 
 static bool *
@@ -538,6 +538,15 @@ substitute_clauses (kissat * solver, unsigned *repr)
 	      kissat_new_binary_clause (solver, redundant, first, second);
 	      kissat_mark_clause_as_garbage (solver, c);
 	    }
+#ifdef PACKED_CLAUSES
+	  else if (c->packed)
+	    {
+	      assert (c->redundant);
+	      LOGCLS (c, "dropping substituted packed");
+	      kissat_mark_clause_as_garbage (solver, c);
+	      removed++;
+	    }
+#endif
 	  else
 	    {
 	      substituted++;
@@ -552,8 +561,8 @@ substitute_clauses (kissat * solver, unsigned *repr)
 	      DELETE_CLAUSE_FROM_PROOF (c);
 	      REMOVE_CHECKER_CLAUSE (c);
 
-	      const unsigned old_size = c->size;
-	      unsigned *old_lits = c->lits;
+	      const unsigned old_size = CLAUSE_SIZE (c);
+	      unsigned *old_lits = BEGIN_LITS (c);
 
 	      assert (new_size <= old_size);
 	      memcpy (old_lits, new_lits, new_size * sizeof *old_lits);
@@ -561,12 +570,11 @@ substitute_clauses (kissat * solver, unsigned *repr)
 	      assert (shrink == (new_size < old_size));
 	      if (new_size < old_size)
 		{
-		  c->size = new_size;
-		  c->searched = 2;
+		  kissat_shrink_clause_size (c, new_size);
 		  if (!c->shrunken)
 		    {
 		      c->shrunken = true;
-		      c->lits[old_size - 1] = INVALID_LIT;
+		      old_lits[old_size - 1] = INVALID_LIT;
 		    }
 		}
 	      LOGCLS (c, "unsorted substituted");
@@ -647,7 +655,7 @@ kissat_substitute (kissat * solver, bool first)
   assert (!solver->level);
   if (!GET_OPTION (substitute))
     return;
-  if (TERMINATED (12))
+  if (INTERRUPTED (12))
     return;
   if (!really_substitute (solver, first))
     return;
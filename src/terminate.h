@@ -38,4 +38,18 @@ kissat_terminated (kissat * solver, int bit,
 #define TERMINATED(BIT) \
   kissat_terminated (solver, BIT, __FILE__, __LINE__, __func__)
 
+// Simplifications are also interrupted if the memory limit is exceeded.
+// The search loop then forces a reduction and returns 'unknown' if memory
+// is still above the limit afterwards (see 'memory_limit_hit').
+
+static inline bool
+kissat_memory_limit_exceeded (kissat * solver)
+{
+  return solver->limited.memory &&
+    solver->allocated >= solver->limits.memory.bytes;
+}
+
+#define INTERRUPTED(BIT) \
+  (TERMINATED (BIT) || kissat_memory_limit_exceeded (solver))
+
 #endif
@@ -19,9 +19,9 @@ connect_ternary_clauses (kissat * solver, value * ternary)
     {
       if (c->garbage)
 	continue;
-      if (c->size != 3)
+      if (CLAUSE_SIZE (c) != 3)
 	continue;
-      const unsigned *lits = c->lits;
+      const unsigned *lits = BEGIN_LITS (c);
       if (values[lits[0]])
 	continue;
       if (values[lits[1]])
@@ -88,8 +88,8 @@ static void
 ternary_resolution (kissat * solver, tags * tags, references * garbage,
 		    unsigned lit, clause * c, clause * d)
 {
-  assert (c->size == 3);
-  assert (d->size == 3);
+  assert (CLAUSE_SIZE (c) == 3);
+  assert (CLAUSE_SIZE (d) == 3);
 
   LOGCLS (c, "ternary 1st antecedent");
   LOGCLS (d, "ternary 2nd antecedent");
@@ -100,7 +100,7 @@ ternary_resolution (kissat * solver, tags * tags, references * garbage,
   unsigned size = 0;
   for (unsigned i = 0; i < 3; i++)
     {
-      const unsigned other = c->lits[i];
+      const unsigned other = BEGIN_LITS (c)[i];
       if (other == lit)
 	continue;
       lits[size++] = other;
@@ -111,7 +111,7 @@ ternary_resolution (kissat * solver, tags * tags, references * garbage,
   bool tautological = false;
   for (unsigned i = 0; i < 3; i++)
     {
-      const unsigned other = d->lits[i];
+      const unsigned other = BEGIN_LITS (d)[i];
       if (other == not_lit)
 	continue;
       const unsigned not_other = NOT (other);
@@ -227,15 +227,16 @@ find_ternary (kissat * solver, word * arena,
 	}
       else
 	{
-	  const reference ref = watch.large.ref;
+	  const reference ref = LARGE_WATCH_REF (watch);
 	  clause *d = (clause *) (arena + ref);
 	  assert (kissat_clause_in_arena (solver, d));
-	  assert (d->size == 3);
+	  assert (CLAUSE_SIZE (d) == 3);
 	  INC (hyper_ternary_steps);
 
-	  const unsigned a = d->lits[0];
-	  const unsigned b = d->lits[1];
-	  const unsigned c = d->lits[2];
+	  const unsigned *lits = BEGIN_LITS (d);
+	  const unsigned a = lits[0];
+	  const unsigned b = lits[1];
+	  const unsigned c = lits[2];
 	  if (a == first)
 	    {
 	      if (b == second && c == third)
@@ -325,7 +326,7 @@ add_ternary_resolvents (kissat * solver, tags * tags, uint64_t * resolved_ptr)
 	  reference ref = kissat_new_redundant_clause (solver, 2);
 	  clause *c = kissat_dereference_clause (solver, ref);
 	  assert (c->redundant);
-	  assert (c->size == 3);
+	  assert (CLAUSE_SIZE (c) == 3);
 	  INC (hyper_ternaries);
 	  assert (!c->hyper);
 	  c->hyper = true;
@@ -382,16 +383,16 @@ resolve_ternary_clauses (kissat * solver, word * arena, uint64_t steps_limit,
 
   for (all_binary_large_watches (pos_watch, *pos_watches))
     {
-      if (TERMINATED (13))
+      if (INTERRUPTED (13))
 	break;
       if (solver->statistics.hyper_ternary_steps > steps_limit)
 	break;
       if (pos_watch.type.binary)
 	continue;
-      const reference pos_ref = pos_watch.large.ref;
+      const reference pos_ref = LARGE_WATCH_REF (pos_watch);
       clause *c = (clause *) (arena + pos_ref);
       assert (kissat_clause_in_arena (solver, c));
-      assert (c->size == 3);
+      assert (CLAUSE_SIZE (c) == 3);
       INC (hyper_ternary_steps);
       if (c->garbage)
 	continue;
@@ -399,10 +400,10 @@ resolve_ternary_clauses (kissat * solver, word * arena, uint64_t steps_limit,
 	{
 	  if (neg_watch.type.binary)
 	    continue;
-	  const reference neg_ref = neg_watch.large.ref;
+	  const reference neg_ref = LARGE_WATCH_REF (neg_watch);
 	  clause *d = (clause *) (arena + neg_ref);
 	  assert (kissat_clause_in_arena (solver, d));
-	  assert (d->size == 3);
+	  assert (CLAUSE_SIZE (d) == 3);
 	  assert (c != d);
 	  INC (hyper_ternary_steps);
 	  if (d->garbage)
@@ -432,7 +433,7 @@ really_ternary (kissat * solver)
     return false;
 
   for (all_clauses (c))
-    if (!c->garbage && c->size == 3)
+    if (!c->garbage && CLAUSE_SIZE (c) == 3)
       return true;
 
   return false;
@@ -458,7 +459,7 @@ ternary_round (kissat * solver,
 
   while (!kissat_empty_heap (schedule))
     {
-      if (TERMINATED (14))
+      if (INTERRUPTED (14))
 	break;
 
       if (solver->statistics.hyper_ternary_steps > steps_limit)
@@ -512,7 +513,7 @@ kissat_ternary (kissat * solver)
   assert (solver->watching);
   assert (solver->probing);
 
-  if (TERMINATED (15))
+  if (INTERRUPTED (15))
     return;
   if (!GET_OPTION (ternary))
     return;
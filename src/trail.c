@@ -32,7 +32,7 @@ kissat_mark_reason_clauses (kissat * solver, reference start)
       assert (a->level > 0);
       if (a->binary)
 	continue;
-      const reference ref = a->reason;
+      const reference ref = ASSIGNED_REASON (a);
       assert (ref != UNIT);
       if (ref == DECISION)
 	continue;
@@ -101,7 +101,7 @@ kissat_unmark_reason_clauses (kissat * solver, reference start)
       assert (a->level > 0);
       if (a->binary)
 	continue;
-      const reference ref = a->reason;
+      const reference ref = ASSIGNED_REASON (a);
       assert (ref != UNIT);
       if (ref == DECISION)
 	continue;
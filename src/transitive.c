@@ -42,39 +42,6 @@ transitive_backtrack (kissat * solver, unsigned saved)
   solver->level = 0;
 }
 
-static void
-prioritize_binaries (kissat * solver)
-{
-  assert (solver->watching);
-  statches large;
-  INIT_STACK (large);
-  watches *all_watches = solver->watches;
-  for (all_literals (lit))
-    {
-      assert (EMPTY_STACK (large));
-      watches *watches = all_watches + lit;
-      watch *begin_watches = BEGIN_WATCHES (*watches), *q = begin_watches;
-      const watch *end_watches = END_WATCHES (*watches), *p = q;
-      while (p != end_watches)
-	{
-	  const watch head = *q++ = *p++;
-	  if (head.type.binary)
-	    continue;
-	  const watch tail = *p++;
-	  PUSH_STACK (large, head);
-	  PUSH_STACK (large, tail);
-	  q--;
-	}
-      const watch *end_large = END_STACK (large);
-      const watch *r = BEGIN_STACK (large);
-      while (r != end_large)
-	*q++ = *r++;
-      assert (q == end_watches);
-      CLEAR_STACK (large);
-    }
-  RELEASE_STACK (large);
-}
-
 static bool
 transitive_reduce (kissat * solver,
 		   unsigned src, uint64_t limit,
@@ -183,7 +150,7 @@ transitive_reduce (kissat * solver,
 	break;
       if (solver->statistics.transitive_ticks > limit)
 	break;
-      if (TERMINATED (16))
+      if (INTERRUPTED (16))
 	break;
     }
 
@@ -198,8 +165,9 @@ transitive_reduce (kissat * solver,
 	  const watch src_watch = *q++ = *p;
 	  if (!src_watch.type.binary)
 	    {
-	      *q++ = *++p;
-	      continue;
+	      while (++p != end_src)
+		*q++ = *p;
+	      break;
 	    }
 	  if (src_watch.binary.lit == ILLEGAL_LIT)
 	    q--;
@@ -245,10 +213,9 @@ kissat_transitive_reduction (kissat * solver)
   assert (!solver->level);
   if (!GET_OPTION (transitive))
     return;
-  if (TERMINATED (17))
+  if (INTERRUPTED (17))
     return;
   START (transitive);
-  prioritize_binaries (solver);
   bool success = false;
   uint64_t reduced = 0;
   unsigned units = 0;
@@ -275,7 +242,7 @@ kissat_transitive_reduction (kissat * solver)
 	break;
       if (solver->statistics.transitive_ticks > limit)
 	break;
-      if (TERMINATED (18))
+      if (INTERRUPTED (18))
 	break;
     }
   while (solver->transitive != end);
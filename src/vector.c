@@ -8,6 +8,21 @@
 
 #include <inttypes.h>
 
+void
+kissat_init_vectors (kissat * solver, vectors * vectors)
+{
+  unsigneds *stack = &vectors->stack;
+  assert (EMPTY_STACK (*stack));
+  PUSH_TAGGED_STACK (MEMORY (watches), *stack, 0);
+}
+
+void
+kissat_release_vectors (kissat * solver, vectors * vectors)
+{
+  RELEASE_LARGE_STACK (MEMORY (watches), vectors->stack);
+  RELEASE_STACK (vectors->defrag);
+}
+
 unsigned *
 kissat_enlarge_vector (kissat * solver, vectors * vectors, vector * vector)
 {
@@ -37,7 +52,8 @@ kissat_enlarge_vector (kissat * solver, vectors * vectors, vector * vector)
 			  "of 2^%u entries %s exhausted", LD_MAX_VECTORS,
 			  FORMAT_BYTES (MAX_VECTORS * sizeof (unsigned)));
 	  enlarged++;
-	  kissat_stack_enlarge (solver, (chars *) stack, sizeof (unsigned));
+	  kissat_large_stack_enlarge (solver, MEMORY (watches),
+				      (chars *) stack, sizeof (unsigned));
 
 	  capacity = CAPACITY_STACK (*stack);
 	  available = capacity - old_stack_size;
@@ -100,6 +116,7 @@ kissat_defrag_vectors (kissat * solver, vectors * vectors,
 		       unsigned size_unsorted, vector * unsorted)
 {
   START (defrag);
+  kissat_stop_defrag_vectors (solver, vectors);
   unsigneds *stack = &vectors->stack;
   const size_t size_vectors = SIZE_STACK (*stack);
   if (size_vectors < 2)
@@ -145,12 +162,177 @@ kissat_defrag_vectors (kissat * solver, vectors * vectors,
   assert (freed == solver->vectors.usable);
 #endif
   SET_END_OF_STACK (*stack, p);
-  SHRINK_STACK (*stack);
+  SHRINK_LARGE_STACK (MEMORY (watches), *stack);
   solver->vectors.usable = 0;
   kissat_check_vectors (solver);
   STOP (defrag);
 }
 
+// Incremental defragmentation moves vectors down to the 'defragged'
+// cursor in the order of their offsets, but only a bounded number per
+// step, such that the cost is spread over several restarts.  Vectors
+// enlarged during a round are moved to the end of the stack, i.e., beyond
+// the 'limit' of the schedule, and are skipped.  After all scheduled
+// vectors have been moved the gap between the cursor and the limit only
+// contains invalid entries and is closed by moving down the tail.
+
+void
+kissat_start_defrag_vectors (kissat * solver, vectors * vectors)
+{
+  if (vectors->defragged)
+    return;
+  if (SIZE_STACK (vectors->stack) < 2)
+    return;
+  INC (defragmentations);
+  LOG ("starting incremental defragmentation of vectors size %zu "
+       "usable %" SECTOR_FORMAT, SIZE_STACK (vectors->stack),
+       vectors->usable);
+  assert (EMPTY_STACK (vectors->defrag));
+  vectors->defragged = 1;
+  vectors->limit = 0;
+}
+
+void
+kissat_stop_defrag_vectors (kissat * solver, vectors * vectors)
+{
+  if (!vectors->defragged)
+    return;
+  LOG ("stopping incremental defragmentation at %" SECTOR_FORMAT,
+       vectors->defragged);
+  RELEASE_STACK (vectors->defrag);
+  vectors->defragged = 0;
+  vectors->limit = 0;
+}
+
+static inline sector
+rank_negated_offset (vector * unsorted, unsigned i)
+{
+  return ~unsorted[i].offset;
+}
+
+#define RANK_NEGATED_OFFSET(A) \
+  rank_negated_offset (unsorted, (A))
+
+static void
+schedule_defrag (kissat * solver, vectors * vectors,
+		 unsigned size_unsorted, vector * unsorted)
+{
+  unsigneds *defrag = &vectors->defrag;
+  assert (EMPTY_STACK (*defrag));
+  for (unsigned i = 0; i < size_unsorted; i++)
+    {
+      vector *vector = unsorted + i;
+      if (vector->size)
+	PUSH_STACK (*defrag, i);
+      else
+	vector->offset = 0;
+    }
+  RADIX (RADIX_SORT_DEFRAG_LENGTH, unsigned, sector,
+	 SIZE_STACK (*defrag), BEGIN_STACK (*defrag), RANK_NEGATED_OFFSET);
+  vectors->limit = SIZE_STACK (vectors->stack);
+  LOG ("scheduled %zu vectors for defragmentation", SIZE_STACK (*defrag));
+}
+
+static void
+finish_defrag (kissat * solver, vectors * vectors,
+	       unsigned size_unsorted, vector * unsorted)
+{
+  unsigneds *stack = &vectors->stack;
+  unsigned *begin = BEGIN_STACK (*stack);
+  unsigned *end = END_STACK (*stack);
+  const sector defragged = vectors->defragged;
+  const sector limit = vectors->limit;
+  sector freed = 0;
+  if (defragged < limit)
+    {
+      freed = limit - defragged;
+#ifndef NDEBUG
+      for (const unsigned *p = begin + defragged; p != begin + limit; p++)
+	assert (*p == INVALID_VECTOR_ELEMENT);
+#endif
+      for (unsigned i = 0; i < size_unsorted; i++)
+	{
+	  vector *vector = unsorted + i;
+	  if (!vector->size)
+	    vector->offset = 0;
+	  else if (vector->offset >= limit)
+	    vector->offset -= freed;
+	}
+      const size_t moved = end - (begin + limit);
+      memmove (begin + defragged, begin + limit, moved * sizeof (unsigned));
+      end -= freed;
+    }
+  while (end != begin + 1 && end[-1] == INVALID_VECTOR_ELEMENT)
+    end--, freed++;
+  assert (freed <= vectors->usable);
+#ifndef QUIET
+  const size_t size_vectors = SIZE_STACK (*stack);
+  double freed_fraction = kissat_percent (freed, size_vectors);
+  kissat_phase (solver, "defrag", GET (defragmentations),
+		"incrementally freed %" SECTOR_FORMAT
+		" usable entries %.0f%%", freed, freed_fraction);
+#endif
+  vectors->usable -= freed;
+  SET_END_OF_STACK (*stack, end);
+  SHRINK_LARGE_STACK (MEMORY (watches), *stack);
+  kissat_stop_defrag_vectors (solver, vectors);
+}
+
+void
+kissat_defrag_vectors_step (kissat * solver, vectors * vectors,
+			    unsigned size_unsorted, vector * unsorted,
+			    unsigned steps)
+{
+  if (!vectors->defragged)
+    return;
+  START (defrag);
+  INC (vectors_defrag_steps);
+  if (!vectors->limit)
+    schedule_defrag (solver, vectors, size_unsorted, unsorted);
+  unsigneds *stack = &vectors->stack;
+  unsigneds *defrag = &vectors->defrag;
+  unsigned *begin = BEGIN_STACK (*stack);
+  const unsigned *end = END_STACK (*stack);
+  unsigned *p = begin + vectors->defragged;
+  for (;;)
+    {
+      while (p != end && *p != INVALID_VECTOR_ELEMENT)
+	p++;
+      if (!steps || EMPTY_STACK (*defrag))
+	break;
+      const unsigned idx = POP_STACK (*defrag);
+      vector *vector = unsorted + idx;
+      const sector size = vector->size;
+      if (!size)
+	{
+	  vector->offset = 0;
+	  continue;
+	}
+      const sector old_offset = vector->offset;
+      const sector new_offset = p - begin;
+      if (old_offset < new_offset || old_offset >= vectors->limit)
+	continue;
+      steps--;
+      if (old_offset != new_offset)
+	{
+	  unsigned *q = begin + old_offset;
+	  memmove (p, q, size * sizeof (unsigned));
+	  unsigned *vacated = p + size;
+	  if (vacated < q)
+	    vacated = q;
+	  const size_t bytes = (q + size - vacated) * sizeof (unsigned);
+	  memset (vacated, 0xff, bytes);
+	  vector->offset = new_offset;
+	}
+      p += size;
+    }
+  vectors->defragged = p - begin;
+  if (EMPTY_STACK (*defrag))
+    finish_defrag (solver, vectors, size_unsorted, unsorted);
+  kissat_check_vectors (solver);
+  STOP (defrag);
+}
+
 void
 kissat_remove_from_vector (kissat * solver,
 			   vectors * vectors, vector * vector,
@@ -32,6 +32,9 @@ struct vectors
 {
   unsigneds stack;
   sector usable;
+  unsigneds defrag;
+  sector defragged;
+  sector limit;
 };
 
 struct vector
@@ -91,8 +94,14 @@ kissat_pop_vector (vectors * vectors, vector * vector)
   kissat_inc_usable (vectors);
 }
 
+void kissat_init_vectors (struct kissat *, vectors *);
+void kissat_release_vectors (struct kissat *, vectors *);
 unsigned *kissat_enlarge_vector (struct kissat *, vectors *, vector *);
 void kissat_defrag_vectors (struct kissat *, vectors *, unsigned, vector *);
+void kissat_start_defrag_vectors (struct kissat *, vectors *);
+void kissat_defrag_vectors_step (struct kissat *, vectors *,
+				 unsigned, vector *, unsigned steps);
+void kissat_stop_defrag_vectors (struct kissat *, vectors *);
 void kissat_remove_from_vector (struct kissat *, vectors *, vector *,
 				unsigned);
 void kissat_resize_vector (struct kissat *, vectors *, vector *, sector);
@@ -114,7 +123,7 @@ kissat_push_vectors (struct kissat *solver,
   if (!vector->size && !vector->offset)
     {
       if (EMPTY_STACK (*stack))
-	PUSH_STACK (*stack, 0);
+	kissat_init_vectors (solver, vectors);
       if (FULL_STACK (*stack))
 	{
 	  unsigned *end = kissat_enlarge_vector (solver, vectors, vector);
@@ -49,7 +49,7 @@ vivify_sort_stack_by_counts (kissat * solver,
 static void
 vivify_sort_clause_by_counts (kissat * solver, clause * c, unsigned *counts)
 {
-  vivify_sort_lits_by_counts (solver, c->size, c->lits, counts);
+  vivify_sort_lits_by_counts (solver, CLAUSE_SIZE (c), BEGIN_LITS (c), counts);
 }
 
 static void
@@ -94,13 +94,13 @@ simplify_vivification_candidate (kissat * solver, clause * c)
       CLEAR_STACK (solver->clause.lits);
       return true;
     }
-  if (non_false == c->size)
+  if (non_false == CLAUSE_SIZE (c))
     {
       CLEAR_STACK (solver->clause.lits);
       return false;
     }
   assert (1 < non_false);
-  assert (non_false <= c->size);
+  assert (non_false <= CLAUSE_SIZE (c));
   if (non_false == 2)
     {
       const unsigned first = PEEK_STACK (solver->clause.lits, 0);
@@ -117,8 +117,8 @@ simplify_vivification_candidate (kissat * solver, clause * c)
       REMOVE_CHECKER_CLAUSE (c);
       DELETE_CLAUSE_FROM_PROOF (c);
 
-      const unsigned old_size = c->size;
-      unsigned new_size = 0, *lits = c->lits;;
+      const unsigned old_size = CLAUSE_SIZE (c);
+      unsigned new_size = 0, *lits = BEGIN_LITS (c);;
       for (unsigned i = 0; i < old_size; i++)
 	{
 	  const unsigned lit = lits[i];
@@ -131,8 +131,7 @@ simplify_vivification_candidate (kissat * solver, clause * c)
       assert (2 < new_size);
       assert (new_size == non_false);
       assert (new_size < old_size);
-      c->size = new_size;
-      c->searched = 2;
+      kissat_shrink_clause_size (c, new_size);
       if (c->redundant && c->glue >= new_size)
 	kissat_promote_clause (solver, c, new_size - 1);
       if (!c->shrunken)
@@ -179,6 +178,10 @@ schedule_vivification_candidates (kissat * solver,
 		continue;
 	      if (c->hyper)
 		continue;
+#ifdef PACKED_CLAUSES
+	      if (c->packed)
+		continue;
+#endif
 	      if (c->glue < lower_glue_limit)
 		continue;
 	      if (c->glue > upper_glue_limit)
@@ -292,12 +295,12 @@ vivify_unit_conflict (kissat * solver, unsigned lit)
   clause *conflict;
   if (a->binary)
     {
-      const unsigned other = a->reason;
+      const unsigned other = ASSIGNED_REASON (a);
       conflict = kissat_binary_conflict (solver, a->redundant, lit, other);
     }
   else
     {
-      const reference ref = a->reason;
+      const reference ref = ASSIGNED_REASON (a);
       conflict = kissat_dereference_clause (solver, ref);
     }
   a->analyzed = true;
@@ -309,7 +312,7 @@ vivify_unit_conflict (kissat * solver, unsigned lit)
 static void
 vivify_binary_or_large_conflict (kissat * solver, clause * conflict)
 {
-  assert (conflict->size >= 2);
+  assert (CLAUSE_SIZE (conflict) >= 2);
   LOGCLS (conflict, "vivify analyzing conflict");
   for (all_literals_in_clause (lit, conflict))
     {
@@ -368,14 +371,14 @@ vivify_analyze (kissat * solver, clause * c,
       assigned *a = ASSIGNED (lit);
       assert (a->level);
       assert (a->analyzed);
-      if (a->reason == DECISION)
+      if (ASSIGNED_REASON (a) == DECISION)
 	{
 	  LOG ("vivify analyzing decision %s", LOGLIT (not_lit));
 	  PUSH_STACK (solver->clause.lits, not_lit);
 	}
       else if (a->binary)
 	{
-	  const unsigned other = a->reason;
+	  const unsigned other = ASSIGNED_REASON (a);
 	  if (a->redundant)
 	    irredundant = false;
 	  assert (VALUE (other) < 0);
@@ -398,7 +401,7 @@ vivify_analyze (kissat * solver, clause * c,
 	}
       else
 	{
-	  const reference ref = a->reason;
+	  const reference ref = ASSIGNED_REASON (a);
 	  LOGREF (ref, "vivify analyzing %s reason", LOGLIT (lit));
 	  clause *reason = kissat_dereference_clause (solver, ref);
 	  if (reason->redundant)
@@ -541,8 +544,8 @@ vivify_learn (kissat * solver, clause * c,
       DELETE_CLAUSE_FROM_PROOF (c);
 
       assert (size > 2);
-      const unsigned old_size = c->size;
-      unsigned new_size = 0, *lits = c->lits;
+      const unsigned old_size = CLAUSE_SIZE (c);
+      unsigned new_size = 0, *lits = BEGIN_LITS (c);
       unsigned watched[2] = { lits[0], lits[1] };
       for (unsigned i = 0; i < old_size; i++)
 	{
@@ -553,7 +556,7 @@ vivify_learn (kissat * solver, clause * c,
 	      assigned *a = ASSIGNED (lit);
 	      if (!a->analyzed)
 		keep = false;
-	      else if (a->reason != DECISION)
+	      else if (ASSIGNED_REASON (a) != DECISION)
 		keep = false;
 	    }
 	  if (!c->redundant)
@@ -573,10 +576,9 @@ vivify_learn (kissat * solver, clause * c,
 	  c->shrunken = true;
 	  lits[old_size - 1] = INVALID_LIT;
 	}
-      c->size = new_size;
+      kissat_shrink_clause_size (c, new_size);
       if (c->redundant && c->glue >= new_size)
 	kissat_promote_clause (solver, c, new_size - 1);
-      c->searched = 2;
       LOGCLS (c, "vivified shrunken");
 
       const reference ref = kissat_reference_clause (solver, c);
@@ -585,8 +587,7 @@ vivify_learn (kissat * solver, clause * c,
 
       kissat_unwatch_blocking (solver, watched[0], ref);
       kissat_unwatch_blocking (solver, watched[1], ref);
-      kissat_watch_blocking (solver, lits[0], lits[1], ref);
-      kissat_watch_blocking (solver, lits[1], lits[0], ref);
+      kissat_watch_clause (solver, c);
 
       vivify_inc_strengthened (solver, c);
       res = true;
@@ -640,12 +641,12 @@ vivify_clause (kissat * solver, clause * c,
   const unsigned non_false = SIZE_STACK (*sorted);
 
   assert (1 < non_false);
-  assert (non_false <= c->size);
+  assert (non_false <= CLAUSE_SIZE (c));
 
 #ifdef LOGGING
   if (!non_false)
     LOG ("no root level falsified literal");
-  else if (non_false == c->size)
+  else if (non_false == CLAUSE_SIZE (c))
     LOG ("all literals root level unassigned");
   else
     LOG ("found %u root level non-falsified literals");
@@ -687,7 +688,7 @@ vivify_clause (kissat * solver, clause * c,
       else
 	{
 	  reference ref = kissat_reference_clause (solver, c);
-	  if (a->reason != ref)
+	  if (ASSIGNED_REASON (a) != ref)
 	    unit = INVALID_LIT;
 	}
     }
@@ -944,7 +945,7 @@ vivify_round (kissat * solver, round round)
     {
       if (solver->statistics.probing_ticks > ticks_limit)
 	break;
-      if (TERMINATED (19))
+      if (INTERRUPTED (19))
 	break;
       const reference ref = POP_STACK (schedule);
       clause *c = kissat_dereference_clause (solver, ref);
@@ -979,7 +980,7 @@ vivify_round (kissat * solver, round round)
 	  size_t prioritized = 0;
 	  while (!EMPTY_STACK (schedule))
 	    {
-	      const unsigned ref = POP_STACK (schedule);
+	      const reference ref = POP_STACK (schedule);
 	      clause *c = (clause *) (arena + ref);
 	      if (c->vivify)
 		prioritized++;
@@ -1005,7 +1006,7 @@ vivify_round (kissat * solver, round round)
 static void
 vivify_redundant_tier1 (kissat * solver)
 {
-  if (TERMINATED (20))
+  if (INTERRUPTED (20))
     return;
   vivify_round (solver, REDUNDANT_TIER1_ROUND);
 }
@@ -1013,7 +1014,7 @@ vivify_redundant_tier1 (kissat * solver)
 static void
 vivify_redundant_tier2 (kissat * solver)
 {
-  if (TERMINATED (21))
+  if (INTERRUPTED (21))
     return;
   vivify_round (solver, REDUNDANT_TIER2_ROUND);
 }
@@ -1021,7 +1022,7 @@ vivify_redundant_tier2 (kissat * solver)
 static void
 vivify_irredundant (kissat * solver)
 {
-  if (TERMINATED (22))
+  if (INTERRUPTED (22))
     return;
   vivify_round (solver, IRREDUNDANT_ROUND);
 }
@@ -90,8 +90,8 @@ dereference_literals (kissat * solver, walker * walker,
     {
       const reference clause_ref = tagged.ref;
       clause *c = kissat_dereference_clause (solver, clause_ref);
-      *size_ptr = c->size;
-      lits = c->lits;
+      *size_ptr = CLAUSE_SIZE (c);
+      lits = BEGIN_LITS (c);
     }
   return lits;
 }
@@ -437,7 +437,7 @@ break_value (kissat * solver, walker * walker, value * values, unsigned lit)
     {
       steps++;
       assert (!watch.type.binary);
-      reference counter_ref = watch.large.ref;
+      reference counter_ref = LARGE_WATCH_REF (watch);
       assert (counter_ref < walker->clauses);
       counter *counter = walker->counters + counter_ref;
       if (counter->count == 1)
@@ -551,7 +551,7 @@ break_clauses (kissat * solver, walker * walker,
     {
       steps++;
       assert (!watch.type.binary);
-      const unsigned counter_ref = watch.large.ref;
+      const unsigned counter_ref = LARGE_WATCH_REF (watch);
       assert (counter_ref < walker->clauses);
       counter *counter = counters + counter_ref;
       assert (counter->count);
@@ -587,7 +587,7 @@ make_clauses (kissat * solver, walker * walker,
     {
       steps++;
       assert (!watch.type.binary);
-      const unsigned counter_ref = watch.large.ref;
+      const unsigned counter_ref = LARGE_WATCH_REF (watch);
       assert (counter_ref < walker->clauses);
       counter *counter = counters + counter_ref;
       assert (counter->count < UINT_MAX);
@@ -798,7 +798,7 @@ local_search_round (walker * walker, unsigned round)
   statistics *statistics = &solver->statistics;
   while (walker->minimum && walker->limit > statistics->walk_steps)
     {
-      if (TERMINATED (23))
+      if (INTERRUPTED (23))
 	break;
       local_search_step (solver, walker);
     }
@@ -863,7 +863,7 @@ walking_phase (kissat * solver)
   const unsigned max_rounds = GET_OPTION (walkrounds);
   for (unsigned round = 1; walker.minimum && round <= max_rounds; round++)
     {
-      if (TERMINATED (24))
+      if (INTERRUPTED (24))
 	break;
       local_search_round (&walker, round);
     }
@@ -913,7 +913,7 @@ kissat_walk_initially (kissat * solver)
 {
   if (solver->inconsistent)
     return 20;
-  if (TERMINATED (25))
+  if (INTERRUPTED (25))
     return 0;
   if (!GET_OPTION (walkinitially))
     return 0;
@@ -15,29 +15,83 @@ kissat_remove_blocking_watch (kissat * solver,
 #ifndef NDEBUG
   bool found = false;
 #endif
+  unsigned removed = 0;
   while (p != end)
     {
       const watch head = *q++ = *p++;
       if (head.type.binary)
 	continue;
-      const watch tail = *q++ = *p++;
-      if (tail.raw != ref)
+      if (head.type.ternary)
+	*q++ = *p++;
+      const watch *tail = q;
+      for (unsigned i = 0; i < LARGE_WATCH_SIZE; i++)
+	*q++ = *p++;
+      if (kissat_large_watch_reference (tail) != ref)
 	continue;
 #ifndef NDEBUG
       assert (!found);
       found = true;
 #endif
-      q -= 2;
+      removed = WATCH_SIZE (head);
+      q -= removed;
     }
   assert (found);
-  watches->size -= 2;
+  assert ((size_t) (end - q) == removed);
+  watches->size -= removed;
   const watch empty = {.raw = INVALID_VECTOR_ELEMENT };
-  end[-2] = end[-1] = empty;
-  assert (solver->vectors.usable < MAX_SECTOR - 2);
-  solver->vectors.usable += 2;
+  while (q != end)
+    *q++ = empty;
+  assert (solver->vectors.usable < MAX_SECTOR - removed);
+  solver->vectors.usable += removed;
   kissat_check_vectors (solver);
 }
 
+#ifdef HUGE
+
+void
+kissat_remove_large_watch (kissat * solver, watches * watches, reference ref)
+{
+  assert (!solver->watching);
+  watch *begin = BEGIN_WATCHES (*watches);
+  watch *end = END_WATCHES (*watches);
+  watch *p = begin;
+  while (p->type.binary || kissat_large_watch_reference (p) != ref)
+    p += DENSE_WATCH_SIZE (*p), assert (p < end);
+  watch *q = p + LARGE_WATCH_SIZE;
+  memmove (p, q, (end - q) * sizeof *p);
+  SET_END_OF_WATCHES (*watches, end - LARGE_WATCH_SIZE);
+}
+
+#endif
+
+/* Binary watches of a literal are kept in front of its large watches.
+   Large watches take two or three words, so a new binary watch can not
+   simply be swapped with the first large watch, but the whole large
+   watch tail has to be shifted by one word.  This makes inserting a
+   binary watch linear in the size of the watch list, which is the same
+   effort as propagating the literal once.  The number of shifted words
+   is counted in 'binary_watches_moved' to keep an eye on this cost.  */
+
+void
+kissat_insert_binary_watch (kissat * solver,
+			    watches * watches, watch binary)
+{
+  assert (solver->watching);
+  assert (binary.type.binary);
+  PUSH_WATCHES (*watches, binary);
+  watch *begin = BEGIN_WATCHES (*watches);
+  watch *last = LAST_WATCH_POINTER (*watches);
+  watch *p = begin;
+  while (p != last && p->type.binary)
+    p++;
+  if (p == last)
+    return;
+  memmove (p + 1, p, (last - p) * sizeof *p);
+  *p = binary;
+  INC (binary_watches_inserted);
+  ADD (binary_watches_moved, last - p);
+}
+
 void
 kissat_flush_large_watches (kissat * solver)
 {
@@ -47,12 +101,15 @@ kissat_flush_large_watches (kissat * solver)
   for (all_literals (lit))
     {
       watches *lit_watches = all_watches + lit;
-      watch *begin = BEGIN_WATCHES (*lit_watches), *q = begin;
-      const watch *end = END_WATCHES (*lit_watches), *p = q;
-      while (p != end)
-	if (!(*q++ = *p++).type.binary)
-	  q--;
-      SET_END_OF_WATCHES (*lit_watches, q);
+      watch *p = BEGIN_WATCHES (*lit_watches);
+      const watch *end = END_WATCHES (*lit_watches);
+      while (p != end && p->type.binary)
+	p++;
+#ifndef NDEBUG
+      for (const watch * q = p; q != end; q++)
+	assert (!q->type.binary);
+#endif
+      SET_END_OF_WATCHES (*lit_watches, p);
     }
 }
 
@@ -72,16 +129,11 @@ kissat_watch_large_clauses (kissat * solver)
       if (c->garbage)
 	continue;
 
-      unsigned *lits = c->lits;
-      kissat_sort_literals (solver, values, assigned, c->size, lits);
-      c->searched = 2;
+      kissat_sort_clause (solver, values, assigned, c);
+      kissat_reset_searched (c);
 
       const reference ref = (word *) c - arena;
-      const unsigned l0 = lits[0];
-      const unsigned l1 = lits[1];
-
-      kissat_push_blocking_watch (solver, watches + l0, l1, ref);
-      kissat_push_blocking_watch (solver, watches + l1, l0, ref);
+      kissat_inlined_watch_clause (solver, watches, c, ref);
     }
 }
 
@@ -142,7 +194,10 @@ kissat_flush_large_connected (kissat * solver)
 	  if (head.type.binary)
 	    *q++ = head;
 	  else
-	    flushed++;
+	    {
+	      p += LARGE_WATCH_SIZE - 1;
+	      flushed++;
+	    }
 	}
       SET_END_OF_WATCHES (*watches, q);
     }
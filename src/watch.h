@@ -16,16 +16,19 @@ typedef struct watch_type watch_type;
 typedef struct binary_watch binary_watch;
 typedef struct blocking_watch blocking_watch;
 typedef struct large_watch large_watch;
+typedef struct ternary_watch ternary_watch;
 
 struct watch_type
 {
 #ifdef KISSAT_IS_BIG_ENDIAN
   bool binary:1;
-  unsigned padding:2;
+  bool ternary:1;
+  unsigned padding:1;
   unsigned lit:29;
 #else
   unsigned lit:29;
-  unsigned padding:2;
+  unsigned padding:1;
+  bool ternary:1;
   bool binary:1;
 #endif
 };
@@ -60,11 +63,28 @@ struct blocking_watch
 {
 #ifdef KISSAT_IS_BIG_ENDIAN
   bool binary:1;
-  unsigned padding:2;
+  bool ternary:1;
+  unsigned padding:1;
   unsigned lit:29;
 #else
   unsigned lit:29;
-  unsigned padding:2;
+  unsigned padding:1;
+  bool ternary:1;
+  bool binary:1;
+#endif
+};
+
+struct ternary_watch
+{
+#ifdef KISSAT_IS_BIG_ENDIAN
+  bool binary:1;
+  bool ternary:1;
+  unsigned padding:1;
+  unsigned lit:29;
+#else
+  unsigned lit:29;
+  unsigned padding:1;
+  bool ternary:1;
   bool binary:1;
 #endif
 };
@@ -74,6 +94,7 @@ union watch
   watch_type type;
   binary_watch binary;
   blocking_watch blocking;
+  ternary_watch ternary;
   large_watch large;
   unsigned raw;
 };
@@ -131,17 +152,65 @@ kissat_large_watch (reference ref)
   return res;
 }
 
+#ifdef HUGE
+
+// With 'HUGE' references have 64 bits and a large watch takes two words,
+// the lower 31 bits of the reference in the first (with 'binary' unset)
+// followed by the remaining bits in the second word.
+
+#define LARGE_WATCH_SIZE 2
+
+static inline watch
+kissat_large_watch_high (reference ref)
+{
+  watch res;
+  res.raw = ref >> 31;
+  assert (!res.type.binary);
+  return res;
+}
+
+#else
+
+#define LARGE_WATCH_SIZE 1
+
+#endif
+
+static inline reference
+kissat_large_watch_reference (const watch * large)
+{
+  assert (!large->type.binary);
+#ifdef HUGE
+  return large[0].large.ref | ((reference) large[1].raw << 31);
+#else
+  return large->large.ref;
+#endif
+}
+
 static inline watch
 kissat_blocking_watch (unsigned lit)
 {
   watch res;
   res.blocking.lit = lit;
   res.blocking.padding = 0;
+  res.blocking.ternary = false;
   res.blocking.binary = false;
   assert (!res.type.binary);
   return res;
 }
 
+static inline watch
+kissat_ternary_watch (unsigned lit)
+{
+  watch res;
+  res.ternary.lit = lit;
+  res.ternary.padding = 0;
+  res.ternary.ternary = true;
+  res.ternary.binary = false;
+  assert (!res.type.binary);
+  assert (res.type.ternary);
+  return res;
+}
+
 #define PUSH_WATCHES(W,E) \
 do { \
   assert (sizeof (E) == sizeof (unsigned)); \
@@ -171,6 +240,26 @@ do { \
 
 #define WATCHES(LIT) (solver->watches[assert ((LIT) < LITS), (LIT)])
 
+// While watching clauses all binary watches of a literal precede its
+// blocking and large watch pairs.  This allows propagation to go over the
+// binary watches first in a tight loop without checking the watch type.
+
+// Clauses of size three are watched in all their literals by a ternary
+// head (carrying the first other literal), a blocking watch (carrying the
+// second other literal) and a large watch with the reference.  Thus
+// propagating a literal in a ternary clause only needs to access the
+// arena if the clause becomes a reason or is conflicting.  Note that the
+// 'ternary' bit overlaps with 'redundant' of binary watches and thus has
+// to be checked after 'binary'.
+
+#define WATCH_SIZE(WATCH) \
+  ((WATCH).type.binary ? 1u : 1u + LARGE_WATCH_SIZE + (WATCH).type.ternary)
+
+// Without watching (in dense mode) only the large watch is kept.
+
+#define DENSE_WATCH_SIZE(WATCH) \
+  ((WATCH).type.binary ? 1u : LARGE_WATCH_SIZE)
+
 #define all_binary_blocking_watch_ref(WATCH,REF,WATCHES) \
   watch WATCH, \
     * WATCH ## _PTR = (assert (solver->watching), BEGIN_WATCHES (WATCHES)), \
@@ -178,24 +267,44 @@ do { \
   WATCH ## _PTR != WATCH ## _END && \
     ((WATCH = *WATCH ## _PTR), \
      (REF = WATCH.type.binary ? INVALID_REF : \
-	    WATCH ## _PTR[1].large.ref), true); \
-  WATCH ## _PTR += 1u + !WATCH.type.binary
+	    kissat_large_watch_reference (WATCH ## _PTR + 1 + \
+					  WATCH.type.ternary)), true); \
+  WATCH ## _PTR += WATCH_SIZE (WATCH)
 
 #define all_binary_blocking_watches(WATCH,WATCHES) \
   watch WATCH, \
     * WATCH ## _PTR = (assert (solver->watching), BEGIN_WATCHES (WATCHES)), \
     * WATCH ## _END = END_WATCHES (WATCHES); \
   WATCH ## _PTR != WATCH ## _END && ((WATCH = *WATCH ## _PTR), true); \
-  WATCH ## _PTR += 1u + !WATCH.type.binary
+  WATCH ## _PTR += WATCH_SIZE (WATCH)
 
 #define all_binary_large_watches(WATCH,WATCHES) \
   watch WATCH, \
     * WATCH ## _PTR = (assert (!solver->watching), BEGIN_WATCHES (WATCHES)), \
     * WATCH ## _END = END_WATCHES (WATCHES); \
   WATCH ## _PTR != WATCH ## _END && ((WATCH = *WATCH ## _PTR), true); \
-  ++WATCH ## _PTR
+  WATCH ## _PTR += DENSE_WATCH_SIZE (WATCH)
+
+// The reference of the current large watch in the loop above.
+
+#define LARGE_WATCH_REF(WATCH) \
+  kissat_large_watch_reference (WATCH ## _PTR)
+
+// Gate and antecedent stacks keep copies of watches in the same format.
+
+#define PUSH_DENSE_WATCH(S,P) \
+do { \
+  const union watch * PTR = (P); \
+  const unsigned SIZE = DENSE_WATCH_SIZE (*PTR); \
+  for (unsigned I = 0; I < SIZE; I++) \
+    PUSH_STACK ((S), PTR[I]); \
+} while (0)
 
 void kissat_remove_blocking_watch (struct kissat *, watches *, reference);
+#ifdef HUGE
+void kissat_remove_large_watch (struct kissat *, watches *, reference);
+#endif
+void kissat_insert_binary_watch (struct kissat *, watches *, watch);
 
 void kissat_flush_large_watches (struct kissat *);
 void kissat_watch_large_clauses (struct kissat *);
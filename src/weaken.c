@@ -9,7 +9,7 @@ push_witness_literal (kissat * solver, unsigned ilit)
   assert (elit);
   LOG2 ("pushing external witness literal %d on extension stack", elit);
   const extension ext = kissat_extension (true, elit);
-  PUSH_STACK (solver->extend, ext);
+  PUSH_TAGGED_STACK (MEMORY (extend), solver->extend, ext);
 }
 
 static void
@@ -26,7 +26,7 @@ push_clause_literal (kissat * solver, unsigned ilit)
       assert (elit);
       LOG2 ("pushing external clause literal %d on extension stack", elit);
       const extension ext = kissat_extension (false, elit);
-      PUSH_STACK (solver->extend, ext);
+      PUSH_TAGGED_STACK (MEMORY (extend), solver->extend, ext);
     }
 }
 
@@ -45,7 +45,7 @@ kissat_weaken_clause (kissat * solver, unsigned lit, clause * c)
   for (all_literals_in_clause (other, c))
     if (lit != other)
       push_clause_literal (solver, other);
-  LOGPUSHED (c->size);
+  LOGPUSHED (CLAUSE_SIZE (c));
 }
 
 void
@@ -45,12 +45,12 @@ static unsigned
 copy_literals (kissat * solver, unsigned lit,
 	       const value * values, unsigned *lits, clause * c)
 {
-  const unsigned *end = c->lits + c->size;
+  const unsigned *end = BEGIN_LITS (c) + CLAUSE_SIZE (c);
   unsigned *q = lits;
 #ifndef NDEBUG
   bool found_lit = false;
 #endif
-  for (const unsigned *p = c->lits; p != end; p++)
+  for (const unsigned *p = BEGIN_LITS (c); p != end; p++)
     {
       const unsigned other = *p;
       if (other == lit)
@@ -170,11 +170,11 @@ match_lits_ref (kissat * solver, const value * marks, const value * values,
 static bool
 match_lits_watch (kissat * solver,
 		  const value * marks, const value * values,
-		  unsigned size, watch watch)
+		  unsigned size, const watch * watch)
 {
-  if (watch.type.binary)
+  if (watch->type.binary)
     {
-      const unsigned other = watch.binary.lit;
+      const unsigned other = watch->binary.lit;
       if (!marks[other])
 	return false;
       assert (size > 2);
@@ -183,7 +183,7 @@ match_lits_watch (kissat * solver,
     }
   else
     {
-      const reference ref = watch.large.ref;
+      const reference ref = kissat_large_watch_reference (watch);
       return match_lits_ref (solver, marks, values, size, ref);
     }
 }
@@ -194,10 +194,10 @@ find_lits_watch (kissat * solver, watch * begin, watch * end,
 		 unsigned size, uint64_t * steps)
 {
   assert (begin <= end);
-  for (watch * p = begin; p != end; p++)
+  for (watch * p = begin; p != end; p += DENSE_WATCH_SIZE (*p))
     {
       *steps += 1;
-      if (match_lits_watch (solver, marks, values, size, *p))
+      if (match_lits_watch (solver, marks, values, size, p))
 	return p;
     }
   return 0;
@@ -230,7 +230,7 @@ kissat_find_xor_gate (kissat * solver, unsigned lit, unsigned negative)
     return false;
 
   uint64_t large_clauses0 = 0;
-  for (watch * p = begin0; p != end0; p++)
+  for (watch * p = begin0; p != end0; p += DENSE_WATCH_SIZE (*p))
     if (!p->type.binary && large_clauses0++)
       break;
   if (large_clauses0 < 2)
@@ -242,7 +242,7 @@ kissat_find_xor_gate (kissat * solver, unsigned lit, unsigned negative)
   watch *end1 = END_WATCHES (*watches1);
 
   uint64_t large_clauses1 = 0;
-  for (watch * p = begin1; p != end1; p++)
+  for (watch * p = begin1; p != end1; p += DENSE_WATCH_SIZE (*p))
     if (!p->type.binary && large_clauses1++)
       break;
   if (large_clauses1 < 2)
@@ -257,7 +257,7 @@ kissat_find_xor_gate (kissat * solver, unsigned lit, unsigned negative)
 
   uint64_t steps = 0;
 
-  for (watch * p = begin0; p != end0; p++)
+  for (watch * p = begin0; p != end0; p += DENSE_WATCH_SIZE (*p))
     {
       if (p->type.binary)
 	continue;
@@ -265,12 +265,13 @@ kissat_find_xor_gate (kissat * solver, unsigned lit, unsigned negative)
       if (steps > steps_limit)
 	break;
 
-      if (TERMINATED (26))
+      if (INTERRUPTED (26))
 	break;
 
       steps++;
-      clause *c = kissat_dereference_clause (solver, p->large.ref);
-      if (c->size > size_limit)
+      const reference ref = kissat_large_watch_reference (p);
+      clause *c = kissat_dereference_clause (solver, ref);
+      if (CLAUSE_SIZE (c) > size_limit)
 	continue;
 
       unsigned size = copy_literals (solver, lit, values, lits, c);
@@ -303,7 +304,7 @@ kissat_find_xor_gate (kissat * solver, unsigned lit, unsigned negative)
 		  break;
 		}
 
-	      LOGWATCH (lit, *q, "literal %s XOR", LOGLIT (lit));
+	      LOGWATCH (lit, q, "literal %s XOR", LOGLIT (lit));
 	      PUSH_STACK (solver->xorted[0], q);
 	    }
 	  else
@@ -313,7 +314,7 @@ kissat_find_xor_gate (kissat * solver, unsigned lit, unsigned negative)
 	      if (!q)
 		break;
 
-	      LOGWATCH (not_lit, *q, "found %s literal XOR",
+	      LOGWATCH (not_lit, q, "found %s literal XOR",
 			LOGLIT (not_lit));
 	      PUSH_STACK (solver->xorted[1], q);
 	    }
@@ -336,14 +337,13 @@ kissat_find_xor_gate (kissat * solver, unsigned lit, unsigned negative)
 	  for (unsigned i = 0; i < nsort[0]; i++)
 	    {
 	      const watch *p0 = PEEK_STACK (solver->xorted[0], i);
-	      const watch w0 = *p0;
 	      if (p0 == prev)
-		LOGWATCH (lit, w0, "dropping repeated");
+		LOGWATCH (lit, p0, "dropping repeated");
 	      else
 		{
-		  LOGWATCH (lit, w0, "%s %s XOR",
+		  LOGWATCH (lit, p0, "%s %s XOR",
 			    FORMAT_ORDINAL (i + 1), LOGLIT (lit));
-		  PUSH_STACK (solver->gates[negative], w0);
+		  PUSH_DENSE_WATCH (solver->gates[negative], p0);
 		}
 	      prev = p0;
 	    }
@@ -353,14 +353,13 @@ kissat_find_xor_gate (kissat * solver, unsigned lit, unsigned negative)
 	  for (unsigned i = 0; i < nsort[1]; i++)
 	    {
 	      const watch *p1 = PEEK_STACK (solver->xorted[1], i);
-	      const watch w1 = *p1;
 	      if (p1 == prev)
-		LOGWATCH (not_lit, w1, "dropping repeated");
+		LOGWATCH (not_lit, p1, "dropping repeated");
 	      else
 		{
-		  LOGWATCH (not_lit, w1, "%s %s XOR",
+		  LOGWATCH (not_lit, p1, "%s %s XOR",
 			    FORMAT_ORDINAL (i + 1), LOGLIT (not_lit));
-		  PUSH_STACK (solver->gates[!negative], w1);
+		  PUSH_DENSE_WATCH (solver->gates[!negative], p1);
 		}
 	      prev = p1;
 	    }
@@ -63,6 +63,9 @@ int tissat_processes;
 
 bool tissat_found_drabt;
 bool tissat_found_drat_trim;
+#ifdef LRAT
+bool tissat_found_lrat_check;
+#endif
 
 #endif
 
@@ -387,6 +390,9 @@ do { \
 
   FIND (drabt, drabt);
   FIND (drat-trim, drat_trim);
+#ifdef LRAT
+  FIND (lrat-check, lrat_check);
+#endif
 
   // *INDENT-ON*
 
@@ -468,11 +474,16 @@ do { \
   SCHEDULE (solve);
   SCHEDULE (coverage);
   SCHEDULE (terminate);
+  SCHEDULE (checkpoint);
+  SCHEDULE (incremental);
 
 #ifndef NPROOFS
   if (tissat_found_drabt || tissat_found_drat_trim)
     SCHEDULE (prove);
 #endif
+#ifdef LRAT
+  SCHEDULE (lrat);
+#endif
 
 #ifndef NDEBUG
   SCHEDULE (dump);
@@ -21,6 +21,9 @@ extern bool tissat_progress;
 #ifndef NPROOFS
 extern bool tissat_found_drabt;
 extern bool tissat_found_drat_trim;
+#ifdef LRAT
+extern bool tissat_found_lrat_check;
+#endif
 #endif
 
 #ifdef _POSIX_C_SOURCE
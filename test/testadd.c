@@ -1,5 +1,7 @@
 #include "test.h"
 
+#include <stdlib.h>
+
 static word full_clauses;
 
 static void
@@ -41,8 +43,41 @@ test_add (void)
     }
 }
 
+static void
+test_add_clauses (void)
+{
+  for (int n = 1; n < 9; n++)
+    {
+      const int clauses = 1 << n;
+      int *lits = malloc (clauses * (n + 1) * sizeof *lits);
+      int *p = lits;
+      for (int i = 0; i < clauses; i++)
+	{
+	  for (int j = 0; j < n; j++)
+	    *p++ = (i & (1 << j)) ? j + 1 : -(j + 1);
+	  *p++ = 0;
+	}
+      kissat *solver = kissat_init ();
+      for (int i = 0; i < clauses; i++)
+	kissat_add_clause (solver, lits + i * (n + 1), n);
+      int res = kissat_solve (solver);
+      assert (res == 20);
+      kissat_release (solver);
+      solver = kissat_init ();
+      kissat_add_clauses (solver, lits + n + 1, (clauses - 1) * (n + 1));
+      res = kissat_solve (solver);
+      assert (res == 10);
+      for (int idx = 1; idx <= n; idx++)
+	assert (kissat_value (solver, idx) > 0);
+      kissat_release (solver);
+      free (lits);
+      printf ("%d: added %d clauses in bulk\n", n, clauses);
+    }
+}
+
 void
 tissat_schedule_add (void)
 {
   SCHEDULE_FUNCTION (test_add);
+  SCHEDULE_FUNCTION (test_add_clauses);
 }
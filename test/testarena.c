@@ -22,7 +22,7 @@ test_arena_basic (void)
       printf ("iteration %d\n", i);
       (void) kissat_allocate_clause (solver, size);
     }
-  RELEASE_STACK (solver->arena);
+  kissat_release_arena (solver);
 #ifndef NMETRICS
   assert (!solver->statistics.allocated_current);
 #endif
@@ -40,14 +40,20 @@ test_arena_realloc (void)
   printf ("before allocating arena %s\n", formatted);
 #endif
   const unsigned bytes = (1u << 22);
-  const unsigned size = bytes / 4 - 3;
+  const unsigned size = (bytes - offsetof (clause, lits)) / 4;
   const unsigned n = tissat_big ? (1u << 8) : (1u << 3);
   for (unsigned i = 0; i < n; i++)
     {
       reference ref = kissat_allocate_clause (solver, size);
       clause *c = kissat_unchecked_dereference_clause (solver, ref);
+#ifdef SHORT_HEADER
+      c->short_size = 0;
+#endif
       c->size = size;
       c->shrunken = false;
+#ifdef PACKED_CLAUSES
+      c->packed = false;
+#endif
       for (unsigned i = 0; i < size; i++)
 	c->lits[i] = 42;
 #ifndef QUIET
@@ -64,7 +70,7 @@ test_arena_realloc (void)
   for (all_clauses (c))
     count++;
   assert (count == n);
-  RELEASE_STACK (solver->arena);
+  kissat_release_arena (solver);
 #ifndef NMETRICS
   assert (!solver->statistics.allocated_current);
 #endif
@@ -79,22 +85,29 @@ test_arena_traverse (void)
     {
       reference ref = kissat_allocate_clause (solver, size);
       clause *c = kissat_unchecked_dereference_clause (solver, ref);
-      c->size = size;
+#ifdef SHORT_HEADER
+      c->short_size = (size <= MAX_SHORT_SIZE) ? size : 0;
+#endif
+      if (!SHORT_CLAUSE (c))
+	c->size = size;
       c->shrunken = false;
+#ifdef PACKED_CLAUSES
+      c->packed = false;
+#endif
       for (unsigned i = 0; i < size; i++)
-	c->lits[i] = size;
+	BEGIN_LITS (c)[i] = size;
     }
   unsigned found = 0, size = 3;
   for (all_clauses (c))
     {
       found++;
-      assert (c->size == size);
+      assert (CLAUSE_SIZE (c) == size);
       assert (!c->shrunken);
-      assert (c->lits[0] == size);
+      assert (BEGIN_LITS (c)[0] == size);
       size++;
     }
   assert (found == n);
-  RELEASE_STACK (solver->arena);
+  kissat_release_arena (solver);
 #ifndef NMETRICS
   assert (!solver->statistics.allocated_current);
 #endif
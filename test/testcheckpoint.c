@@ -0,0 +1,124 @@
+#include "test.h"
+
+#include "../src/file.h"
+#include "../src/parse.h"
+
+#include <inttypes.h>
+
+static void
+test_checkpoint (int expected, int limit, const char *name)
+{
+  char cnf[64], path[64];
+  sprintf (cnf, "../test/cnf/%s.cnf", name);
+  sprintf (path, "%s%d.checkpoint", name, limit);
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  file file;
+  if (!kissat_open_to_read_file (&file, cnf))
+    FATAL ("could not read '%s'", cnf);
+  tissat_verbose ("parsing '%s'", cnf);
+  uint64_t lineno;
+  int max_var;
+  const char *error =
+    kissat_parse_dimacs (solver, RELAXED_PARSING, &file, &lineno, &max_var);
+  if (error)
+    FATAL ("unexpected parse error: %s", error);
+  kissat_close_file (&file);
+  if (limit >= 0)
+    {
+      tissat_verbose ("solving '%s' with conflict limit %d", cnf, limit);
+      kissat_set_conflict_limit (solver, limit);
+      int res = kissat_solve (solver);
+      if (res)
+	FATAL ("solver returned '%d' but expected '0'", res);
+    }
+  const uint64_t conflicts = solver->statistics.conflicts;
+  const uint64_t searches = solver->statistics.searches;
+  tissat_verbose ("writing checkpoint '%s' after %" PRIu64 " conflicts",
+		  path, conflicts);
+  if (!kissat_checkpoint (solver, path))
+    FATAL ("could not write checkpoint '%s'", path);
+  kissat_release (solver);
+  solver = kissat_restore (path);
+  if (!solver)
+    FATAL ("could not restore checkpoint '%s'", path);
+  tissat_init_solver (solver);
+  assert (solver->statistics.conflicts == conflicts);
+  assert (solver->statistics.searches == searches);
+  int res = kissat_solve (solver);
+  if (res != expected)
+    FATAL ("restored solver returned '%d' but expected '%d'", res, expected);
+  tissat_verbose ("restored solver returned '%d' as expected", res);
+  if (searches)
+    assert (solver->statistics.searches == searches);
+  assert (solver->statistics.conflicts >= conflicts);
+  kissat_release (solver);
+}
+
+static void
+test_checkpoint_application (int expected, int limit, const char *name)
+{
+  char cmd[128], path[64];
+  sprintf (path, "%s%d.app.checkpoint", name, limit);
+  sprintf (cmd, "--conflicts=%d --checkpoint=%s ../test/cnf/%s.cnf",
+	   limit, path, name);
+  tissat_call_application (0, cmd);
+  sprintf (cmd, "--restore=%s", path);
+  tissat_call_application (expected, cmd);
+}
+
+static void
+test_checkpoint_errors (void)
+{
+  assert (!kissat_restore ("../test/cnf/ph6.cnf"));
+  assert (!kissat_restore ("/non/existing/checkpoint"));
+  kissat *solver = kissat_init ();
+  assert (!kissat_checkpoint (solver, "/non/existing/checkpoint"));
+  kissat_release (solver);
+}
+
+// *INDENT-OFF*
+
+#define CHECKPOINTS \
+CHECKPOINT (20, -1, add16) \
+CHECKPOINT (10, -1, sqrt12769) \
+CHECKPOINT (20, 200, ph6) \
+CHECKPOINT (20, 300, add32) \
+CHECKPOINT (10, 50, prime2209) \
+CHECKPOINT (20, 500, prime65537)
+
+#define CHECKPOINT(EXPECTED,LIMIT,NAME) \
+static void test_checkpoint_ ## NAME (void) \
+{ \
+  test_checkpoint (EXPECTED, LIMIT, #NAME); \
+}
+CHECKPOINTS
+#undef CHECKPOINT
+
+static void
+test_checkpoint_application_ph6 (void)
+{
+  test_checkpoint_application (20, 100, "ph6");
+}
+
+static void
+test_checkpoint_application_prime2209 (void)
+{
+  test_checkpoint_application (10, 50, "prime2209");
+}
+
+void
+tissat_schedule_checkpoint (void)
+{
+  SCHEDULE_FUNCTION (test_checkpoint_errors);
+  if (!tissat_found_test_directory)
+    return;
+#define CHECKPOINT(EXPECTED,LIMIT,NAME) \
+  SCHEDULE_FUNCTION (test_checkpoint_ ## NAME);
+  CHECKPOINTS
+#undef CHECKPOINT
+  SCHEDULE_FUNCTION (test_checkpoint_application_ph6);
+  SCHEDULE_FUNCTION (test_checkpoint_application_prime2209);
+}
+
+// *INDENT-ON*
@@ -139,16 +139,19 @@ do { \
   READ_COMPRESSED (true, "lzma", "../test/file/3.lzma");
   READ_COMPRESSED (true, "7z", "../test/file/4.7z");
   READ_COMPRESSED (true, "xz", "../test/file/5.xz");
+  READ_COMPRESSED (true, "zstd", "../test/file/6.zst");
   READ_COMPRESSED (false, "bzip2", "../test/file/non-existing.bz2");
   READ_COMPRESSED (false, "gzip", "../test/file/non-existing.gz");
   READ_COMPRESSED (false, "lzma", "../test/file/non-existing.lzma");
   READ_COMPRESSED (false, "7z", "../test/file/non-existing.7z");
   READ_COMPRESSED (false, "xz", "../test/file/non-existing.xz");
+  READ_COMPRESSED (false, "zstd", "../test/file/non-existing.zst");
   READ_COMPRESSED (true, "bzip2", "../test/file/uncompressed.bz2");
   READ_COMPRESSED (true, "gzip", "../test/file/uncompressed.gz");
   READ_COMPRESSED (true, "lzma", "../test/file/uncompressed.lzma");
   READ_COMPRESSED (true, "7z", "../test/file/uncompressed.7z");
   READ_COMPRESSED (true, "xz", "../test/file/uncompressed.xz");
+  READ_COMPRESSED (true, "zstd", "../test/file/uncompressed.zst");
 }
 
 #endif
@@ -190,8 +193,50 @@ do { \
   READ_UNCOMPRESSED (true, "../test/file/uncompressed.lzma");
   READ_UNCOMPRESSED (true, "../test/file/uncompressed.7z");
   READ_UNCOMPRESSED (true, "../test/file/uncompressed.xz");
+  READ_UNCOMPRESSED (true, "../test/file/uncompressed.zst");
 }
 
+#if defined(BZIP2) || defined(ZLIB) || defined(LZMA) || defined(ZSTD)
+
+static void
+test_file_read_decompressed (void)
+{
+  const size_t expected_bytes = kissat_file_size ("../test/file/0");
+#define READ_DECOMPRESSED(PATH) \
+do { \
+  file file; \
+  if (!kissat_open_to_read_file (&file, PATH)) \
+    FATAL ("failed to open compressed '%s' for reading", PATH); \
+  if (!file.decompressor) \
+    FATAL ("compressed '%s' not decompressed in-process", PATH); \
+  printf ("decompressing '%s' in-process as expected\n", PATH); \
+  int ch; \
+  while ((ch = kissat_getc (&file)) != EOF) \
+    ; \
+  printf ("closing '%s' after reading '%" PRIu64 "' bytes\n", \
+          PATH, file.bytes); \
+  kissat_close_file (&file); \
+  if (file.bytes != expected_bytes) \
+    FATAL ("read '%" PRIu64 "' bytes but expected '%zu'", \
+           file.bytes, expected_bytes); \
+} while (0)
+#ifdef BZIP2
+  READ_DECOMPRESSED ("../test/file/1.bz2");
+#endif
+#ifdef ZLIB
+  READ_DECOMPRESSED ("../test/file/2.gz");
+#endif
+#ifdef LZMA
+  READ_DECOMPRESSED ("../test/file/3.lzma");
+  READ_DECOMPRESSED ("../test/file/5.xz");
+#endif
+#ifdef ZSTD
+  READ_DECOMPRESSED ("../test/file/6.zst");
+#endif
+}
+
+#endif
+
 #ifdef _POSIX_C_SOURCE
 
 static void
@@ -226,6 +271,7 @@ do { \
 	      (++chars && kissat_getc (&file) != EOF)) \
 	    FATAL ("failed to read single '42' line from '%s' " \
 	           "(character %d wrong)", path, chars); \
+	  kissat_close_file (&file); \
 	} \
     } \
 } while (0)
@@ -247,6 +293,10 @@ tissat_schedule_file (void)
     SCHEDULE_FUNCTION (test_file_writable);
   if (tissat_found_test_directory)
     SCHEDULE_FUNCTION (test_file_read_uncompressed);
+#if defined(BZIP2) || defined(ZLIB) || defined(LZMA) || defined(ZSTD)
+  if (tissat_found_test_directory)
+    SCHEDULE_FUNCTION (test_file_read_decompressed);
+#endif
 #ifdef _POSIX_C_SOURCE
   SCHEDULE_FUNCTION (test_file_write_and_read_compressed);
   if (tissat_found_test_directory)
@@ -0,0 +1,256 @@
+#include "test.h"
+
+#include "../src/random.h"
+
+static kissat *
+new_incremental_solver (void)
+{
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+#ifndef NOPTIONS
+  kissat_set_option (solver, "incremental", 1);
+  kissat_set_option (solver, "eliminateinit", 0);
+  kissat_set_option (solver, "probeinit", 0);
+#endif
+  return solver;
+}
+
+static void
+test_incremental_assumptions (void)
+{
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  kissat_add (solver, 1);
+  kissat_add (solver, 2);
+  kissat_add (solver, 0);
+  kissat_add (solver, -1);
+  kissat_add (solver, 3);
+  kissat_add (solver, 0);
+  kissat_assume (solver, -2);
+  kissat_assume (solver, -3);
+  int res = kissat_solve (solver);
+  assert (res == 20);
+  assert (kissat_failed (solver, -2));
+  assert (kissat_failed (solver, -3));
+  kissat_assume (solver, -2);
+  kissat_assume (solver, 4);
+  res = kissat_solve (solver);
+  assert (res == 10);
+  assert (kissat_value (solver, 1) == 1);
+  assert (kissat_value (solver, 2) == -2);
+  assert (kissat_value (solver, 3) == 3);
+  assert (kissat_value (solver, 4) == 4);
+  kissat_assume (solver, 4);
+  kissat_assume (solver, -4);
+  res = kissat_solve (solver);
+  assert (res == 20);
+  assert (kissat_failed (solver, 4));
+  assert (kissat_failed (solver, -4));
+  kissat_add (solver, -2);
+  kissat_add (solver, 0);
+  kissat_assume (solver, -3);
+  kissat_assume (solver, 5);
+  res = kissat_solve (solver);
+  assert (res == 20);
+  assert (kissat_failed (solver, -3));
+  assert (!kissat_failed (solver, 5));
+  kissat_add (solver, -3);
+  kissat_add (solver, 0);
+  res = kissat_solve (solver);
+  assert (res == 20);
+  kissat_release (solver);
+}
+
+#ifndef NOPTIONS
+
+static void
+test_incremental_chain (void)
+{
+  const int n = tissat_big ? 200 : 50;
+  kissat *solver = new_incremental_solver ();
+  for (int i = 1; i < n; i++)
+    {
+      kissat_add (solver, -i);
+      kissat_add (solver, i + 1);
+      kissat_add (solver, 0);
+      kissat_assume (solver, 1);
+      kissat_assume (solver, -(i + 1));
+      int res = kissat_solve (solver);
+      assert (res == 20);
+      assert (kissat_failed (solver, 1));
+      assert (kissat_failed (solver, -(i + 1)));
+      kissat_assume (solver, 1);
+      res = kissat_solve (solver);
+      assert (res == 10);
+      for (int j = 1; j <= i + 1; j++)
+	assert (kissat_value (solver, j) == j);
+      res = kissat_solve (solver);
+      assert (res == 10);
+    }
+  printf ("solved chain of %d variables incrementally\n", n);
+  kissat_release (solver);
+}
+
+#endif
+
+static void
+check_failed_assumptions (ints * clauses, ints * assumptions,
+			  kissat * incremental)
+{
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  for (all_stack (int, lit, *clauses))
+    kissat_add (solver, lit);
+  for (all_stack (int, lit, *assumptions))
+    if (kissat_failed (incremental, lit))
+      {
+	kissat_add (solver, lit);
+	kissat_add (solver, 0);
+      }
+  const int res = kissat_solve (solver);
+  assert (res == 20);
+  kissat_release (solver);
+}
+
+static void
+check_model (ints * clauses, ints * assumptions, kissat * solver)
+{
+  bool satisfied = false;
+  for (all_stack (int, lit, *clauses))
+    if (!lit)
+      {
+	assert (satisfied);
+	satisfied = false;
+      }
+    else if (kissat_value (solver, lit) == lit)
+      satisfied = true;
+  for (all_stack (int, lit, *assumptions))
+    assert (kissat_value (solver, lit) == lit);
+}
+
+// Random clauses have three different variables.  Variables occurring in
+// tautological clauses only would remain unassigned in models.
+
+static void
+add_random_clauses (kissat * solver, generator * random, ints * clauses,
+		    unsigned vars, unsigned count)
+{
+  for (unsigned i = 0; i < count; i++)
+    {
+      int clause[3];
+      for (unsigned j = 0; j < 3; j++)
+	{
+	  int lit;
+	  bool duplicated;
+	  do
+	    {
+	      lit = kissat_pick_random (random, 1, vars + 1);
+	      duplicated = false;
+	      for (unsigned k = 0; k < j; k++)
+		if (ABS (clause[k]) == lit)
+		  duplicated = true;
+	    }
+	  while (duplicated);
+	  if (kissat_pick_bool (random))
+	    lit = -lit;
+	  clause[j] = lit;
+	  kissat_add (solver, lit);
+	  PUSH_STACK (*clauses, lit);
+	}
+      kissat_add (solver, 0);
+      PUSH_STACK (*clauses, 0);
+    }
+}
+
+#ifndef NOPTIONS
+
+static void
+test_incremental_random (void)
+{
+  const unsigned vars = 40, rounds = tissat_big ? 100 : 30;
+  generator random = 42;
+  kissat *solver = new_incremental_solver ();
+  ints clauses, assumptions;
+  INIT_STACK (clauses);
+  INIT_STACK (assumptions);
+  unsigned sat = 0, unsat = 0;
+  for (unsigned round = 0; round < rounds; round++)
+    {
+      add_random_clauses (solver, &random, &clauses, vars, 6);
+      CLEAR_STACK (assumptions);
+      const unsigned size = kissat_pick_random (&random, 0, 6);
+      for (unsigned i = 0; i < size; i++)
+	{
+	  int lit = kissat_pick_random (&random, 1, vars + 1);
+	  if (kissat_pick_bool (&random))
+	    lit = -lit;
+	  kissat_assume (solver, lit);
+	  PUSH_STACK (assumptions, lit);
+	}
+      const int res = kissat_solve (solver);
+      if (res == 10)
+	{
+	  check_model (&clauses, &assumptions, solver);
+	  sat++;
+	}
+      else
+	{
+	  assert (res == 20);
+	  check_failed_assumptions (&clauses, &assumptions, solver);
+	  unsat++;
+	}
+    }
+  printf ("%u satisfiable and %u unsatisfiable calls\n", sat, unsat);
+  RELEASE_STACK (clauses);
+  RELEASE_STACK (assumptions);
+  kissat_release (solver);
+}
+
+#endif
+
+// Reuses variables eliminated in earlier calls with default options.
+
+static void
+test_incremental_default (void)
+{
+  const unsigned vars = 150, rounds = tissat_big ? 40 : 10;
+  generator random = 13;
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  ints clauses, assumptions;
+  INIT_STACK (clauses);
+  INIT_STACK (assumptions);
+  unsigned sat = 0, unsat = 0;
+  add_random_clauses (solver, &random, &clauses, vars, 4 * vars);
+  for (unsigned round = 0; round < rounds; round++)
+    {
+      add_random_clauses (solver, &random, &clauses, vars, 5);
+      const int res = kissat_solve (solver);
+      if (res == 10)
+	{
+	  check_model (&clauses, &assumptions, solver);
+	  sat++;
+	}
+      else
+	{
+	  assert (res == 20);
+	  check_failed_assumptions (&clauses, &assumptions, solver);
+	  unsat++;
+	}
+    }
+  printf ("%u satisfiable and %u unsatisfiable calls\n", sat, unsat);
+  RELEASE_STACK (clauses);
+  RELEASE_STACK (assumptions);
+  kissat_release (solver);
+}
+
+void
+tissat_schedule_incremental (void)
+{
+  SCHEDULE_FUNCTION (test_incremental_assumptions);
+  SCHEDULE_FUNCTION (test_incremental_default);
+#ifndef NOPTIONS
+  SCHEDULE_FUNCTION (test_incremental_chain);
+  SCHEDULE_FUNCTION (test_incremental_random);
+#endif
+}
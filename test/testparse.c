@@ -4,6 +4,7 @@
 #include "../src/parse.h"
 
 #include <inttypes.h>
+#include <string.h>
 
 static bool
 test_parse (bool expect_parse_error, unsigned strict, const char *path)
@@ -156,6 +157,250 @@ do {  \
 #undef PARSE
 }
 
+static void
+test_parse_binary (void)
+{
+#define CONVERT(NAME,EXPECTED) \
+do { \
+  const char * dimacs_path = "../test/cnf/" #NAME ".cnf"; \
+  const char * binary_path = #NAME ".bcnf"; \
+  kissat * solver = kissat_init (); \
+  tissat_init_solver (solver); \
+  file dimacs, binary; \
+  if (!kissat_open_to_read_file (&dimacs, dimacs_path)) \
+    FATAL ("could not open '%s' for reading", dimacs_path); \
+  if (!kissat_open_to_write_file (&binary, binary_path)) \
+    FATAL ("could not open '%s' for writing", binary_path); \
+  uint64_t lineno; \
+  int dimacs_max_var; \
+  const char * error = \
+    kissat_convert_dimacs (solver, NORMAL_PARSING, &dimacs, &binary, \
+			   &lineno, &dimacs_max_var); \
+  if (error) \
+    FATAL ("converting failed unexpectedly: %s:%" PRIu64 ": %s", \
+	   dimacs_path, lineno, error); \
+  kissat_close_file (&binary); \
+  kissat_close_file (&dimacs); \
+  kissat_release (solver); \
+  tissat_verbose ("Converted '%s' to '%s'.", dimacs_path, binary_path); \
+  solver = kissat_init (); \
+  tissat_init_solver (solver); \
+  if (!kissat_open_to_read_file (&binary, binary_path)) \
+    FATAL ("could not open '%s' for reading", binary_path); \
+  if (!kissat_binary_cnf_file (&binary)) \
+    FATAL ("could not detect binary CNF format of '%s'", binary_path); \
+  uint64_t offset; \
+  int binary_max_var; \
+  error = kissat_parse_binary (solver, PEDANTIC_PARSING, &binary, \
+			       &offset, &binary_max_var); \
+  if (error) \
+    FATAL ("binary parsing failed unexpectedly: %s: byte %" PRIu64 \
+	   ": %s", binary_path, offset, error); \
+  kissat_close_file (&binary); \
+  if (binary_max_var != dimacs_max_var) \
+    FATAL ("maximum variable '%d' in '%s' but '%d' in '%s'", \
+	   binary_max_var, binary_path, dimacs_max_var, dimacs_path); \
+  int res = kissat_solve (solver); \
+  if (res != EXPECTED) \
+    FATAL ("solving '%s' returned '%d' and not '%d'", \
+	   binary_path, res, EXPECTED); \
+  kissat_release (solver); \
+  tissat_verbose ("Parsed and solved '%s'.", binary_path); \
+} while (0)
+  CONVERT (add8, 20);
+  CONVERT (ph4, 20);
+  CONVERT (prime121, 10);
+#undef CONVERT
+}
+
+static void
+test_parse_binary_errors (void)
+{
+#define PARSE(NAME,EXPECTED) \
+do { \
+  const char * path = "../test/parse/" #NAME; \
+  kissat * solver = kissat_init (); \
+  tissat_init_solver (solver); \
+  file file; \
+  if (!kissat_open_to_read_file (&file, path)) \
+    FATAL ("could not open '%s' for reading", path); \
+  if (!kissat_binary_cnf_file (&file)) \
+    FATAL ("could not detect binary CNF format of '%s'", path); \
+  uint64_t offset; \
+  int max_var; \
+  const char * error = \
+    kissat_parse_binary (solver, NORMAL_PARSING, &file, &offset, &max_var); \
+  kissat_close_file (&file); \
+  kissat_release (solver); \
+  const char * expected = EXPECTED; \
+  if (!expected && error) \
+    FATAL ("binary parsing failed unexpectedly: %s: byte %" PRIu64 \
+	   ": %s", path, offset, error); \
+  if (expected && !error) \
+    FATAL ("binary parsing '%s' succeeded unexpectedly", path); \
+  if (expected && strcmp (error, expected)) \
+    FATAL ("binary parsing '%s' failed with '%s' and not '%s'", \
+	   path, error, expected); \
+  tissat_verbose ("Parsing '%s' %s as expected.", path, \
+		  error ? "failed" : "succeeded"); \
+} while (0)
+  PARSE (binaryunit, 0);
+  PARSE (binarynegativezero, "invalid literal encoding");
+  PARSE (binaryvarinttoolong, "invalid literal encoding");
+#undef PARSE
+}
+
+#if defined(THREADS) && !defined(NOPTIONS)
+
+// Parallel parsing only kicks in for mapped files with at least two chunks
+// of one mega-byte each.  So we generate files large enough to need several
+// rounds and check that converting them with and without parser threads
+// gives the same error, line number, maximum variable and binary output.
+
+#define PARALLEL_VARIABLES 100000
+#define PARALLEL_CLAUSES 250000
+
+static void
+generate_parallel (const char *path, int injected)
+{
+  FILE *file = fopen (path, "w");
+  if (!file)
+    FATAL ("could not open '%s' for writing", path);
+  const unsigned target = PARALLEL_CLAUSES - PARALLEL_CLAUSES / 4;
+  unsigned clauses = PARALLEL_CLAUSES;
+  if (injected == 2)
+    clauses--;
+  fprintf (file, "c generated\np cnf %d %u\n", PARALLEL_VARIABLES, clauses);
+  uint64_t state = 42;
+  for (unsigned i = 0; i < PARALLEL_CLAUSES; i++)
+    {
+      if (!(i % 10000))
+	fputs ("c comment\n", file);
+      if (injected == 1 && i == target)
+	fputs ("1 x 0\n", file);
+      else if (injected == 3 && i == target)
+	fprintf (file, "1 %d 0\n", PARALLEL_VARIABLES + 1);
+      else
+	{
+	  for (unsigned j = 0; j < 3; j++)
+	    {
+	      state = 6364136223846793005ull * state + 1442695040888963407ull;
+	      int lit = 1 + (int) ((state >> 32) % PARALLEL_VARIABLES);
+	      if (state & (1u << 20))
+		lit = -lit;
+	      fprintf (file, "%d ", lit);
+	    }
+	  fputs ("0\n", file);
+	}
+    }
+  fclose (file);
+}
+
+static const char *
+convert_parallel (unsigned threads, const char *dimacs_path,
+		  const char *binary_path, uint64_t * lineno, int *max_var)
+{
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  solver->options.threads = threads;
+  file dimacs, binary;
+  if (!kissat_open_to_read_file (&dimacs, dimacs_path))
+    FATAL ("could not open '%s' for reading", dimacs_path);
+  if (!dimacs.mapped && threads > 1)
+    tissat_verbose ("Generated '%s' not mapped and parsed sequentially.",
+		    dimacs_path);
+  if (!kissat_open_to_write_file (&binary, binary_path))
+    FATAL ("could not open '%s' for writing", binary_path);
+  const char *error =
+    kissat_convert_dimacs (solver, NORMAL_PARSING, &dimacs, &binary,
+			   lineno, max_var);
+  kissat_close_file (&binary);
+  kissat_close_file (&dimacs);
+  kissat_release (solver);
+  return error;
+}
+
+static void
+compare_parallel (const char *path1, const char *path2)
+{
+  FILE *file1 = fopen (path1, "r");
+  if (!file1)
+    FATAL ("could not open '%s' for reading", path1);
+  FILE *file2 = fopen (path2, "r");
+  if (!file2)
+    FATAL ("could not open '%s' for reading", path2);
+  uint64_t bytes = 0;
+  int ch1, ch2;
+  do
+    {
+      ch1 = getc (file1);
+      ch2 = getc (file2);
+      if (ch1 != ch2)
+	FATAL ("'%s' and '%s' differ at byte %" PRIu64,
+	       path1, path2, bytes);
+      bytes++;
+    }
+  while (ch1 != EOF);
+  fclose (file2);
+  fclose (file1);
+}
+
+static void
+test_parse_parallel (void)
+{
+  const char *names[] = {
+    "valid", "invalid", "toomany", "exceeded"
+  };
+  const char *expected[] = {
+    0, "expected", "too many clauses", "maximum variable index"
+  };
+  for (int injected = 0; injected < 4; injected++)
+    {
+      char dimacs_path[64], sequential_path[64], parallel_path[64];
+      sprintf (dimacs_path, "parallel-%s.cnf", names[injected]);
+      sprintf (sequential_path, "parallel-%s-1.bcnf", names[injected]);
+      sprintf (parallel_path, "parallel-%s-2.bcnf", names[injected]);
+      generate_parallel (dimacs_path, injected);
+      uint64_t sequential_lineno = 0, parallel_lineno = 0;
+      int sequential_max_var = 0, parallel_max_var = 0;
+      const char *sequential_error =
+	convert_parallel (1, dimacs_path, sequential_path,
+			  &sequential_lineno, &sequential_max_var);
+      const char *parallel_error =
+	convert_parallel (2, dimacs_path, parallel_path,
+			  &parallel_lineno, &parallel_max_var);
+      if (!expected[injected] && sequential_error)
+	FATAL ("sequential parsing failed unexpectedly: %s:%" PRIu64
+	       ": %s", dimacs_path, sequential_lineno, sequential_error);
+      if (expected[injected] &&
+	  (!sequential_error ||
+	   strncmp (sequential_error, expected[injected],
+		    strlen (expected[injected]))))
+	FATAL ("sequential parsing of '%s' did not fail with '%s...'",
+	       dimacs_path, expected[injected]);
+      if (!sequential_error != !parallel_error ||
+	  (sequential_error && strcmp (sequential_error, parallel_error)))
+	FATAL ("sequential error '%s' but parallel error '%s' in '%s'",
+	       sequential_error ? sequential_error : "none",
+	       parallel_error ? parallel_error : "none", dimacs_path);
+      if (sequential_error && sequential_lineno != parallel_lineno)
+	FATAL ("sequential error at line %" PRIu64
+	       " but parallel error at line %" PRIu64 " in '%s'",
+	       sequential_lineno, parallel_lineno, dimacs_path);
+      if (sequential_max_var != parallel_max_var)
+	FATAL ("sequential maximum variable '%d' but parallel '%d' in '%s'",
+	       sequential_max_var, parallel_max_var, dimacs_path);
+      compare_parallel (sequential_path, parallel_path);
+      tissat_verbose ("Parsing '%s' in parallel matches sequential %s.",
+		      dimacs_path, sequential_error ? "error" : "result");
+      remove (parallel_path);
+      remove (sequential_path);
+      remove (dimacs_path);
+    }
+}
+
+#endif
+
 void
 tissat_schedule_parse (void)
 {
@@ -163,4 +408,11 @@ tissat_schedule_parse (void)
     SCHEDULE_FUNCTION (test_parse_errors);
   if (tissat_found_test_directory)
     SCHEDULE_FUNCTION (test_parse_coverage);
+  if (tissat_found_test_directory)
+    SCHEDULE_FUNCTION (test_parse_binary);
+  if (tissat_found_test_directory)
+    SCHEDULE_FUNCTION (test_parse_binary_errors);
+#if defined(THREADS) && !defined(NOPTIONS)
+  SCHEDULE_FUNCTION (test_parse_parallel);
+#endif
 }
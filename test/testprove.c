@@ -143,6 +143,34 @@ schedule_prove_job (int expected, const char *cnf, const char *name)
     }
 }
 
+#ifdef LRAT
+
+static void
+schedule_lrat_job (int expected, const char *cnf, const char *name)
+{
+  char cmd[256];
+  if (!kissat_file_readable (cnf))
+    {
+      tissat_warning ("Skipping unreadable '%s'", cnf);
+      return;
+    }
+  char proof[96];
+  sprintf (proof, "%s.lrat%u", name, scheduled);
+  const char *binary = (scheduled % 5) ? "--no-binary " : "";
+  sprintf (cmd, "--lrat %s%s %s", binary, cnf, proof);
+  tissat_job *job = tissat_schedule_application (expected, cmd);
+  scheduled++;
+
+  if (expected == 20 && tissat_found_lrat_check && *binary)
+    {
+      sprintf (cmd, "lrat-check %s %s", cnf, proof);
+      assert (strlen (cmd) < sizeof cmd);
+      tissat_schedule_command (0, cmd, job);
+    }
+}
+
+#endif
+
 void
 tissat_schedule_prove (void)
 {
@@ -156,6 +184,20 @@ tissat_schedule_prove (void)
 #undef CNF
 }
 
+#ifdef LRAT
+
+void
+tissat_schedule_lrat (void)
+{
+#define CNF(EXPECTED,NAME,BIG) \
+  if (!BIG || tissat_big) \
+    schedule_lrat_job (EXPECTED, "../test/cnf/" #NAME ".cnf", #NAME);
+  CNFS
+#undef CNF
+}
+
+#endif
+
 #else
 int tissat_prove_do_avoid_warning;
 #endif
@@ -2,12 +2,22 @@
 
 #include "../src/allocate.h"
 
+#ifdef HUGE
+#define MAX_WATCH_REF ((1u << 31) - 1)
+#define INVALID_WATCH_REF UINT_MAX
+#else
+#define MAX_WATCH_REF MAX_REF
+#define INVALID_WATCH_REF INVALID_REF
+#endif
+
 static void
 test_references (void)
 {
   {
-    printf ("MAX_REF                      %08x\n", MAX_REF);
-    printf ("INVALID_REF                  %08x\n", INVALID_REF);
+    printf ("MAX_REF                      %08" PRIx64 "\n",
+	    (uint64_t) MAX_REF);
+    printf ("INVALID_REF                  %08" PRIx64 "\n",
+	    (uint64_t) INVALID_REF);
     printf ("EXTERNAL_MAX_VAR             %08x\n", EXTERNAL_MAX_VAR);
     printf ("INTERNAL_MAX_VAR             %08x\n", INTERNAL_MAX_VAR);
     printf ("INTERNAL_MAX_LIT             %08x\n", INTERNAL_MAX_LIT);
@@ -49,7 +59,7 @@ test_references (void)
     assert (w.binary.lit == INTERNAL_MAX_LIT);
     assert (w.blocking.lit == INTERNAL_MAX_LIT);
 
-    assert (w.raw != INVALID_REF);
+    assert (w.raw != INVALID_WATCH_REF);
     assert (w.raw != INVALID_VECTOR_ELEMENT);
 
     printf ("(true,true,INTERNAL_MAX_LIT) %08x\n", w.raw);
@@ -60,22 +70,22 @@ test_references (void)
     assert (w.binary.lit == 42);
     assert (w.blocking.lit == 42);
 
-    w.large.ref = MAX_REF;
+    w.large.ref = MAX_WATCH_REF;
     assert (!w.type.binary);
-    assert (w.large.ref == MAX_REF);
-    assert (w.raw == MAX_REF);
+    assert (w.large.ref == MAX_WATCH_REF);
+    assert (w.raw == MAX_WATCH_REF);
 
-    assert (w.raw != INVALID_REF);
+    assert (w.raw != INVALID_WATCH_REF);
     assert (w.raw != INVALID_VECTOR_ELEMENT);
 
-    w.raw = MAX_REF;
+    w.raw = MAX_WATCH_REF;
     assert (!w.type.binary);
-    assert (w.large.ref == MAX_REF);
+    assert (w.large.ref == MAX_WATCH_REF);
 
-    assert (w.raw != INVALID_REF);
+    assert (w.raw != INVALID_WATCH_REF);
     assert (w.raw != INVALID_VECTOR_ELEMENT);
 
-    w.raw = INVALID_REF;
+    w.raw = INVALID_WATCH_REF;
     assert (w.type.binary);
     assert (w.binary.redundant);
     assert (w.binary.lit > INTERNAL_MAX_LIT);
@@ -83,6 +93,16 @@ test_references (void)
     printf ("w.large.ref (INVALID_REF)    %08x\n", w.large.ref);
     printf ("w.binary.lit (INVALID_REF)   %08x\n", w.binary.lit);
     printf ("w.blocking.lit (INVALID_REF) %08x\n", w.blocking.lit);
+
+#ifdef HUGE
+    const reference ref = MAX_REF - 42;
+    watch large[2] = { kissat_large_watch (ref),
+      kissat_large_watch_high (ref)
+    };
+    assert (!large[0].type.binary);
+    assert (!large[1].type.binary);
+    assert (kissat_large_watch_reference (large) == ref);
+#endif
   }
 
   {
@@ -216,9 +236,10 @@ do { \
 	else
 	  {
 	    large++;
-	    assert (watch.large.ref < 2);
-	    assert (!refs[watch.large.ref]);
-	    refs[watch.large.ref] = true;
+	    const reference ref = LARGE_WATCH_REF (watch);
+	    assert (ref < 2);
+	    assert (!refs[ref]);
+	    refs[ref] = true;
 	  }
       }
 
@@ -238,7 +259,7 @@ do { \
     assert (refs[1]);
 
     RELEASE_WATCHES (watches);
-    RELEASE_STACK (solver->vectors.stack);
+    kissat_release_vectors (solver, &solver->vectors);
 
 #ifndef NMETRICS
     assert (!solver->statistics.allocated_current);
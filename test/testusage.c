@@ -36,6 +36,11 @@ tissat_schedule_usage (void)
 
       if (kissat_file_readable ("../test/cnf/add32.cnf"))
 	APP (20, "../test/cnf/add32.cnf --no-compact");
+      if (kissat_file_readable ("../test/cnf/prime65537.cnf"))
+	APP (20, "../test/cnf/prime65537.cnf --renumber");
+      if (kissat_file_readable ("../test/cnf/prime961.cnf"))
+	APP (10, "../test/cnf/prime961.cnf --renumber --compactlim=0 "
+	     "--reduceinit=10 --reduceint=10");
 
       APP (20, "../test/cnf/add8.cnf --no-probe");
       APP (20, "../test/cnf/add8.cnf --no-substitute");
@@ -135,6 +140,9 @@ tissat_schedule_usage (void)
 
   APP (1, "three command-line arguments");
   APP (1, "/dev/null /dev/null /dev/null");
+#ifdef LRAT
+  APP (1, "--lrat --relaxed /dev/null /dev/null");
+#endif
 
 #undef APP
 }
@@ -20,11 +20,16 @@ test_vector_basics (void)
   unsigneds *stack = &vectors->stack;
   for (unsigned i = 0; i < 100; i++)
     {
-      if (!(i % (2 * N)))
+      if (!(i % (4 * N)))
 	{
 	  kissat_defrag_vectors (solver, vectors, N, vector);
 	  defrags++;
 	}
+      else if (!(i % (2 * N)))
+	{
+	  kissat_start_defrag_vectors (solver, vectors);
+	  defrags++;
+	}
       else
 	{
 	  unsigned j = rand () % N;
@@ -48,6 +53,7 @@ test_vector_basics (void)
 	      popped++;
 	    }
 	  assert (count[j] == vector[j].size);
+	  kissat_defrag_vectors_step (solver, vectors, N, vector, 1);
 	}
 
       if (pushed)
@@ -57,7 +63,7 @@ test_vector_basics (void)
       printf ("vectors[%zu]", SIZE_STACK (*stack));
       for (all_stack (unsigned, e, *stack))
 	{
-	  if (e == INVALID_REF)
+	  if (e == INVALID_VECTOR_ELEMENT)
 	    {
 	      printf (" -");
 	      free++;
@@ -94,7 +100,7 @@ test_vector_basics (void)
 #ifndef QUIET
   RELEASE_STACK (solver->profiles.stack);
 #endif
-  RELEASE_STACK (*stack);
+  kissat_release_vectors (solver, vectors);
 #ifndef NMETRICS
   assert (!solver->statistics.allocated_current);
 #endif